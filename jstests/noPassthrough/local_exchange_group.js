@@ -0,0 +1,76 @@
+/**
+ * Tests that a $group split across local exchange consumers returns the same results as one run on
+ * a single thread, and that explain, the profiler and the slow query log still describe the query
+ * which feeds the consumers.
+ * @tags: [requires_profiling]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryLocalExchangeConsumers: 4}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.local_exchange_group;
+
+const nDocs = 1000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, a: i % 10, b: i});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [
+    {$match: {b: {$gte: 100}}},
+    {$addFields: {c: {$multiply: ["$b", 2]}}},
+    {$group: {_id: "$a", total: {$sum: "$c"}, count: {$sum: 1}, max: {$max: "$b"}}},
+    {$sort: {_id: 1}}
+];
+
+function runOnOneThread() {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryLocalExchangeConsumers: 1}));
+    const results = coll.aggregate(pipeline).toArray();
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryLocalExchangeConsumers: 4}));
+    return results;
+}
+
+const expected = runOnOneThread();
+assert.eq(expected.length, 10);
+assert.eq(coll.aggregate(pipeline).toArray(), expected);
+
+// The consumers are limited to the number of cores, so the $group only runs in parallel where
+// there is more than one.
+if (db.hostInfo().system.numCores < 2) {
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+// The explain describes both the consumers and the $cursor stage feeding them.
+const explain = coll.explain("executionStats").aggregate(pipeline);
+const gather = explain.stages[0].$_internalExchangeGather;
+assert(gather, tojson(explain));
+assert.eq(gather.consumers, 4, tojson(explain));
+assert.eq(gather.input[0].$cursor.queryPlanner.winningPlan.stage, "COLLSCAN", tojson(explain));
+assert.eq(gather.input[0].$cursor.executionStats.totalDocsExamined, nDocs, tojson(explain));
+
+// The profiler and the slow query log report the documents examined by the $cursor stage.
+assert.commandWorked(db.setProfilingLevel(2, {slowms: -1}));
+const comment = "local_exchange_group";
+assert.eq(coll.aggregate(pipeline, {comment: comment}).toArray(), expected);
+assert.commandWorked(db.setProfilingLevel(0));
+
+const profileEntry = db.system.profile.findOne({"command.comment": comment});
+assert(profileEntry, tojson(db.system.profile.find().toArray()));
+assert.eq(profileEntry.planSummary, "COLLSCAN", tojson(profileEntry));
+assert.eq(profileEntry.docsExamined, nDocs, tojson(profileEntry));
+
+const slowQueryLogged = checkLog.checkContainsOnceJson(conn, 51803, {
+    command: (command) => command.comment === comment,
+    docsExamined: nDocs,
+    planSummary: "COLLSCAN"
+});
+assert(slowQueryLogged, "the slow query log does not report the documents examined");
+
+MongoRunner.stopMongod(conn);
+})();
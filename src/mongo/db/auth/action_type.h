@@ -54,6 +54,7 @@ namespace mongo {
 #define EXPAND_ACTION_TYPE(X)                                                         \
     X(addShard)                                                                       \
     X(advanceClusterTime)                                                             \
+    X(analyze)                                                                        \
     X(anyAction) /* Special ActionType that represents *all* actions */               \
     X(appendOplogNote)                                                                \
     X(applicationMessage)                                                             \
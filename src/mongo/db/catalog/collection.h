@@ -330,6 +330,24 @@ public:
                                 const bool noWarn = false,
                                 StoreDeletedDoc storeDeletedDoc = StoreDeletedDoc::Off) = 0;
 
+    /**
+     * Deletes the documents with the given RecordIds from the collection. Must be called inside a
+     * WriteUnitOfWork, which makes the whole batch atomic.
+     *
+     * The index and oplog entries are generated per document, as for deleteDocument(), but the
+     * records themselves are removed from the RecordStore with a single batched call.
+     *
+     * 'fromMigrate' indicates whether the deletes were induced by a chunk migration, and
+     * so should be ignored by the user as an internal maintenance operation and not a
+     * real delete.
+     * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
+     */
+    virtual void deleteDocuments(OperationContext* const opCtx,
+                                 StmtId stmtId,
+                                 const std::vector<RecordId>& locs,
+                                 OpDebug* const opDebug,
+                                 const bool fromMigrate = false) = 0;
+
     /*
      * Inserts all documents inside one WUOW.
      * Caller should ensure vector is appropriately sized for this.
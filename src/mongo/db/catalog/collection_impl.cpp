@@ -734,6 +734,43 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
     }
 }
 
+void CollectionImpl::deleteDocuments(OperationContext* opCtx,
+                                     StmtId stmtId,
+                                     const std::vector<RecordId>& locs,
+                                     OpDebug* opDebug,
+                                     bool fromMigrate) {
+    uassert(5100000, "cannot remove from a capped collection", !isCapped());
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+
+    auto opObserver = getGlobalServiceContext()->getOpObserver();
+
+    int64_t totalKeysDeleted = 0;
+    for (const auto& loc : locs) {
+        Snapshotted<BSONObj> doc = docFor(opCtx, loc);
+
+        // The OpObserver remembers the document key from aboutToDelete() until the matching call
+        // to onDelete(), so the two must be paired for each document.
+        opObserver->aboutToDelete(opCtx, ns(), doc.value());
+
+        boost::optional<BSONObj> deletedDoc;
+        if (getRecordPreImages()) {
+            deletedDoc.emplace(doc.value().getOwned());
+        }
+
+        int64_t keysDeleted;
+        _indexCatalog->unindexRecord(opCtx, doc.value(), loc, false /* noWarn */, &keysDeleted);
+        totalKeysDeleted += keysDeleted;
+
+        opObserver->onDelete(opCtx, ns(), uuid(), stmtId, fromMigrate, deletedDoc);
+    }
+
+    _recordStore->deleteRecords(opCtx, locs);
+
+    if (opDebug) {
+        opDebug->additiveMetrics.incrementKeysDeleted(totalKeysDeleted);
+    }
+}
+
 Counter64 moveCounter;
 ServerStatusMetricField<Counter64> moveCounterDisplay("record.moves", &moveCounter);
 
@@ -140,6 +140,21 @@ public:
         bool noWarn = false,
         Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off) final;
 
+    /**
+     * Deletes the documents with the given RecordIds from the collection inside the caller's
+     * WriteUnitOfWork, removing the records from the RecordStore in a single batch.
+     *
+     * 'stmtId' the statement id for these delete operations. Pass in kUninitializedStmtId if not
+     * applicable.
+     * 'fromMigrate' indicates whether the deletes were induced by a chunk migration.
+     * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
+     */
+    void deleteDocuments(OperationContext* opCtx,
+                         StmtId stmtId,
+                         const std::vector<RecordId>& locs,
+                         OpDebug* opDebug,
+                         bool fromMigrate = false) final;
+
     /*
      * Inserts all documents inside one WUOW.
      * Caller should ensure vector is appropriately sized for this.
@@ -116,6 +116,14 @@ public:
         std::abort();
     }
 
+    void deleteDocuments(OperationContext* opCtx,
+                         StmtId stmtId,
+                         const std::vector<RecordId>& locs,
+                         OpDebug* opDebug,
+                         bool fromMigrate) {
+        std::abort();
+    }
+
     Status insertDocuments(OperationContext* opCtx,
                            std::vector<InsertStatement>::const_iterator begin,
                            std::vector<InsertStatement>::const_iterator end,
@@ -0,0 +1,197 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
+#include "mongo/db/keypattern.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/index_statistics_store.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace {
+
+BSONObj toKeyFormat(const BSONObj& obj) {
+    BSONObjBuilder bob;
+    for (auto&& elem : obj) {
+        bob.appendAs(elem, "");
+    }
+    return bob.obj();
+}
+
+/**
+ * Scans all the keys of the index described by 'entry', in ascending order of the first field of
+ * its key pattern.
+ */
+IndexStatistics analyzeIndex(OperationContext* opCtx,
+                             Collection* collection,
+                             const IndexCatalogEntry* entry,
+                             size_t numBuckets) {
+    const auto* descriptor = entry->descriptor();
+    const bool describesCollection =
+        !descriptor->isSparse() && !descriptor->isPartial() && !entry->getCollator();
+    IndexStatisticsBuilder builder(descriptor->indexName(),
+                                   descriptor->keyPattern(),
+                                   describesCollection,
+                                   numBuckets,
+                                   collection->numRecords(opCtx));
+
+    KeyPattern keyPattern(descriptor->keyPattern());
+    const auto minKey = toKeyFormat(keyPattern.extendRangeBound({}, false));
+    const auto maxKey = toKeyFormat(keyPattern.extendRangeBound({}, true));
+    const bool ascending = descriptor->keyPattern().firstElement().number() >= 0;
+
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           collection,
+                                           descriptor,
+                                           ascending ? minKey : maxKey,
+                                           ascending ? maxKey : minKey,
+                                           BoundInclusion::kIncludeBothStartAndEndKeys,
+                                           PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                           ascending ? InternalPlanner::FORWARD
+                                                     : InternalPlanner::BACKWARD);
+
+    BSONObj key;
+    while (exec->getNext(&key, nullptr) == PlanExecutor::ADVANCED) {
+        builder.addKey(key);
+    }
+    return builder.done();
+}
+
+/**
+ * The 'analyze' command collects statistics about the keys of each index of a collection, which
+ * the query planner uses to estimate the cost of candidate plans when
+ * 'internalQueryEnableCostBasedPlanSelection' is set. The statistics are stored in the
+ * 'system.statistics' collection of the database, replacing any collected earlier.
+ *
+ *    {
+ *        analyze: <collection>
+ *    }
+ */
+class AnalyzeCommand final : public BasicCommand {
+public:
+    AnalyzeCommand() : BasicCommand("analyze") {}
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return true;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        AuthorizationSession* authzSession = AuthorizationSession::get(client);
+        ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+        if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::analyze)) {
+            return Status::OK();
+        }
+
+        return Status(ErrorCodes::Unauthorized, "unauthorized");
+    }
+
+    std::string help() const override {
+        return "Collects index statistics used to estimate the cost of query plans.";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+        uassert(ErrorCodes::InvalidNamespace,
+                str::stream() << "cannot analyze system collection " << nss,
+                !nss.isSystem());
+
+        std::unique_ptr<CollectionIndexStatistics> stats;
+        {
+            AutoGetCollectionForReadCommand ctx(opCtx, nss);
+            Collection* collection = ctx.getCollection();
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "collection " << nss << " does not exist",
+                    collection);
+
+            const auto numBuckets = internalQueryIndexStatisticsHistogramBuckets.load();
+            std::vector<IndexStatistics> indexes;
+            auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+            while (it->more()) {
+                const IndexCatalogEntry* entry = it->next();
+                if (entry->descriptor()->getAccessMethodName() == IndexNames::BTREE) {
+                    indexes.push_back(analyzeIndex(opCtx, collection, entry, numBuckets));
+                }
+            }
+
+            stats = std::make_unique<CollectionIndexStatistics>(collection->uuid(),
+                                                                collection->numRecords(opCtx),
+                                                                Date_t::now(),
+                                                                std::move(indexes));
+        }
+
+        index_statistics_store::save(opCtx, nss, *stats);
+
+        BSONArrayBuilder indexesBuilder(result.subarrayStart("indexes"));
+        for (auto&& index : stats->indexes()) {
+            BSONObjBuilder indexBuilder(indexesBuilder.subobjStart());
+            indexBuilder.append("name", index.indexName);
+            indexBuilder.append("numKeys", index.numKeys);
+            indexBuilder.append("numDistinctKeys", index.numDistinctKeys);
+            indexBuilder.append("numBuckets", static_cast<int>(index.histogram.buckets().size()));
+        }
+        indexesBuilder.done();
+
+        // Plans cached before the collection was analyzed were chosen without its statistics.
+        // The statistics themselves reach the planner through the OpObserver.
+        AutoGetCollectionForReadCommand ctx(opCtx, nss);
+        auto collection = ctx.getCollection();
+        if (collection && collection->uuid() == stats->uuid()) {
+            CollectionQueryInfo::get(collection).clearQueryCache(collection);
+        }
+
+        LOGV2_DEBUG(5100009, 1, "Analyzed collection", "namespace"_attr = nss);
+        return true;
+    }
+} analyzeCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -48,8 +48,13 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
@@ -61,6 +66,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
@@ -72,6 +78,7 @@
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/string_map.h"
 
@@ -446,6 +453,122 @@ std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> createExchangePipelinesI
     return pipelines;
 }
 
+/**
+ * Completes 'pipeline' with the $cursor stage described by 'attachExecutorCallback'. If local
+ * exchange parallelism is enabled and the rest of 'pipeline' begins with any number of stages which
+ * transform each document independently followed by a $group whose result does not depend on the
+ * order of its input, the $cursor instead feeds a round-robin Exchange, and the work up to and
+ * including the $group is distributed across its consumers. Each consumer computes a partial $group
+ * over its share of the input on its own thread, and the partial results are combined by the
+ * merging half of the $group.
+ */
+std::unique_ptr<Pipeline, PipelineDeleter> attachExecutorAndParallelizeGroupIfPossible(
+    OperationContext* opCtx,
+    const AggregationRequest& request,
+    Collection* collection,
+    std::pair<PipelineD::AttachExecutorCallback,
+              std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attachExecutorCallback,
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
+    auto attachToPipeline = [&] {
+        PipelineD::attachInnerQueryExecutorToPipeline(collection,
+                                                      attachExecutorCallback.first,
+                                                      std::move(attachExecutorCallback.second),
+                                                      pipeline.get());
+        return std::move(pipeline);
+    };
+
+    // Every consumer needs a core of its own to make progress, however many are asked for.
+    const int numConsumers = std::min(internalQueryLocalExchangeConsumers.load(),
+                                      static_cast<int>(ProcessInfo::getNumAvailableCores()));
+    auto expCtx = pipeline->getContext();
+    if (numConsumers <= 1 || !attachExecutorCallback.first || !attachExecutorCallback.second ||
+        request.getExchangeSpec() || expCtx->needsMerge || expCtx->inMongos ||
+        opCtx->inMultiDocumentTransaction() ||
+        repl::ReadConcernArgs::get(opCtx).getLevel() !=
+            repl::ReadConcernLevel::kLocalReadConcern) {
+        return attachToPipeline();
+    }
+
+    // Only stages which produce their output for each document independently of all others can be
+    // run by the consumers ahead of the $group.
+    const auto sources = pipeline->getSources();
+    auto groupIt = sources.begin();
+    while (groupIt != sources.end() &&
+           (dynamic_cast<DocumentSourceMatch*>(groupIt->get()) ||
+            dynamic_cast<DocumentSourceSingleDocumentTransformation*>(groupIt->get()) ||
+            dynamic_cast<DocumentSourceUnwind*>(groupIt->get()))) {
+        ++groupIt;
+    }
+    auto group =
+        groupIt == sources.end() ? nullptr : dynamic_cast<DocumentSourceGroup*>(groupIt->get());
+    if (!group) {
+        return attachToPipeline();
+    }
+
+    // The consumers see the input in an arbitrary order.
+    const auto& accumulatedFields = group->getAccumulatedFields();
+    if (!std::all_of(accumulatedFields.begin(), accumulatedFields.end(), [](auto&& field) {
+            return field.makeAccumulator()->isCommutative();
+        })) {
+        return attachToPipeline();
+    }
+
+    auto distributedPlanLogic = group->distributedPlanLogic();
+    if (!distributedPlanLogic || !distributedPlanLogic->mergingStage) {
+        return attachToPipeline();
+    }
+
+    std::vector<Value> serializedStages;
+    for (auto it = sources.begin(); it != std::next(groupIt); ++it) {
+        (*it)->serializeToArray(serializedStages);
+    }
+    std::vector<BSONObj> rawConsumerPipeline;
+    for (auto&& stage : serializedStages) {
+        rawConsumerPipeline.push_back(stage.getDocument().toBson());
+    }
+
+    // The stages after the $group move to the new pipeline. Remove them from 'pipeline' first, so
+    // that disposing of it leaves them untouched.
+    while (pipeline->popFront()) {
+    }
+
+    // The consumers attach the input of the Exchange to their own OperationContexts while they load
+    // it, so it needs an ExpressionContext which nothing running on this thread shares.
+    auto inputPipeline = Pipeline::create({}, expCtx->copyWith(expCtx->ns, expCtx->uuid));
+    PipelineD::attachInnerQueryExecutorToPipeline(collection,
+                                                  attachExecutorCallback.first,
+                                                  std::move(attachExecutorCallback.second),
+                                                  inputPipeline.get());
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+    spec.setConsumers(numConsumers);
+    boost::intrusive_ptr<Exchange> exchange =
+        new Exchange(std::move(spec), std::move(inputPipeline));
+
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> consumers;
+    for (int idx = 0; idx < numConsumers; ++idx) {
+        // Each consumer runs on its own thread, so needs its own ExpressionContext. Its $group
+        // produces partial results for the merging $group to combine.
+        auto consumerExpCtx = expCtx->copyWith(expCtx->ns, expCtx->uuid);
+        consumerExpCtx->needsMerge = true;
+
+        auto consumer = Pipeline::parse(rawConsumerPipeline, consumerExpCtx);
+        consumer->addInitialSource(new DocumentSourceExchange(
+            consumerExpCtx,
+            exchange,
+            idx,
+            idx == 0 ? consumerExpCtx->mongoProcessInterface->getResourceYielder() : nullptr));
+        consumers.push_back(std::move(consumer));
+    }
+
+    Pipeline::SourceContainer newSources{
+        DocumentSourceExchangeGather::create(expCtx, std::move(consumers)),
+        distributedPlanLogic->mergingStage};
+    newSources.insert(newSources.end(), std::next(groupIt), sources.end());
+    return Pipeline::create(std::move(newSources), expCtx);
+}
+
 /**
  * Create a PlanExecutor to execute the given 'pipeline'.
  */
@@ -664,10 +787,8 @@ Status runAggregate(OperationContext* opCtx,
             execs.emplace_back(std::move(attachExecutorCallback.second));
         } else {
             // Complete creation of the initial $cursor stage, if needed.
-            PipelineD::attachInnerQueryExecutorToPipeline(collection,
-                                                          attachExecutorCallback.first,
-                                                          std::move(attachExecutorCallback.second),
-                                                          pipeline.get());
+            pipeline = attachExecutorAndParallelizeGroupIfPossible(
+                opCtx, request, collection, std::move(attachExecutorCallback), std::move(pipeline));
 
             auto pipelines =
                 createExchangePipelinesIfNeeded(opCtx, expCtx, request, std::move(pipeline), uuid);
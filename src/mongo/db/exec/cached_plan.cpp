@@ -64,12 +64,14 @@ CachedPlanStage::CachedPlanStage(ExpressionContext* expCtx,
                                  CanonicalQuery* cq,
                                  const QueryPlannerParams& params,
                                  size_t decisionWorks,
-                                 std::unique_ptr<PlanStage> root)
+                                 std::unique_ptr<PlanStage> root,
+                                 const QuerySolution* cachedSolution)
     : RequiresAllIndicesStage(kStageType, expCtx, collection),
       _ws(ws),
       _canonicalQuery(cq),
       _plannerParams(params),
-      _decisionWorks(decisionWorks) {
+      _decisionWorks(decisionWorks),
+      _cachedSolution(cachedSolution) {
     _children.emplace_back(std::move(root));
 }
 
@@ -197,12 +199,20 @@ Status CachedPlanStage::tryYield(PlanYieldPolicy* yieldPolicy) {
 }
 
 Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache, std::string reason) {
+    // If the cached plan was merely slower than expected, it may well be chosen again. Hold on to
+    // it along with the results it produced, so that its trial period work is not thrown away.
+    std::unique_ptr<PlanStage> cachedRoot;
+    std::queue<WorkingSetID> cachedResults;
+    if (shouldCache && _cachedSolution && internalQueryReplanReusesCachedPlanWork.load()) {
+        cachedRoot = std::move(_children.front());
+        cachedResults.swap(_results);
+    }
+
     // We're going to start over with a new plan. Clear out info from our old plan.
     {
         std::queue<WorkingSetID> emptyQueue;
         _results.swap(emptyQueue);
     }
-    _ws->clear();
     _children.clear();
 
     _specificStats.replanReason = std::move(reason);
@@ -222,11 +232,34 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache, s
     }
     auto solutions = std::move(statusWithSolutions.getValue());
 
+    // Look for the cached plan among the new candidates. If it is not there, its state in the
+    // working set is of no further use.
+    boost::optional<size_t> cachedPlanIdx;
+    if (cachedRoot) {
+        const auto cachedPlan = _cachedSolution->root->toString();
+        for (size_t ix = 0; ix < solutions.size(); ++ix) {
+            if (solutions[ix]->root->toString() == cachedPlan) {
+                cachedPlanIdx = ix;
+                break;
+            }
+        }
+    }
+    if (!cachedPlanIdx) {
+        cachedRoot.reset();
+        cachedResults = {};
+        _ws->clear();
+    }
+
     if (1 == solutions.size()) {
-        // Only one possible plan. Build the stages from the solution.
-        auto&& newRoot = stage_builder::buildClassicExecutableTree(
-            expCtx()->opCtx, collection(), *_canonicalQuery, *solutions[0], _ws);
-        _children.emplace_back(std::move(newRoot));
+        // Only one possible plan. Build the stages from the solution, unless it is the cached
+        // plan, which can simply carry on.
+        if (cachedPlanIdx) {
+            _children.emplace_back(std::move(cachedRoot));
+            _results.swap(cachedResults);
+        } else {
+            _children.emplace_back(stage_builder::buildClassicExecutableTree(
+                expCtx()->opCtx, collection(), *_canonicalQuery, *solutions[0], _ws));
+        }
         _replannedQs = std::move(solutions.back());
         solutions.pop_back();
 
@@ -254,6 +287,14 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache, s
             solutions[ix]->cacheData->indexFilterApplied = _plannerParams.indexFiltersApplied;
         }
 
+        if (cachedPlanIdx && *cachedPlanIdx == ix) {
+            multiPlanStage->addPlan(std::move(solutions[ix]),
+                                    std::move(cachedRoot),
+                                    _ws,
+                                    std::move(cachedResults));
+            continue;
+        }
+
         auto&& nextPlanRoot = stage_builder::buildClassicExecutableTree(
             expCtx()->opCtx, collection(), *_canonicalQuery, *solutions[ix], _ws);
 
@@ -62,7 +62,8 @@ public:
                     CanonicalQuery* cq,
                     const QueryPlannerParams& params,
                     size_t decisionWorks,
-                    std::unique_ptr<PlanStage> root);
+                    std::unique_ptr<PlanStage> root,
+                    const QuerySolution* cachedSolution = nullptr);
 
     bool isEOF() final;
 
@@ -121,6 +122,10 @@ private:
     // cached.
     size_t _decisionWorks;
 
+    // The solution which 'root' was built from, if known. Used when replanning to recognize the
+    // cached plan among the new candidates. Not owned, and must outlive pickBestPlan().
+    const QuerySolution* _cachedSolution;
+
     // If we fall back to re-planning the query, and there is just one resulting query solution,
     // that solution is owned here.
     std::unique_ptr<QuerySolution> _replannedQs;
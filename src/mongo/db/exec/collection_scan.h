@@ -32,6 +32,7 @@
 #include <memory>
 
 #include "mongo/db/exec/collection_scan_common.h"
+#include "mongo/db/exec/compiled_filter.h"
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
@@ -106,6 +107,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // '_filter' lowered to SBE bytecode, if enabled and supported.
+    std::unique_ptr<CompiledFilter> _compiledFilter;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
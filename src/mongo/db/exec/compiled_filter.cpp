@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/compiled_filter.h"
+
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/exec/sbe/values/id_generators.h"
+#include "mongo/db/query/sbe_stage_builder_filter.h"
+
+namespace mongo {
+
+std::unique_ptr<CompiledFilter> CompiledFilter::compile(const MatchExpression* filter) {
+    if (!filter) {
+        return nullptr;
+    }
+
+    sbe::value::SlotIdGenerator slotIdGenerator;
+    sbe::value::FrameIdGenerator frameIdGenerator;
+    const auto inputSlot = slotIdGenerator.generate();
+
+    auto expr = stage_builder::generateFilterExpression(filter, inputSlot, &frameIdGenerator);
+    if (!expr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CompiledFilter> compiled{new CompiledFilter()};
+    sbe::CompileCtx ctx;
+    ctx.root = &compiled->_slotResolver;
+    ctx.pushCorrelated(inputSlot, &compiled->_inputAccessor);
+    compiled->_code = expr->compile(ctx);
+    compiled->_expr = std::move(expr);
+    return compiled;
+}
+
+bool Filter::passes(WorkingSetMember* wsm,
+                    const MatchExpression* filter,
+                    CompiledFilter* compiledFilter) {
+    if (compiledFilter && wsm->hasObj()) {
+        if (auto result = compiledFilter->matches(wsm->doc.value().toBson())) {
+            return *result;
+        }
+    }
+    return passes(wsm, filter);
+}
+
+boost::optional<bool> CompiledFilter::matches(const BSONObj& doc) {
+    _inputAccessor.reset(sbe::value::TypeTags::bsonObject, sbe::value::bitcastFrom(doc.objdata()));
+    auto [owned, tag, val] = _bytecode.run(_code.get());
+    _inputAccessor.reset();
+
+    boost::optional<bool> result;
+    if (tag == sbe::value::TypeTags::Boolean) {
+        result = val != 0;
+    }
+    if (owned) {
+        sbe::value::releaseValue(tag, val);
+    }
+    return result;
+}
+
+}  // namespace mongo
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * A MatchExpression filter lowered to SBE bytecode, which classic execution stages can evaluate
+ * against a BSON document without walking the MatchExpression tree.
+ *
+ * The compiled form only decides the documents for which it is known to agree with the
+ * MatchExpression; see stage_builder::generateFilterExpression(). Callers must fall back to the
+ * MatchExpression for all other documents.
+ *
+ * Not thread safe: each stage owns its own instance.
+ */
+class CompiledFilter {
+public:
+    CompiledFilter(const CompiledFilter&) = delete;
+    CompiledFilter& operator=(const CompiledFilter&) = delete;
+
+    /**
+     * Returns nullptr if 'filter' is outside the subset of match expressions which can be
+     * compiled.
+     */
+    static std::unique_ptr<CompiledFilter> compile(const MatchExpression* filter);
+
+    /**
+     * Returns whether 'doc' matches the filter, or boost::none if the compiled form cannot decide
+     * and the caller has to consult the MatchExpression.
+     */
+    boost::optional<bool> matches(const BSONObj& doc);
+
+private:
+    CompiledFilter() = default;
+
+    // Binds the document being matched to '_inputSlot'.
+    sbe::value::ViewOfValueAccessor _inputAccessor;
+
+    // Resolves '_inputSlot' to '_inputAccessor' while compiling; never opened.
+    sbe::CoScanStage _slotResolver;
+
+    // The bytecode may refer to constants owned by the expression, so both are kept.
+    std::unique_ptr<sbe::EExpression> _expr;
+    std::unique_ptr<sbe::vm::CodeFragment> _code;
+    sbe::vm::ByteCode _bytecode;
+};
+
+}  // namespace mongo
@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/compiled_filter.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class CompiledFilterTest : public unittest::Test {
+protected:
+    std::unique_ptr<MatchExpression> parse(const BSONObj& filter) {
+        return unittest::assertGet(MatchExpressionParser::parse(filter, _expCtx));
+    }
+
+    void setCollator(std::unique_ptr<CollatorInterface> collator) {
+        _expCtx->setCollator(std::move(collator));
+    }
+
+    /**
+     * Asserts that 'filter' compiles and that, for every document in 'docs', the compiled filter
+     * either defers or agrees with the MatchExpression. Returns how many documents it decided.
+     */
+    size_t assertAgreesWithMatcher(const char* filter, const std::vector<BSONObj>& docs) {
+        auto expr = parse(fromjson(filter));
+        auto compiled = CompiledFilter::compile(expr.get());
+        ASSERT(compiled) << filter;
+
+        size_t numDecided = 0;
+        for (auto&& doc : docs) {
+            if (auto result = compiled->matches(doc)) {
+                ASSERT_EQ(*result, expr->matchesBSON(doc)) << filter << " on " << doc;
+                ++numDecided;
+            }
+        }
+        return numDecided;
+    }
+
+private:
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx =
+        make_intrusive<ExpressionContextForTest>();
+};
+
+const std::vector<BSONObj> kDocs = {
+    fromjson("{a: 1}"),
+    fromjson("{a: 2}"),
+    fromjson("{a: NumberLong(2)}"),
+    fromjson("{a: NumberDecimal('2')}"),
+    fromjson("{a: 2.5}"),
+    fromjson("{a: -1}"),
+    fromjson("{a: NaN}"),
+    fromjson("{a: NumberDecimal('NaN')}"),
+    fromjson("{a: Infinity}"),
+    fromjson("{a: NumberLong('9007199254740993')}"),
+    fromjson("{a: 'foo'}"),
+    fromjson("{a: 'fooo'}"),
+    fromjson("{a: ''}"),
+    fromjson("{a: null}"),
+    fromjson("{a: true}"),
+    fromjson("{a: {b: 2}}"),
+    fromjson("{a: {b: 'foo'}}"),
+    fromjson("{a: {b: [1, 2]}}"),
+    fromjson("{a: [1, 2]}"),
+    fromjson("{a: [[2]]}"),
+    fromjson("{a: [{b: 2}]}"),
+    fromjson("{a: []}"),
+    fromjson("{a: {$minKey: 1}}"),
+    fromjson("{a: {$maxKey: 1}}"),
+    fromjson("{a: {$date: 0}}"),
+    fromjson("{a: {$symbol: 'foo'}}"),
+    fromjson("{a: 5, a: 2}"),
+    fromjson("{c: 3}"),
+    fromjson("{}"),
+};
+
+TEST_F(CompiledFilterTest, ComparisonsAgreeWithMatcher) {
+    for (auto filter : {"{a: 2}",
+                        "{a: {$lt: 2}}",
+                        "{a: {$lte: 2}}",
+                        "{a: {$gt: 2}}",
+                        "{a: {$gte: 2}}",
+                        "{a: {$gt: NumberLong(-3)}}",
+                        "{a: {$lt: 9007199254740992}}",
+                        "{a: {$eq: 'foo'}}",
+                        "{a: {$gt: 'foo'}}",
+                        "{a: {$lte: ''}}",
+                        "{'a.b': 2}",
+                        "{'a.b': {$gte: 'foo'}}",
+                        "{'a.0': 1}"}) {
+        ASSERT_GT(assertAgreesWithMatcher(filter, kDocs), 0U) << filter;
+    }
+}
+
+TEST_F(CompiledFilterTest, LogicalOperatorsAgreeWithMatcher) {
+    for (auto filter : {"{a: {$gt: 0, $lt: 3}}",
+                        "{a: {$gte: 2}, c: 3}",
+                        "{$or: [{a: 1}, {a: 'foo'}]}",
+                        "{$or: [{a: {$lt: 0}}, {c: {$gt: 2}}]}",
+                        "{$and: [{$or: [{a: 1}, {a: 2}]}, {a: {$lt: 2}}]}",
+                        "{$or: [{$and: [{a: {$gt: 0}}, {a: {$lt: 2}}]}, {'a.b': 2}]}"}) {
+        ASSERT_GT(assertAgreesWithMatcher(filter, kDocs), 0U) << filter;
+    }
+}
+
+TEST_F(CompiledFilterTest, DefersDocumentsWhoseSemanticsMayDiffer) {
+    auto expr = parse(fromjson("{a: {$lt: 5}}"));
+    auto compiled = CompiledFilter::compile(expr.get());
+    ASSERT(compiled);
+
+    // Scalars of the same or another canonical type are decided.
+    auto result = compiled->matches(fromjson("{a: 1}"));
+    ASSERT(result && *result);
+    result = compiled->matches(fromjson("{a: 10}"));
+    ASSERT(result && !*result);
+    result = compiled->matches(fromjson("{a: 'foo'}"));
+    ASSERT(result && !*result);
+
+    // Arrays need implicit traversal, NaN orders differently, and a missing value may be a type
+    // the VM cannot represent.
+    ASSERT_FALSE(compiled->matches(fromjson("{a: [1]}")));
+    ASSERT_FALSE(compiled->matches(fromjson("{a: NaN}")));
+    ASSERT_FALSE(compiled->matches(fromjson("{b: 1}")));
+}
+
+TEST_F(CompiledFilterTest, UnsupportedFiltersDoNotCompile) {
+    for (auto filter : {"{a: {$in: [1, 2]}}",
+                        "{a: /foo/}",
+                        "{a: {$exists: true}}",
+                        "{a: {$ne: 1}}",
+                        "{$nor: [{a: 1}]}",
+                        "{a: null}",
+                        "{a: true}",
+                        "{a: {b: 1}}",
+                        "{a: [1, 2]}",
+                        "{a: 2.5}",
+                        "{a: NaN}",
+                        "{a: NumberDecimal('2')}",
+                        "{a: NumberLong('9007199254740993')}",
+                        "{a: 1e300}",
+                        "{$or: [{a: 1}, {a: /foo/}]}"}) {
+        auto expr = parse(fromjson(filter));
+        ASSERT_FALSE(CompiledFilter::compile(expr.get())) << filter;
+    }
+}
+
+TEST_F(CompiledFilterTest, StringComparisonsWithCollatorDoNotCompile) {
+    setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+
+    auto stringExpr = parse(fromjson("{a: 'foo'}"));
+    ASSERT_FALSE(CompiledFilter::compile(stringExpr.get()));
+
+    // Numbers are unaffected by the collation.
+    auto numberExpr = parse(fromjson("{a: {$gt: 1}}"));
+    ASSERT(CompiledFilter::compile(numberExpr.get()));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/columnar_document_batch.h"
+
+namespace mongo {
+
+ColumnarDocumentBatch::ColumnarDocumentBatch(std::vector<std::string> fieldNames)
+    : _fieldNames(std::move(fieldNames)), _columns(_fieldNames.size()) {}
+
+void ColumnarDocumentBatch::appendRow(const Document& doc) {
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        Value val = doc.getField(_fieldNames[i]);
+        _memUsageBytes += val.getApproximateSize();
+        _columns[i].push_back(std::move(val));
+    }
+    ++_numRows;
+}
+
+void ColumnarDocumentBatch::appendRow(const BSONObj& obj) {
+    for (auto&& column : _columns) {
+        column.emplace_back();
+    }
+
+    size_t numFound = 0;
+    for (auto&& elem : obj) {
+        const auto fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < _fieldNames.size(); ++i) {
+            auto& val = _columns[i].back();
+            if (val.missing() && fieldName == _fieldNames[i]) {
+                val = Value(elem);
+                ++numFound;
+                break;
+            }
+        }
+        if (numFound == _fieldNames.size()) {
+            break;
+        }
+    }
+
+    for (auto&& column : _columns) {
+        _memUsageBytes += column.back().getApproximateSize();
+    }
+    ++_numRows;
+}
+
+void ColumnarDocumentBatch::clear() {
+    for (auto&& column : _columns) {
+        column.clear();
+    }
+    _numRows = 0;
+    _memUsageBytes = 0;
+}
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * A batch of documents stored column-wise. The batch holds one column of Values per top-level
+ * field name it was constructed with; any other fields of the documents appended to it are
+ * dropped. A field which is absent from a document is stored as a missing Value.
+ *
+ * This is intended for use between stages when dependency analysis has proven that the consumer
+ * reads only a fixed set of top-level fields, so that the consumer can operate on the columns
+ * directly without looking up each field in a Document.
+ */
+class ColumnarDocumentBatch {
+public:
+    explicit ColumnarDocumentBatch(std::vector<std::string> fieldNames);
+
+    /**
+     * Appends a row holding the values of this batch's fields in 'doc'.
+     */
+    void appendRow(const Document& doc);
+
+    /**
+     * Appends a row holding the values of this batch's fields in 'obj', reading them straight from
+     * its BSON elements. Only the first occurrence of a repeated field name is kept.
+     */
+    void appendRow(const BSONObj& obj);
+
+    /**
+     * Removes all rows from the batch, keeping the set of fields.
+     */
+    void clear();
+
+    size_t size() const {
+        return _numRows;
+    }
+
+    bool empty() const {
+        return _numRows == 0;
+    }
+
+    const std::vector<std::string>& fieldNames() const {
+        return _fieldNames;
+    }
+
+    /**
+     * Returns the column holding the values of the 'i'th field name.
+     */
+    const std::vector<Value>& column(size_t i) const {
+        dassert(i < _columns.size());
+        return _columns[i];
+    }
+
+    /**
+     * Returns the approximate memory footprint of the values held in this batch, in bytes.
+     */
+    size_t memUsageBytes() const {
+        return _memUsageBytes;
+    }
+
+private:
+    std::vector<std::string> _fieldNames;
+    std::vector<std::vector<Value>> _columns;
+    size_t _numRows = 0;
+    size_t _memUsageBytes = 0;
+};
+
+}  // namespace mongo
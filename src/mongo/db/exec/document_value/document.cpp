@@ -171,6 +171,13 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
 }
 
 Position DocumentStorage::constructInCache(const BSONElement& elem) {
+    // Fields of a storage object on the heap are read into the heap as well, so that a document
+    // copied out of an arena is not drawn back into one when it is read later.
+    boost::optional<DocumentArena::HeapScope> heapScope;
+    if (!DocumentArena::isArenaAllocation(this)) {
+        heapScope.emplace();
+    }
+
     auto savedModified = _modified;
     auto pos = getNextPosition();
     const auto fieldName = elem.fieldNameStringData();
@@ -253,8 +260,8 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    std::unique_ptr<char, DocumentArena::Deleter> oldBuf(_cache);
+    _cache = static_cast<char*>(DocumentArena::allocate(capacity));
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
@@ -286,7 +293,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = static_cast<char*>(DocumentArena::allocate(newSize + hashTabBytes()));
     _cacheEnd = _cache + newSize;
 }
 
@@ -297,7 +304,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = static_cast<char*>(DocumentArena::allocate(bufferBytes));
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -329,7 +336,7 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
+    std::unique_ptr<char, DocumentArena::Deleter> deleteBufferAtScopeEnd(_cache);
 
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
@@ -360,6 +367,12 @@ void DocumentStorage::loadLazyMetadata() const {
         return;
     }
 
+    // As in constructInCache(), the metadata of a storage object on the heap stays on the heap.
+    boost::optional<DocumentArena::HeapScope> heapScope;
+    if (!DocumentArena::isArenaAllocation(this)) {
+        heapScope.emplace();
+    }
+
     BSONObjIterator it(_bson);
     while (it.more()) {
         BSONElement elem(it.next());
@@ -661,6 +674,54 @@ size_t Document::getApproximateSize() const {
     return size;
 }
 
+bool Document::isInArena() const {
+    if (!_storage || !DocumentArena::hasLiveChunks()) {
+        return false;
+    }
+    if (_storage->isInArena()) {
+        return true;
+    }
+
+    // Fields which have not been read from the BSON yet are not in the cache, and will be read
+    // into the heap since the storage object is on the heap.
+    for (auto it = storage().iteratorCacheOnly(); !it.atEnd(); it.advance()) {
+        if (it->val.isInArena()) {
+            return true;
+        }
+    }
+
+    const auto& meta = metadata();
+    return (meta.hasSortKey() && meta.getSortKey().isInArena()) ||
+        (meta.hasGeoNearPoint() && meta.getGeoNearPoint().isInArena()) ||
+        (meta.hasSearchHighlights() && meta.getSearchHighlights().isInArena());
+}
+
+Document Document::copyOutOfArena() const {
+    if (!isInArena()) {
+        return *this;
+    }
+
+    DocumentArena::HeapScope heapScope;
+    MutableDocument out;
+    for (auto it = fieldIterator(); it.more();) {
+        auto field = it.next();
+        out.addField(field.first, field.second.copyOutOfArena());
+    }
+
+    out.copyMetaDataFrom(*this);
+    auto& meta = out.metadata();
+    if (meta.hasSortKey()) {
+        meta.setSortKey(meta.getSortKey().copyOutOfArena(), meta.isSingleElementKey());
+    }
+    if (meta.hasGeoNearPoint()) {
+        meta.setGeoNearPoint(meta.getGeoNearPoint().copyOutOfArena());
+    }
+    if (meta.hasSearchHighlights()) {
+        meta.setSearchHighlights(meta.getSearchHighlights().copyOutOfArena());
+    }
+    return out.freeze();
+}
+
 void Document::hash_combine(size_t& seed,
                             const StringData::ComparatorInterface* stringComparator) const {
     for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
@@ -318,6 +318,20 @@ public:
         return _storage ? _storage->isOwned() : true;
     }
 
+    /**
+     * Returns true if any part of the document, including nested documents, arrays and metadata,
+     * was allocated in a DocumentArena.
+     */
+    bool isInArena() const;
+
+    /**
+     * Returns a document equal to this one, with its metadata, which was allocated entirely on the
+     * heap. Returns this document itself if it is not in an arena. Stages which keep a document
+     * beyond the call that produced it should keep such a copy, so that it does not pin the
+     * arena's chunks.
+     */
+    Document copyOutOfArena() const;
+
     /**
      * Returns true if the document has been modified (i.e. it differs from the underlying BSONObj).
      */
@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+
+#include "mongo/base/static_assert.h"
+#include "mongo/util/allocator.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+// The arena which allocations on this thread are routed to, if any.
+thread_local DocumentArena* currentArena = nullptr;
+
+// Arena allocations are placed in slots aligned to this, after a pointer to their chunk, so that
+// their own addresses are never aligned to it.
+constexpr size_t kSlotAlignment = 16;
+
+MONGO_STATIC_ASSERT(alignof(std::max_align_t) >= kSlotAlignment);
+MONGO_STATIC_ASSERT(DocumentArena::kArenaAlignment == kSlotAlignment / 2);
+
+size_t alignUp(size_t bytes) {
+    return (bytes + kSlotAlignment - 1) & ~(kSlotAlignment - 1);
+}
+}  // namespace
+
+AtomicWord<long long> DocumentArena::_numLiveChunks{0};
+
+struct alignas(16) DocumentArena::Chunk {
+    // The number of live allocations in the chunk, plus one while it is the arena's current chunk.
+    std::atomic<uint32_t> liveCount{1};  // NOLINT
+
+    // Offset from the start of the chunk at which the next slot will be placed. Only accessed by
+    // the thread which has the owning arena active.
+    size_t used = sizeof(Chunk);
+};
+
+DocumentArena::Scope::Scope(DocumentArena* arena) {
+    bool inactive = false;
+    if (!arena || currentArena == arena || !arena->_active.compareAndSwap(&inactive, true)) {
+        return;
+    }
+    _arena = arena;
+    _previous = currentArena;
+    currentArena = arena;
+}
+
+DocumentArena::Scope::~Scope() {
+    if (_arena) {
+        currentArena = _previous;
+        _arena->_active.store(false);
+    }
+}
+
+DocumentArena::HeapScope::HeapScope() : _previous(currentArena) {
+    currentArena = nullptr;
+}
+
+DocumentArena::HeapScope::~HeapScope() {
+    currentArena = _previous;
+}
+
+DocumentArena::~DocumentArena() {
+    invariant(!_active.load());
+    if (_current) {
+        releaseChunk(_current);
+    }
+}
+
+void* DocumentArena::allocate(size_t bytes) {
+    if (currentArena && bytes <= kMaxArenaAllocationBytes) {
+        return currentArena->allocateFromChunk(bytes);
+    }
+
+    // Asking for at least 16 bytes guarantees the address is 16-byte aligned, so that it cannot be
+    // mistaken for an arena allocation.
+    void* ptr = mongoMalloc(std::max(bytes, kSlotAlignment));
+    dassert(!isArenaAllocation(ptr));
+    return ptr;
+}
+
+void DocumentArena::deallocate(void* ptr) noexcept {
+    if (isArenaAllocation(ptr)) {
+        releaseChunk(*(static_cast<Chunk**>(ptr) - 1));
+    } else {
+        free(ptr);
+    }
+}
+
+void* DocumentArena::allocateFromChunk(size_t bytes) {
+    const size_t slotBytes = alignUp(sizeof(Chunk*) + bytes);
+    if (!_current || _current->used + slotBytes > kChunkBytes) {
+        if (_current && _current->liveCount.load(std::memory_order_acquire) == 1) {
+            // Everything allocated in the current chunk has already been released, so rewind it
+            // rather than taking a new chunk from the heap. Other threads can only ever decrement
+            // the count, so it cannot change under us once it has reached one.
+            _current->used = sizeof(Chunk);
+        } else {
+            if (_current) {
+                releaseChunk(_current);
+            }
+            _current = new (mongoMalloc(kChunkBytes)) Chunk();
+            _numLiveChunks.fetchAndAddRelaxed(1);
+            ++_numChunksAllocated;
+        }
+    }
+
+    auto slot = reinterpret_cast<Chunk**>(reinterpret_cast<char*>(_current) + _current->used);
+    _current->used += slotBytes;
+    _current->liveCount.fetch_add(1, std::memory_order_relaxed);
+    *slot = _current;
+    return slot + 1;
+}
+
+void DocumentArena::releaseChunk(Chunk* chunk) noexcept {
+    if (chunk->liveCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        chunk->~Chunk();
+        free(chunk);
+        _numLiveChunks.fetchAndSubtract(1);
+    }
+}
+
+}  // namespace mongo
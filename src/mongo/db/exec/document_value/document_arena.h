@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+/**
+ * A bump-pointer arena for the storage of Documents and arrays which are created while executing
+ * a pipeline. Allocations are carved out of fixed-size chunks; each chunk counts the allocations
+ * still alive in it and is freed once all of them have been released, or rewound and reused if it
+ * is the arena's current chunk. Allocations therefore never outlive their chunk, so Documents and
+ * Values allocated in an arena may safely escape the pipeline and be released on any thread.
+ *
+ * A single surviving allocation keeps its whole chunk alive, which no memory accounting sees.
+ * Stages which keep Documents or Values after the call that produced them returns, such as $group
+ * and $sort, therefore store copies made with Value::copyOutOfArena() or
+ * Document::copyOutOfArena().
+ *
+ * Allocations are routed to an arena only by the thread which has activated it with a Scope, and
+ * only one thread at a time may activate a given arena. Allocations made without an active arena,
+ * or which are too large to share a chunk, fall back to the heap and carry no header. An arena
+ * allocation is instead recognized by its address, which is aligned to 8 bytes but never to 16,
+ * whereas the heap aligns every allocation of 16 bytes or more to 16 bytes.
+ */
+class DocumentArena {
+    DocumentArena(const DocumentArena&) = delete;
+    DocumentArena& operator=(const DocumentArena&) = delete;
+
+public:
+    // The size of each chunk, and the largest allocation which is placed in a chunk.
+    static constexpr size_t kChunkBytes = 64 * 1024;
+    static constexpr size_t kMaxArenaAllocationBytes = kChunkBytes / 8;
+
+    // The alignment of allocations made in an arena. Types allocated through allocate() must not
+    // require more.
+    static constexpr size_t kArenaAlignment = 8;
+
+    /**
+     * Routes allocations made through DocumentArena::allocate() on this thread to 'arena' for the
+     * lifetime of the Scope. Does nothing if 'arena' is null or is already active on another
+     * thread.
+     */
+    class Scope {
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    public:
+        explicit Scope(DocumentArena* arena);
+        ~Scope();
+
+    private:
+        DocumentArena* _arena = nullptr;
+        DocumentArena* _previous = nullptr;
+    };
+
+    /**
+     * Routes allocations made through DocumentArena::allocate() on this thread to the heap for the
+     * lifetime of the HeapScope, even if an arena is active.
+     */
+    class HeapScope {
+        HeapScope(const HeapScope&) = delete;
+        HeapScope& operator=(const HeapScope&) = delete;
+
+    public:
+        HeapScope();
+        ~HeapScope();
+
+    private:
+        DocumentArena* _previous;
+    };
+
+    DocumentArena() = default;
+    ~DocumentArena();
+
+    /**
+     * Allocates 'bytes' bytes, aligned to 'kArenaAlignment' bytes, from the arena active on this
+     * thread or from the heap. The result must be released with deallocate().
+     */
+    static void* allocate(size_t bytes);
+
+    /**
+     * Releases memory returned by allocate(). May be called on any thread. Does nothing if 'ptr' is
+     * null.
+     */
+    static void deallocate(void* ptr) noexcept;
+
+    /**
+     * Deleter for use with std::unique_ptr.
+     */
+    struct Deleter {
+        void operator()(void* ptr) const noexcept {
+            deallocate(ptr);
+        }
+    };
+
+    /**
+     * Returns true if 'ptr' was returned by allocate() from an arena rather than from the heap.
+     */
+    static bool isArenaAllocation(const void* ptr) {
+        return reinterpret_cast<uintptr_t>(ptr) & kArenaAlignment;
+    }
+
+    /**
+     * Returns true if any chunk of any arena is still allocated. While this is false, nothing can
+     * be stored in an arena.
+     */
+    static bool hasLiveChunks() {
+        return _numLiveChunks.loadRelaxed() > 0;
+    }
+
+    /**
+     * Returns the number of chunks this arena has taken from the heap.
+     */
+    size_t numChunksAllocated() const {
+        return _numChunksAllocated;
+    }
+
+private:
+    struct Chunk;
+
+    void* allocateFromChunk(size_t bytes);
+
+    static void releaseChunk(Chunk* chunk) noexcept;
+
+    // The number of chunks allocated across all arenas and not yet freed.
+    static AtomicWord<long long> _numLiveChunks;
+
+    // The chunk allocations are currently carved from. The arena holds one count on it.
+    Chunk* _current = nullptr;
+    size_t _numChunksAllocated = 0;
+
+    // Set while a Scope has this arena active on some thread.
+    AtomicWord<bool> _active{false};
+};
+
+}  // namespace mongo
@@ -35,6 +35,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include "mongo/base/static_assert.h"
+#include "mongo/db/exec/document_value/document_arena.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/stdx/variant.h"
@@ -297,6 +298,15 @@ public:
 
     ~DocumentStorage();
 
+    // Storage objects, like their field buffers, are placed in the DocumentArena active on the
+    // allocating thread, if any.
+    static void* operator new(size_t size) {
+        return DocumentArena::allocate(size);
+    }
+    static void operator delete(void* ptr) {
+        DocumentArena::deallocate(ptr);
+    }
+
     void reset(const BSONObj& bson, bool stripMetadata);
 
     static const DocumentStorage& emptyDoc() {
@@ -398,6 +408,13 @@ public:
         return !_cache ? 0 : (_cacheEnd - _cache + hashTabBytes());
     }
 
+    /**
+     * Returns true if this object or its field buffer was allocated in a DocumentArena.
+     */
+    bool isInArena() const {
+        return DocumentArena::isArenaAllocation(this) || DocumentArena::isArenaAllocation(_cache);
+    }
+
     auto bsonObjSize() const {
         return _bson.objsize();
     }
@@ -586,4 +603,5 @@ private:
 
     friend class DocumentStorageIterator;
 };
+MONGO_STATIC_ASSERT(alignof(DocumentStorage) <= DocumentArena::kArenaAlignment);
 }  // namespace mongo
@@ -36,6 +36,7 @@
 
 #include "mongo/bson/bson_depth.h"
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_arena.h"
 #include "mongo/db/exec/document_value/document_comparator.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
@@ -45,6 +46,7 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 
 namespace DocumentTests {
 
@@ -137,6 +139,76 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentArena, DocumentsBuiltInAnArenaOutliveTheArena) {
+    boost::optional<mongo::Document> doc;
+    {
+        DocumentArena arena;
+        DocumentArena::Scope scope(&arena);
+        doc = mongo::Document(BSON("a" << 1 << "b" << BSON_ARRAY(1 << 2) << "c"
+                                       << "a string long enough not to be stored inline"));
+        ASSERT_VALUE_EQ(doc->getField("a"), Value(1));
+        ASSERT_EQ(arena.numChunksAllocated(), 1U);
+    }
+    ASSERT_VALUE_EQ(doc->getField("b"), Value(BSON_ARRAY(1 << 2)));
+    ASSERT_BSONOBJ_EQ(doc->toBson(),
+                      BSON("a" << 1 << "b" << BSON_ARRAY(1 << 2) << "c"
+                               << "a string long enough not to be stored inline"));
+}
+
+TEST(DocumentArena, ChunksAreReusedOnceTheirDocumentsAreReleased) {
+    DocumentArena arena;
+    DocumentArena::Scope scope(&arena);
+    for (int i = 0; i < 100000; ++i) {
+        MutableDocument md;
+        md.addField("a", Value(i));
+        md.addField("b", Value(std::vector<Value>{Value(i), Value(i + 1)}));
+        ASSERT_VALUE_EQ(md.freeze().getField("a"), Value(i));
+    }
+    ASSERT_EQ(arena.numChunksAllocated(), 1U);
+}
+
+TEST(DocumentArena, ScopeIsIgnoredWhileTheArenaIsActiveElsewhere) {
+    DocumentArena arena;
+    DocumentArena::Scope scope(&arena);
+    stdx::thread([&] {
+        DocumentArena::Scope otherScope(&arena);
+        mongo::Document doc{{"a", 1}};
+        ASSERT_VALUE_EQ(doc.getField("a"), Value(1));
+    }).join();
+    ASSERT_EQ(arena.numChunksAllocated(), 0U);
+}
+
+TEST(DocumentArena, DocumentsCopiedOutOfAnArenaDoNotKeepItsChunksAlive) {
+    boost::optional<mongo::Document> copy;
+    {
+        DocumentArena arena;
+        DocumentArena::Scope scope(&arena);
+        MutableDocument md;
+        md.addField("a", Value(1));
+        md.addField("b", Value(std::vector<Value>{Value(mongo::Document{{"c", 2}})}));
+        md.metadata().setSortKey(Value(std::vector<Value>{Value(3), Value(4)}), false);
+        auto doc = md.freeze();
+        ASSERT_TRUE(doc.isInArena());
+        ASSERT_TRUE(doc.getField("b").isInArena());
+
+        copy = doc.copyOutOfArena();
+        ASSERT_FALSE(copy->isInArena());
+        ASSERT_DOCUMENT_EQ(*copy, doc);
+        ASSERT_VALUE_EQ(copy->metadata().getSortKey(), doc.metadata().getSortKey());
+    }
+    ASSERT_FALSE(DocumentArena::hasLiveChunks());
+    ASSERT_VALUE_EQ(copy->getField("b")[0]["c"], Value(2));
+}
+
+TEST(DocumentArena, HeapAllocationsAreNotMistakenForArenaAllocations) {
+    for (size_t bytes : {1, 8, 16, 24, 100, 4096}) {
+        void* ptr = DocumentArena::allocate(bytes);
+        ASSERT_FALSE(DocumentArena::isArenaAllocation(ptr));
+        DocumentArena::deallocate(ptr);
+    }
+    ASSERT_FALSE((mongo::Document{{"a", 1}}.isInArena()));
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
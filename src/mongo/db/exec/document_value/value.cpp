@@ -1133,6 +1133,47 @@ size_t Value::getApproximateSize() const {
     verify(false);
 }
 
+bool Value::isInArena() const {
+    // Nothing can be in an arena while no arena holds a chunk, which is always the case when
+    // arenas are disabled.
+    if (!DocumentArena::hasLiveChunks()) {
+        return false;
+    }
+
+    switch (getType()) {
+        case Object:
+            return getDocument().isInArena();
+        case Array:
+            if (DocumentArena::isArenaAllocation(_storage.genericRCPtr)) {
+                return true;
+            }
+            return std::any_of(getArray().begin(), getArray().end(), [](const Value& elem) {
+                return elem.isInArena();
+            });
+        default:
+            // Only documents and arrays are ever allocated in an arena.
+            return false;
+    }
+}
+
+Value Value::copyOutOfArena() const {
+    if (!isInArena()) {
+        return *this;
+    }
+
+    DocumentArena::HeapScope heapScope;
+    if (getType() == Object) {
+        return Value(getDocument().copyOutOfArena());
+    }
+
+    std::vector<Value> copy;
+    copy.reserve(getArray().size());
+    for (auto&& elem : getArray()) {
+        copy.push_back(elem.copyOutOfArena());
+    }
+    return Value(std::move(copy));
+}
+
 string Value::toString() const {
     // TODO use StringBuilder when operator << is ready
     stringstream out;
@@ -357,6 +357,17 @@ public:
         return *this;
     }
 
+    /**
+     * Returns true if this value is, or contains, a document or array allocated in a DocumentArena.
+     */
+    bool isInArena() const;
+
+    /**
+     * Returns a value equal to this one which was allocated entirely on the heap. See
+     * Document::copyOutOfArena().
+     */
+    Value copyOutOfArena() const;
+
     /// Members to support parsing/deserialization from IDL generated code.
     void serializeForIDL(StringData fieldName, BSONObjBuilder* builder) const;
     void serializeForIDL(BSONArrayBuilder* builder) const;
@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * An unordered set of Values with the same semantics as a ValueUnorderedSet made by the same
+ * ValueComparator, stored in a single open-addressing table with linear probing. Each element lives
+ * directly in the table rather than in a separately allocated node, so the overhead per element is
+ * a fraction of a Value instead of a heap allocation, a node link and a bucket pointer.
+ *
+ * A missing Value marks an empty slot, so missing Values cannot be inserted.
+ */
+class ValueFlatUnorderedSet {
+public:
+    explicit ValueFlatUnorderedSet(const ValueComparator& comparator) : _comparator(&comparator) {}
+
+    /**
+     * Inserts 'value' unless an equal value is already present. Returns true if it was inserted.
+     */
+    bool insert(const Value& value) {
+        invariant(!value.missing());
+        if ((_size + 1) * kMaxLoadDenominator > _slots.size() * kMaxLoadNumerator) {
+            grow();
+        }
+
+        auto& slot = findSlot(value);
+        if (!slot.missing()) {
+            return false;
+        }
+        slot = value;
+        ++_size;
+        return true;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the number of bytes allocated for the table, not including memory owned by the
+     * elements themselves.
+     */
+    size_t allocatedBytes() const {
+        return _slots.capacity() * sizeof(Value);
+    }
+
+    /**
+     * Calls 'callback' with each element, in no particular order.
+     */
+    template <typename Callback>
+    void forEach(Callback&& callback) const {
+        for (auto&& slot : _slots) {
+            if (!slot.missing()) {
+                callback(slot);
+            }
+        }
+    }
+
+    std::vector<Value> toVector() const {
+        std::vector<Value> values;
+        values.reserve(_size);
+        forEach([&](const Value& value) { values.push_back(value); });
+        return values;
+    }
+
+    /**
+     * Removes every element and releases the table.
+     */
+    void clear() {
+        std::vector<Value>().swap(_slots);
+        _size = 0;
+        _shift = 64;
+    }
+
+private:
+    static constexpr size_t kMinCapacity = 8;
+    static constexpr size_t kMaxLoadNumerator = 3;
+    static constexpr size_t kMaxLoadDenominator = 4;
+
+    /**
+     * Returns the slot holding a value equal to 'value', or the empty slot where it belongs.
+     */
+    Value& findSlot(const Value& value) {
+        // Fibonacci hashing spreads the entropy of the whole hash into the index, since
+        // Value::hash_combine() can leave the low bits poorly distributed.
+        const size_t mask = _slots.size() - 1;
+        size_t index =
+            (static_cast<uint64_t>(_comparator->hash(value)) * 0x9E3779B97F4A7C15ULL) >> _shift;
+        for (;; index = (index + 1) & mask) {
+            auto& slot = _slots[index];
+            if (slot.missing() || _comparator->evaluate(slot == value)) {
+                return slot;
+            }
+        }
+    }
+
+    void grow() {
+        std::vector<Value> oldSlots(_slots.empty() ? kMinCapacity : _slots.size() * 2);
+        oldSlots.swap(_slots);
+        _shift = 64;
+        for (size_t capacity = _slots.size(); capacity > 1; capacity >>= 1) {
+            --_shift;
+        }
+
+        for (auto&& value : oldSlots) {
+            if (!value.missing()) {
+                findSlot(value) = std::move(value);
+            }
+        }
+    }
+
+    const ValueComparator* _comparator;
+    std::vector<Value> _slots;
+    size_t _size = 0;
+
+    // Right shift which maps a 64-bit hash onto the table, which always has a power of two size.
+    unsigned _shift = 64;
+};
+
+}  // namespace mongo
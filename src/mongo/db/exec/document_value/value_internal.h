@@ -38,6 +38,7 @@
 #include "mongo/bson/bsontypes.h"
 #include "mongo/bson/oid.h"
 #include "mongo/bson/timestamp.h"
+#include "mongo/db/exec/document_value/document_arena.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -53,8 +54,17 @@ class RCVector : public RefCountable {
 public:
     RCVector() {}
     RCVector(std::vector<Value> v) : vec(std::move(v)) {}
+
+    static void* operator new(size_t size) {
+        return DocumentArena::allocate(size);
+    }
+    static void operator delete(void* ptr) {
+        DocumentArena::deallocate(ptr);
+    }
+
     std::vector<Value> vec;
 };
+MONGO_STATIC_ASSERT(alignof(RCVector) <= DocumentArena::kArenaAlignment);
 
 class RCCodeWScope : public RefCountable {
 public:
@@ -31,6 +31,7 @@
 
 #include <memory>
 
+#include "mongo/db/exec/compiled_filter.h"
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
@@ -95,6 +96,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // '_filter' lowered to SBE bytecode, if enabled and supported.
+    std::unique_ptr<CompiledFilter> _compiledFilter;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
@@ -35,6 +35,8 @@
 
 namespace mongo {
 
+class CompiledFilter;
+
 /**
  * The MatchExpression uses the MatchableDocument interface to see if a document satisfies the
  * expression.  This wraps a WorkingSetMember in the MatchableDocument interface so that any of
@@ -159,6 +161,14 @@ public:
         return filter->matches(&doc, nullptr);
     }
 
+    /**
+     * Same as above, but first evaluates 'compiledFilter', the compiled form of 'filter', if it is
+     * non-null and 'wsm' holds a full document. Defined in compiled_filter.cpp.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       CompiledFilter* compiledFilter);
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
@@ -0,0 +1,225 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/group_count_scan.h"
+
+#include <limits>
+#include <memory>
+
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method.h"
+
+namespace mongo {
+
+namespace {
+/**
+ * Returns 'key' with the field names of 'keyPattern'.
+ */
+BSONObj replaceBSONFieldNames(const BSONObj& key, const BSONObj& keyPattern) {
+    invariant(key.nFields() == keyPattern.nFields());
+
+    BSONObjBuilder bob;
+    BSONObjIterator patternIt(keyPattern);
+    for (auto&& elt : key) {
+        bob.appendAs(elt, patternIt.next().fieldNameStringData());
+    }
+    return bob.obj();
+}
+}  // namespace
+
+// static
+const char* GroupCountScan::kStageType = "GROUP_COUNT_SCAN";
+
+GroupCountScan::GroupCountScan(ExpressionContext* expCtx,
+                               const Collection* collection,
+                               GroupCountScanParams params,
+                               WorkingSet* workingSet)
+    : RequiresIndexStage(kStageType, expCtx, collection, params.indexDescriptor, workingSet),
+      _workingSet(workingSet),
+      _keyPattern(std::move(params.keyPattern)),
+      _countFieldName(std::move(params.countFieldName)),
+      _startKey(std::move(params.startKey)),
+      _startKeyInclusive(params.startKeyInclusive),
+      _endKey(std::move(params.endKey)),
+      _endKeyInclusive(params.endKeyInclusive) {
+    _specificStats.indexName = params.name;
+    _specificStats.keyPattern = _keyPattern;
+
+    // endKey must be after startKey in index order since we only do forward scans.
+    dassert(_startKey.woCompare(_endKey,
+                                Ordering::make(_keyPattern),
+                                /*compareFieldNames*/ false) <= 0);
+}
+
+PlanStage::StageState GroupCountScan::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF)
+        return PlanStage::IS_EOF;
+
+    boost::optional<KeyStringEntry> entry;
+    const bool needInit = !_cursor;
+    try {
+        if (needInit) {
+            // First call to work().  Perform cursor init.
+            _cursor = indexAccessMethod()->newCursor(opCtx());
+            _cursor->setEndPosition(_endKey, _endKeyInclusive);
+
+            auto keyStringForSeek = IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+                _startKey,
+                indexAccessMethod()->getSortedDataInterface()->getKeyStringVersion(),
+                indexAccessMethod()->getSortedDataInterface()->getOrdering(),
+                true, /* forward */
+                _startKeyInclusive);
+            entry = _cursor->seekForKeyString(keyStringForSeek);
+        } else {
+            entry = _cursor->nextKeyString();
+        }
+    } catch (const WriteConflictException&) {
+        if (needInit) {
+            // Release our cursor and try again next time.
+            _cursor.reset();
+        }
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    if (!entry) {
+        _commonStats.isEOF = true;
+        _cursor.reset();
+        if (_groupCount == 0) {
+            return PlanStage::IS_EOF;
+        }
+        *out = returnGroup();
+        return PlanStage::ADVANCED;
+    }
+
+    ++_specificStats.keysExamined;
+
+    const auto& keyString = entry->keyString;
+    if (_groupCount > 0 &&
+        KeyString::compare(keyString.getBuffer(),
+                           _groupEnd.getBuffer(),
+                           KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(),
+                                                               keyString.getSize()),
+                           _groupEnd.getSize()) < 0) {
+        ++_groupCount;
+        return PlanStage::NEED_TIME;
+    }
+
+    if (_groupCount == 0) {
+        startGroup(keyString);
+        return PlanStage::NEED_TIME;
+    }
+
+    *out = returnGroup();
+    startGroup(keyString);
+    return PlanStage::ADVANCED;
+}
+
+void GroupCountScan::startGroup(const KeyString::Value& keyString) {
+    const auto* sdi = indexAccessMethod()->getSortedDataInterface();
+    const BSONObj key = KeyString::toBson(keyString, sdi->getOrdering());
+
+    BSONObjBuilder bob;
+    bob.append(key.firstElement());
+    _groupValue = bob.obj();
+
+    KeyString::Builder groupEnd(sdi->getKeyStringVersion(),
+                                _groupValue,
+                                sdi->getOrdering(),
+                                KeyString::Discriminator::kExclusiveAfter);
+    _groupEnd = groupEnd.getValueCopy();
+    _groupCount = 1;
+}
+
+WorkingSetID GroupCountScan::returnGroup() {
+    // Like $sum, report the count as an int unless it does not fit.
+    BSONObjBuilder bob;
+    bob.appendAs(_groupValue.firstElement(), "_id");
+    if (_groupCount <= std::numeric_limits<int>::max()) {
+        bob.append(_countFieldName, static_cast<int>(_groupCount));
+    } else {
+        bob.append(_countFieldName, _groupCount);
+    }
+    _groupCount = 0;
+    ++_specificStats.groupsReturned;
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->doc = {{}, Document(bob.obj())};
+    member->transitionToOwnedObj();
+    return id;
+}
+
+bool GroupCountScan::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void GroupCountScan::doSaveStateRequiresIndex() {
+    if (_cursor)
+        _cursor->save();
+}
+
+void GroupCountScan::doRestoreStateRequiresIndex() {
+    if (_cursor)
+        _cursor->restore();
+}
+
+void GroupCountScan::doDetachFromOperationContext() {
+    if (_cursor)
+        _cursor->detachFromOperationContext();
+}
+
+void GroupCountScan::doReattachToOperationContext() {
+    if (_cursor)
+        _cursor->reattachToOperationContext(opCtx());
+}
+
+std::unique_ptr<PlanStageStats> GroupCountScan::getStats() {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_GROUP_COUNT_SCAN);
+
+    auto groupCountStats = std::make_unique<GroupCountScanStats>(_specificStats);
+    groupCountStats->keyPattern = _specificStats.keyPattern.getOwned();
+    groupCountStats->startKey = replaceBSONFieldNames(_startKey, groupCountStats->keyPattern);
+    groupCountStats->startKeyInclusive = _startKeyInclusive;
+    groupCountStats->endKey = replaceBSONFieldNames(_endKey, groupCountStats->keyPattern);
+    groupCountStats->endKeyInclusive = _endKeyInclusive;
+
+    ret->specific = std::move(groupCountStats);
+    return ret;
+}
+
+const SpecificStats* GroupCountScan::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
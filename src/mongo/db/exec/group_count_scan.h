@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+struct GroupCountScanParams {
+    GroupCountScanParams(const IndexDescriptor* descriptor,
+                         std::string indexName,
+                         BSONObj keyPattern,
+                         std::string countFieldName)
+        : indexDescriptor(descriptor),
+          name(std::move(indexName)),
+          keyPattern(std::move(keyPattern)),
+          countFieldName(std::move(countFieldName)) {
+        invariant(descriptor);
+    }
+
+    const IndexDescriptor* indexDescriptor;
+    std::string name;
+
+    BSONObj keyPattern;
+
+    // The name of the field holding the number of keys in each group.
+    std::string countFieldName;
+
+    BSONObj startKey;
+    bool startKeyInclusive{true};
+
+    BSONObj endKey;
+    bool endKeyInclusive{true};
+};
+
+/**
+ * Scans a non-multikey index from a start key to an end key and returns one document per distinct
+ * value of the first field of the key pattern, of the form {_id: <value>, <countFieldName>: <n>},
+ * where n is the number of keys with that value. This answers a $group which counts the documents
+ * of each value of a field, such as {$group: {_id: "$a", n: {$sum: 1}}}, without fetching any
+ * documents.
+ *
+ * The keys are read as KeyStrings and compared against the KeyString which sorts after every key of
+ * the current group, so only the first key of each group is decoded to BSON.
+ */
+class GroupCountScan final : public RequiresIndexStage {
+public:
+    GroupCountScan(ExpressionContext* expCtx,
+                   const Collection* collection,
+                   GroupCountScanParams params,
+                   WorkingSet* workingSet);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_GROUP_COUNT_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    /**
+     * Starts a new group with the key 'keyString'.
+     */
+    void startGroup(const KeyString::Value& keyString);
+
+    /**
+     * Returns a working set member holding the document for the current group.
+     */
+    WorkingSetID returnGroup();
+
+    // The WorkingSet we annotate with results.  Not owned by us.
+    WorkingSet* _workingSet;
+
+    const BSONObj _keyPattern;
+    const std::string _countFieldName;
+
+    const BSONObj _startKey;
+    const bool _startKeyInclusive = true;
+
+    const BSONObj _endKey;
+    const bool _endKeyInclusive = true;
+
+    std::unique_ptr<SortedDataInterface::Cursor> _cursor;
+
+    // The value of the first field of the key pattern for the current group, as a single-field
+    // object with an empty field name.
+    BSONObj _groupValue;
+
+    // Sorts after every key whose first field is equal to '_groupValue'.
+    KeyString::Value _groupEnd;
+
+    long long _groupCount = 0;
+
+    GroupCountScanStats _specificStats;
+};
+
+}  // namespace mongo
@@ -83,9 +83,11 @@ MultiPlanStage::MultiPlanStage(ExpressionContext* expCtx,
 
 void MultiPlanStage::addPlan(std::unique_ptr<QuerySolution> solution,
                              std::unique_ptr<PlanStage> root,
-                             WorkingSet* ws) {
+                             WorkingSet* ws,
+                             std::queue<WorkingSetID> alreadyProduced) {
     _children.emplace_back(std::move(root));
     _candidates.push_back({std::move(solution), _children.back().get(), ws});
+    _candidates.back().results = std::move(alreadyProduced);
 
     // Tell the new candidate plan that it must collect timing info. This timing info will
     // later be stored in the plan cache, and may be used for explain output.
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <queue>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_cache_util.h"
@@ -79,10 +80,15 @@ public:
 
     /**
      * Adsd a new candidate plan to be considered for selection by the MultiPlanStage trial period.
+     *
+     * A plan which has already been worked, such as a cached plan which is being replanned, may be
+     * added along with the results it has produced so far in 'alreadyProduced'. Its trial then
+     * continues from where it left off.
      */
     void addPlan(std::unique_ptr<QuerySolution> solution,
                  std::unique_ptr<PlanStage> root,
-                 WorkingSet* sharedWs);
+                 WorkingSet* sharedWs,
+                 std::queue<WorkingSetID> alreadyProduced = {});
 
     /**
      * Runs all plans added by addPlan, ranks them, and picks a best.
@@ -32,7 +32,9 @@
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_plan_ranker.h"
+#include "mongo/db/query/shared_plan_cache.h"
 
 namespace mongo {
 /**
@@ -155,6 +157,15 @@ void updatePlanCache(
         }
 
         if (validSolutions) {
+            if (internalQueryEnableSharedPlanCache.load()) {
+                shared_plan_cache::updateFromCollection(
+                    opCtx,
+                    collection,
+                    query,
+                    solutions,
+                    std::unique_ptr<plan_ranker::PlanRankingDecision>(ranking->clone()));
+            }
+
             uassertStatusOK(CollectionQueryInfo::get(collection)
                                 .getPlanCache()
                                 ->set(query,
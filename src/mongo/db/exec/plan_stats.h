@@ -430,6 +430,37 @@ struct FetchStats : public SpecificStats {
     size_t docsExamined = 0u;
 };
 
+struct GroupCountScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        GroupCountScanStats* specific = new GroupCountScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        specific->startKey = startKey.getOwned();
+        specific->endKey = endKey.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return keyPattern.objsize() + startKey.objsize() + endKey.objsize() +
+            indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // The starting/ending key(s) of the index scan, with the fields of keyPattern.
+    BSONObj startKey;
+    BSONObj endKey;
+    bool startKeyInclusive = true;
+    bool endKeyInclusive = true;
+
+    size_t keysExamined = 0;
+
+    // The number of distinct values of the first field of the key pattern, one per group returned.
+    size_t groupsReturned = 0;
+};
+
 struct IDHackStats : public SpecificStats {
     IDHackStats() : keysExamined(0), docsExamined(0) {}
 
@@ -44,6 +44,7 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 
@@ -381,6 +382,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_equalityHashSet = _equalityHashSet;
     next->_originalEqualityVector = _originalEqualityVector;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
@@ -390,7 +392,18 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     return std::move(next);
 }
 
+InMatchExpression::EqualityHashSet::EqualityHashSet(const CollatorInterface* collator,
+                                                    const std::vector<BSONElement>& equalities)
+    : eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, collator),
+      elements(eltCmp.makeBSONEltUnorderedSet()) {
+    elements.reserve(equalities.size());
+    elements.insert(equalities.begin(), equalities.end());
+}
+
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_equalityHashSet) {
+        return _equalityHashSet->elements.count(e) > 0;
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -496,12 +509,23 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     }
 
     // We need to re-compute '_equalitySet', since our set comparator has changed.
+    buildEqualitySet();
+}
+
+void InMatchExpression::buildEqualitySet() {
     _equalitySet.clear();
     _equalitySet.reserve(_originalEqualityVector.size());
     std::unique_copy(_originalEqualityVector.begin(),
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+
+    const auto minHashSetSize = internalQueryInHashSetMinSize.load();
+    if (minHashSetSize > 0 && _equalitySet.size() >= static_cast<size_t>(minHashSetSize)) {
+        _equalityHashSet = std::make_shared<const EqualityHashSet>(_collator, _equalitySet);
+    } else {
+        _equalityHashSet.reset();
+    }
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -529,12 +553,7 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
             _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
     }
 
-    _equalitySet.clear();
-    _equalitySet.reserve(_originalEqualityVector.size());
-    std::unique_copy(_originalEqualityVector.begin(),
-                     _originalEqualityVector.end(),
-                     std::back_inserter(_equalitySet),
-                     _eltCmp.makeEqualTo());
+    buildEqualitySet();
 
     return Status::OK();
 }
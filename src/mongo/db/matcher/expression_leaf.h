@@ -526,8 +526,26 @@ public:
     }
 
 private:
+    /**
+     * A hash set over the deduplicated equalities. It owns the comparator its hasher and equality
+     * predicate refer to, so that clones of the expression can share it.
+     */
+    struct EqualityHashSet {
+        EqualityHashSet(const CollatorInterface* collator,
+                        const std::vector<BSONElement>& equalities);
+
+        BSONElementComparator eltCmp;
+        BSONEltUnorderedSet elements;
+    };
+
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Rebuilds '_equalitySet' and '_equalityHashSet' from '_originalEqualityVector' using the
+     * current comparator.
+     */
+    void buildEqualitySet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -551,10 +569,13 @@ private:
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // For large $in lists, a hash set over the same elements answers contains() in constant time.
+    // Only built once '_equalitySet' reaches 'internalQueryInHashSetMinSize' elements. Immutable
+    // once built, and shared with clones of this expression.
+    std::shared_ptr<const EqualityHashSet> _equalityHashSet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
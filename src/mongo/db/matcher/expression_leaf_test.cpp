@@ -37,7 +37,9 @@
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -1370,6 +1372,78 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeInListMatchesThroughHashSet) {
+    const auto originalMinSize = internalQueryInHashSetMinSize.load();
+    internalQueryInHashSetMinSize.store(2);
+    ON_BLOCK_EXIT([&] { internalQueryInHashSetMinSize.store(originalMinSize); });
+
+    BSONArray operand = BSON_ARRAY(1 << 2.5 << "foo" << BSON("b" << 1) << BSON_ARRAY(1 << 2));
+    auto in = std::make_unique<InMatchExpression>("");
+    std::vector<BSONElement> equalities;
+    for (auto&& elt : operand) {
+        equalities.push_back(elt);
+    }
+    ASSERT_OK(in->setEqualities(std::move(equalities)));
+
+    // Numbers of different types compare equal, and field names are ignored.
+    ASSERT(in->matchesSingleElement(BSON("a" << 1.0).firstElement()));
+    ASSERT(in->matchesSingleElement(BSON("a" << 1LL).firstElement()));
+    ASSERT(in->matchesSingleElement(BSON("a" << 2.5).firstElement()));
+    ASSERT(in->matchesSingleElement(BSON("a"
+                                        << "foo")
+                                       .firstElement()));
+    ASSERT(in->matchesSingleElement(BSON("a" << BSON("b" << 1.0)).firstElement()));
+    ASSERT(in->matchesSingleElement(BSON("a" << BSON_ARRAY(1 << 2)).firstElement()));
+    ASSERT(!in->matchesSingleElement(BSON("a" << 2).firstElement()));
+    ASSERT(!in->matchesSingleElement(BSON("a"
+                                         << "Foo")
+                                        .firstElement()));
+    ASSERT(!in->matchesSingleElement(BSON("a" << BSON("c" << 1)).firstElement()));
+
+    // A clone keeps matching after the original is gone.
+    auto clone = in->shallowClone();
+    in.reset();
+    ASSERT(clone->matchesSingleElement(BSON("a" << 2.5).firstElement()));
+    ASSERT(!clone->matchesSingleElement(BSON("a" << 3).firstElement()));
+}
+
+TEST(InMatchExpression, LargeInListHashSetRespectsCollation) {
+    const auto originalMinSize = internalQueryInHashSetMinSize.load();
+    internalQueryInHashSetMinSize.store(2);
+    ON_BLOCK_EXIT([&] { internalQueryInHashSetMinSize.store(originalMinSize); });
+
+    BSONArray operand = BSON_ARRAY("ABC"
+                                   << "def"
+                                   << "Ghi");
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    InMatchExpression in("");
+    in.setCollator(&collator);
+    std::vector<BSONElement> equalities;
+    for (auto&& elt : operand) {
+        equalities.push_back(elt);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.contains(BSON(""
+                            << "abc")
+                           .firstElement()));
+    ASSERT(in.contains(BSON(""
+                            << "DEF")
+                           .firstElement()));
+    ASSERT(!in.contains(BSON(""
+                             << "jkl")
+                            .firstElement()));
+
+    // Dropping the collator rebuilds the set with binary comparison.
+    in.setCollator(nullptr);
+    ASSERT(in.contains(BSON(""
+                            << "ABC")
+                           .firstElement()));
+    ASSERT(!in.contains(BSON(""
+                             << "abc")
+                            .firstElement()));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -106,6 +106,7 @@
 #include "mongo/db/op_observer_registry.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/periodic_runner_job_abort_expired_transactions.h"
+#include "mongo/db/pipeline/document_source_facet.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mongod.h"
@@ -1243,6 +1244,10 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     migrationUtilExecutor->shutdown();
     migrationUtilExecutor->join();
 
+    // The facet threads run under OperationContexts which were killed along with every other.
+    LOGV2_OPTIONS(5100014, {LogComponent::kQuery}, "Shutting down the FacetExecutor");
+    DocumentSourceFacet::shutdownExecutor();
+
     if (ShardingState::get(serviceContext)->enabled()) {
         LOGV2_OPTIONS(4784922, {LogComponent::kSharding}, "Shutting down the CatalogCacheLoader");
         CatalogCacheLoader::get(serviceContext).shutDown();
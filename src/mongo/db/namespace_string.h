@@ -65,6 +65,9 @@ public:
     // Name for the system views collection
     static constexpr StringData kSystemDotViewsCollectionName = "system.views"_sd;
 
+    // Name for the collection of index statistics collected by the 'analyze' command
+    static constexpr StringData kSystemDotStatisticsCollectionName = "system.statistics"_sd;
+
     // Names of privilege document collections
     static constexpr StringData kSystemUsers = "system.users"_sd;
     static constexpr StringData kSystemRoles = "system.roles"_sd;
@@ -235,6 +238,9 @@ public:
     bool isSystemDotViews() const {
         return coll() == kSystemDotViewsCollectionName;
     }
+    bool isSystemDotStatistics() const {
+        return coll() == kSystemDotStatisticsCollectionName;
+    }
     bool isServerConfigurationCollection() const {
         return (db() == kAdminDb) && (coll() == "system.version");
     }
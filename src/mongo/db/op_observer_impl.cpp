@@ -50,6 +50,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/op_observer_util.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/index_statistics_cache.h"
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
@@ -482,6 +483,11 @@ void OpObserverImpl::onInserts(OperationContext* opCtx,
         Scope::storedFuncMod(opCtx);
     } else if (nss.coll() == DurableViewCatalog::viewsCollectionName()) {
         DurableViewCatalog::onExternalChange(opCtx, nss);
+    } else if (nss.isSystemDotStatistics()) {
+        auto& indexStatisticsCache = IndexStatisticsCache::get(opCtx->getServiceContext());
+        for (auto it = first; it != last; it++) {
+            indexStatisticsCache.onWrite(opCtx, nss, it->doc);
+        }
     } else if (nss == NamespaceString::kServerConfigurationNamespace) {
         // We must check server configuration collection writes for featureCompatibilityVersion
         // document changes.
@@ -558,6 +564,9 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
         Scope::storedFuncMod(opCtx);
     } else if (args.nss.coll() == DurableViewCatalog::viewsCollectionName()) {
         DurableViewCatalog::onExternalChange(opCtx, args.nss);
+    } else if (args.nss.isSystemDotStatistics()) {
+        IndexStatisticsCache::get(opCtx->getServiceContext())
+            .onWrite(opCtx, args.nss, args.updateArgs.updatedDoc);
     } else if (args.nss == NamespaceString::kServerConfigurationNamespace) {
         // We must check server configuration collection writes for featureCompatibilityVersion
         // document changes.
@@ -626,6 +635,9 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
         Scope::storedFuncMod(opCtx);
     } else if (nss.coll() == DurableViewCatalog::viewsCollectionName()) {
         DurableViewCatalog::onExternalChange(opCtx, nss);
+    } else if (nss.isSystemDotStatistics()) {
+        IndexStatisticsCache::get(opCtx->getServiceContext())
+            .onDelete(opCtx, nss, documentKey.getId().firstElement());
     } else if (nss.isServerConfigurationCollection()) {
         auto _id = documentKey.getId().firstElement();
         if (_id.type() == BSONType::String &&
@@ -746,6 +758,8 @@ void OpObserverImpl::onDropDatabase(OperationContext* opCtx, const std::string&
     if (dbName == NamespaceString::kSessionTransactionsTableNamespace.db()) {
         MongoDSessionCatalog::invalidateAllSessions(opCtx);
     }
+
+    IndexStatisticsCache::get(opCtx->getServiceContext()).onDrop(opCtx, dbName);
 }
 
 repl::OpTime OpObserverImpl::onDropCollection(OperationContext* opCtx,
@@ -770,6 +784,8 @@ repl::OpTime OpObserverImpl::onDropCollection(OperationContext* opCtx,
 
     if (collectionName.coll() == DurableViewCatalog::viewsCollectionName()) {
         DurableViewCatalog::onSystemViewsCollectionDrop(opCtx, collectionName);
+    } else if (collectionName.isSystemDotStatistics()) {
+        IndexStatisticsCache::get(opCtx->getServiceContext()).onDrop(opCtx, collectionName.db());
     } else if (collectionName == NamespaceString::kSessionTransactionsTableNamespace) {
         MongoDSessionCatalog::invalidateAllSessions(opCtx);
     } else if (collectionName == NamespaceString::kConfigSettingsNamespace) {
@@ -831,6 +847,10 @@ void OpObserverImpl::postRenameCollection(OperationContext* const opCtx,
         DurableViewCatalog::onExternalChange(opCtx, fromCollection);
     if (toCollection.isSystemDotViews())
         DurableViewCatalog::onExternalChange(opCtx, toCollection);
+    if (fromCollection.isSystemDotStatistics())
+        IndexStatisticsCache::get(opCtx->getServiceContext()).onDrop(opCtx, fromCollection.db());
+    if (toCollection.isSystemDotStatistics())
+        IndexStatisticsCache::get(opCtx->getServiceContext()).onDrop(opCtx, toCollection.db());
 }
 
 void OpObserverImpl::onRenameCollection(OperationContext* const opCtx,
@@ -1305,6 +1325,9 @@ void OpObserverImpl::onReplicationRollback(OperationContext* opCtx,
 
     // Make sure the in-memory FCV matches the on-disk FCV.
     FeatureCompatibilityVersion::onReplicationRollback(opCtx);
+
+    // Reload index statistics on next use, in case a statistics document was rolled back.
+    IndexStatisticsCache::get(opCtx->getServiceContext()).invalidateAll();
 }
 
 }  // namespace mongo
@@ -34,12 +34,14 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/optional.hpp>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "mongo/base/init.h"
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/exec/document_value/value_flat_unordered_set.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/stdx/unordered_set.h"
@@ -47,6 +49,8 @@
 
 namespace mongo {
 
+class SpilledAccumulatorValues;
+
 /**
  * This enum indicates which documents an accumulator needs to see in order to compute its output.
  */
@@ -152,10 +156,12 @@ class AccumulatorAddToSet final : public AccumulatorState {
 public:
     /**
      * Creates a new $addToSet accumulator. If no memory limit is given, defaults to the value of
-     * the server parameter 'internalQueryMaxAddToSetBytes'.
+     * the server parameter 'internalQueryMaxAddToSetBytes'. If disk use is allowed, the set is
+     * spilled to disk rather than exceeding the limit.
      */
     AccumulatorAddToSet(ExpressionContext* const expCtx,
                         boost::optional<int> maxMemoryUsageBytes = boost::none);
+    ~AccumulatorAddToSet();
 
     void processInternal(const Value& input, bool merging) final;
     Value getValue(bool toBeMerged) final;
@@ -173,8 +179,21 @@ public:
     }
 
 private:
-    ValueUnorderedSet _set;
+    /**
+     * Spills '_set' to disk if it has outgrown the memory limit, or throws if spilling is not
+     * allowed.
+     */
+    void checkMemoryUsage();
+
+    ValueFlatUnorderedSet _set;
+
+    // The approximate size of the memory owned by the values in '_set', outside of the set itself.
+    size_t _setValuesBytes = 0;
+
     int _maxMemUsageBytes;
+
+    // Values are written out as one run per spill, so a value may appear in several runs.
+    std::unique_ptr<SpilledAccumulatorValues> _spilledValues;
 };
 
 class AccumulatorFirst final : public AccumulatorState {
@@ -284,10 +303,12 @@ class AccumulatorPush final : public AccumulatorState {
 public:
     /**
      * Creates a new $push accumulator. If no memory limit is given, defaults to the value of the
-     * server parameter 'internalQueryMaxPushBytes'.
+     * server parameter 'internalQueryMaxPushBytes'. If disk use is allowed, the array is spilled to
+     * disk rather than exceeding the limit.
      */
     AccumulatorPush(ExpressionContext* const expCtx,
                     boost::optional<int> maxMemoryUsageBytes = boost::none);
+    ~AccumulatorPush();
 
     void processInternal(const Value& input, bool merging) final;
     Value getValue(bool toBeMerged) final;
@@ -297,8 +318,17 @@ public:
     static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx);
 
 private:
+    /**
+     * Spills '_array' to disk if it has outgrown the memory limit, or throws if spilling is not
+     * allowed.
+     */
+    void checkMemoryUsage();
+
     std::vector<Value> _array;
     int _maxMemUsageBytes;
+
+    // The values which preceded those in '_array', in the order they were pushed.
+    std::unique_ptr<SpilledAccumulatorValues> _spilledValues;
 };
 
 class AccumulatorAvg final : public AccumulatorState {
@@ -31,9 +31,12 @@
 
 #include "mongo/db/pipeline/accumulator.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/spilled_accumulator_values.h"
 #include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
@@ -49,14 +52,10 @@ const char* AccumulatorAddToSet::getOpName() const {
 
 void AccumulatorAddToSet::processInternal(const Value& input, bool merging) {
     auto addValue = [this](auto&& val) {
-        bool inserted = _set.insert(val).second;
+        bool inserted = _set.insert(val);
         if (inserted) {
-            _memUsageBytes += val.getApproximateSize();
-            uassert(ErrorCodes::ExceededMemoryLimit,
-                    str::stream()
-                        << "$addToSet used too much memory and cannot spill to disk. Memory limit: "
-                        << _maxMemUsageBytes << " bytes",
-                    _memUsageBytes < _maxMemUsageBytes);
+            _setValuesBytes += val.getApproximateSize() - sizeof(Value);
+            checkMemoryUsage();
         }
     };
     if (!merging) {
@@ -75,20 +74,60 @@ void AccumulatorAddToSet::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorAddToSet::checkMemoryUsage() {
+    _memUsageBytes = sizeof(*this) + _set.allocatedBytes() + _setValuesBytes;
+    if (_memUsageBytes < _maxMemUsageBytes) {
+        return;
+    }
+
+    uassert(ErrorCodes::ExceededMemoryLimit,
+            str::stream()
+                << "$addToSet used too much memory and cannot spill to disk. Memory limit: "
+                << _maxMemUsageBytes << " bytes",
+            SpilledAccumulatorValues::canSpill(getExpressionContext()));
+
+    if (!_spilledValues) {
+        _spilledValues = std::make_unique<SpilledAccumulatorValues>(getExpressionContext());
+    }
+    _spilledValues->spill(_set.toVector());
+    _set.clear();
+    _setValuesBytes = 0;
+    _memUsageBytes = sizeof(*this);
+}
+
 Value AccumulatorAddToSet::getValue(bool toBeMerged) {
-    return Value(vector<Value>(_set.begin(), _set.end()));
+    if (!_spilledValues) {
+        return Value(_set.toVector());
+    }
+
+    // Each run only holds the values which were distinct at the time it was spilled, so duplicates
+    // across runs are removed by sorting everything together.
+    vector<Value> values;
+    values.reserve(_spilledValues->numValues() + _set.size());
+    _spilledValues->forEach([&](const Value& val) { values.push_back(val); });
+    _set.forEach([&](const Value& val) { values.push_back(val); });
+
+    const auto& valueComparator = getExpressionContext()->getValueComparator();
+    std::sort(values.begin(), values.end(), valueComparator.getLessThan());
+    values.erase(std::unique(values.begin(), values.end(), valueComparator.getEqualTo()),
+                 values.end());
+    return Value(std::move(values));
 }
 
 AccumulatorAddToSet::AccumulatorAddToSet(ExpressionContext* const expCtx,
                                          boost::optional<int> maxMemoryUsageBytes)
     : AccumulatorState(expCtx),
-      _set(expCtx->getValueComparator().makeUnorderedValueSet()),
+      _set(expCtx->getValueComparator()),
       _maxMemUsageBytes(maxMemoryUsageBytes.value_or(internalQueryMaxAddToSetBytes.load())) {
     _memUsageBytes = sizeof(*this);
 }
 
+AccumulatorAddToSet::~AccumulatorAddToSet() = default;
+
 void AccumulatorAddToSet::reset() {
-    _set = getExpressionContext()->getValueComparator().makeUnorderedValueSet();
+    _set.clear();
+    _setValuesBytes = 0;
+    _spilledValues.reset();
     _memUsageBytes = sizeof(*this);
 }
 
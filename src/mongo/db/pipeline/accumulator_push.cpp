@@ -34,6 +34,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/spilled_accumulator_values.h"
 #include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
@@ -52,11 +53,7 @@ void AccumulatorPush::processInternal(const Value& input, bool merging) {
         if (!input.missing()) {
             _array.push_back(input);
             _memUsageBytes += input.getApproximateSize();
-            uassert(ErrorCodes::ExceededMemoryLimit,
-                    str::stream()
-                        << "$push used too much memory and cannot spill to disk. Memory limit: "
-                        << _maxMemUsageBytes << " bytes",
-                    _memUsageBytes < _maxMemUsageBytes);
+            checkMemoryUsage();
         }
     } else {
         // If we're merging, we need to take apart the arrays we receive and put their elements into
@@ -64,21 +61,42 @@ void AccumulatorPush::processInternal(const Value& input, bool merging) {
         // array from each merge source.
         invariant(input.getType() == Array);
 
-        const vector<Value>& vec = input.getArray();
-        for (auto&& val : vec) {
+        for (auto&& val : input.getArray()) {
+            _array.push_back(val);
             _memUsageBytes += val.getApproximateSize();
-            uassert(ErrorCodes::ExceededMemoryLimit,
-                    str::stream()
-                        << "$push used too much memory and cannot spill to disk. Memory limit: "
-                        << _maxMemUsageBytes << " bytes",
-                    _memUsageBytes < _maxMemUsageBytes);
+            checkMemoryUsage();
         }
-        _array.insert(_array.end(), vec.begin(), vec.end());
     }
 }
 
+void AccumulatorPush::checkMemoryUsage() {
+    if (_memUsageBytes < _maxMemUsageBytes) {
+        return;
+    }
+
+    uassert(ErrorCodes::ExceededMemoryLimit,
+            str::stream() << "$push used too much memory and cannot spill to disk. Memory limit: "
+                          << _maxMemUsageBytes << " bytes",
+            SpilledAccumulatorValues::canSpill(getExpressionContext()));
+
+    if (!_spilledValues) {
+        _spilledValues = std::make_unique<SpilledAccumulatorValues>(getExpressionContext());
+    }
+    _spilledValues->spill(_array);
+    vector<Value>().swap(_array);
+    _memUsageBytes = sizeof(*this);
+}
+
 Value AccumulatorPush::getValue(bool toBeMerged) {
-    return Value(_array);
+    if (!_spilledValues) {
+        return Value(_array);
+    }
+
+    vector<Value> values;
+    values.reserve(_spilledValues->numValues() + _array.size());
+    _spilledValues->forEach([&](const Value& val) { values.push_back(val); });
+    values.insert(values.end(), _array.begin(), _array.end());
+    return Value(std::move(values));
 }
 
 AccumulatorPush::AccumulatorPush(ExpressionContext* const expCtx,
@@ -88,8 +106,11 @@ AccumulatorPush::AccumulatorPush(ExpressionContext* const expCtx,
     _memUsageBytes = sizeof(*this);
 }
 
+AccumulatorPush::~AccumulatorPush() = default;
+
 void AccumulatorPush::reset() {
     vector<Value>().swap(_array);
+    _spilledValues.reset();
     _memUsageBytes = sizeof(*this);
 }
 
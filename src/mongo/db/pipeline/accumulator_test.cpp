@@ -41,6 +41,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/logv2/log.h"
+#include "mongo/unittest/temp_dir.h"
 
 namespace AccumulatorTests {
 
@@ -368,6 +369,50 @@ TEST(Accumulators, PushRespectsMaxMemoryConstraint) {
         ErrorCodes::ExceededMemoryLimit);
 }
 
+TEST(Accumulators, AddToSetSpillsWhenOverMaxMemoryIfDiskUseIsAllowed) {
+    auto expCtx = ExpressionContextForTest{};
+    unittest::TempDir tempDir("AddToSetSpillsWhenOverMaxMemoryIfDiskUseIsAllowed");
+    expCtx.tempDir = tempDir.path();
+    expCtx.allowDiskUse = true;
+
+    // Small enough that the set is spilled many times, so that duplicates are spread across runs.
+    const int maxMemoryBytes = 1024;
+    auto addToSet = AccumulatorAddToSet(&expCtx, maxMemoryBytes);
+    for (int i = 0; i < 1000; ++i) {
+        addToSet.process(Value(i % 300), false);
+    }
+    addToSet.process(Value(std::vector<Value>{Value(299), Value(300)}), true);
+
+    auto result = addToSet.getValue(false).getArray();
+    ASSERT_EQ(result.size(), 301UL);
+    std::sort(result.begin(), result.end(), expCtx.getValueComparator().getLessThan());
+    for (int i = 0; i <= 300; ++i) {
+        ASSERT_VALUE_EQ(result[i], Value(i));
+    }
+}
+
+TEST(Accumulators, PushSpillsWhenOverMaxMemoryIfDiskUseIsAllowed) {
+    auto expCtx = ExpressionContextForTest{};
+    unittest::TempDir tempDir("PushSpillsWhenOverMaxMemoryIfDiskUseIsAllowed");
+    expCtx.tempDir = tempDir.path();
+    expCtx.allowDiskUse = true;
+
+    const int maxMemoryBytes = 1024;
+    auto push = AccumulatorPush(&expCtx, maxMemoryBytes);
+    std::vector<Value> expected;
+    for (int i = 0; i < 1000; ++i) {
+        push.process(Value(i % 300), false);
+        expected.push_back(Value(i % 300));
+    }
+
+    // The spilled values must come back in the order they were pushed.
+    ASSERT_VALUE_EQ(push.getValue(false), Value(expected));
+
+    push.reset();
+    push.process(Value(1), false);
+    ASSERT_VALUE_EQ(push.getValue(false), Value(std::vector<Value>{Value(1)}));
+}
+
 /* ------------------------- AccumulatorMergeObjects -------------------------- */
 
 TEST(AccumulatorMergeObjects, MergingZeroObjectsShouldReturnEmptyDocument) {
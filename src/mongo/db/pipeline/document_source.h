@@ -43,6 +43,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/exec/document_value/columnar_document_batch.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/plan_stats.h"
@@ -275,6 +276,42 @@ public:
         return next;
     }
 
+    /**
+     * Returns true if this stage can produce its results as a sequence of columnar batches through
+     * getNextColumnarBatch(). A consumer must read all of a stage's results either through
+     * getNext() or through getNextColumnarBatch(), and must make this check before any call to
+     * getNext().
+     */
+    virtual bool supportsColumnarBatches() const {
+        return false;
+    }
+
+    /**
+     * Replaces the contents of 'batch' with the next batch of results from this stage, keeping
+     * only the fields named by 'batch'. Returns false once the stage is exhausted, in which case
+     * 'batch' is left empty. Illegal to call unless supportsColumnarBatches() returns true.
+     */
+    bool getNextColumnarBatch(ColumnarDocumentBatch* batch) {
+        pExpCtx->checkForInterrupt();
+
+        if (MONGO_likely(!pExpCtx->shouldCollectDocumentSourceExecStats())) {
+            return doGetNextColumnarBatch(batch);
+        }
+
+        auto serviceCtx = pExpCtx->opCtx->getServiceContext();
+        invariant(serviceCtx);
+        auto fcs = serviceCtx->getFastClockSource();
+        invariant(fcs);
+
+        invariant(_commonStats.executionTimeMillis);
+        ScopedTimer timer(fcs, _commonStats.executionTimeMillis.get_ptr());
+        ++_commonStats.works;
+
+        const bool advanced = doGetNextColumnarBatch(batch);
+        _commonStats.advanced += batch->size();
+        return advanced;
+    }
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage. Input parameter Pipeline::SplitState is used by stages whose requirements change
@@ -341,6 +378,13 @@ public:
 
     virtual void reattachToOperationContext(OperationContext* opCtx) {}
 
+    /**
+     * Starts fetching the next batch of any results this stage receives from remote cursors,
+     * without waiting for them to arrive. Does nothing for stages which do not read from remote
+     * cursors.
+     */
+    virtual void prefetchRemoteResults() {}
+
     virtual bool usedDisk() {
         return false;
     };
@@ -513,6 +557,13 @@ protected:
      */
     virtual GetNextResult doGetNext() = 0;
 
+    /**
+     * The columnar counterpart of doGetNext(). See comment at getNextColumnarBatch().
+     */
+    virtual bool doGetNextColumnarBatch(ColumnarDocumentBatch* batch) {
+        MONGO_UNREACHABLE;
+    }
+
     /**
      * Attempt to perform an optimization with the following source in the pipeline. 'container'
      * refers to the entire pipeline, and 'itr' points to this stage within the pipeline.
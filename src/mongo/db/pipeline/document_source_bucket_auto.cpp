@@ -156,7 +156,12 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
-        _sorter->add(extractKey(nextDoc), nextDoc);
+        if (pExpCtx->documentArena) {
+            // As in $sort, buffered documents are kept out of the document arena.
+            _sorter->add(extractKey(nextDoc).copyOutOfArena(), nextDoc.copyOutOfArena());
+        } else {
+            _sorter->add(extractKey(nextDoc), nextDoc);
+        }
         _nDocuments++;
     }
     return next;
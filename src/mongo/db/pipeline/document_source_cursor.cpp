@@ -117,10 +117,32 @@ DocumentSource::GetNextResult DocumentSourceCursor::doGetNext() {
     if (_currentBatch.isEmpty())
         return GetNextResult::makeEOF();
 
+    _returnedRowResults = true;
     return _currentBatch.dequeue();
 }
 
-void DocumentSourceCursor::loadBatch() {
+bool DocumentSourceCursor::supportsColumnarBatches() const {
+    return internalDocumentSourceCursorEnableColumnarBatches.load() &&
+        _currentBatch.type() == CursorType::kRegular && !_returnedRowResults && !_trackOplogTS &&
+        !pExpCtx->isTailableAwaitData();
+}
+
+bool DocumentSourceCursor::doGetNextColumnarBatch(ColumnarDocumentBatch* batch) {
+    invariant(!_returnedRowResults);
+    batch->clear();
+
+    // Hand over any documents which were already loaded into the row-wise batch first.
+    while (!_currentBatch.isEmpty()) {
+        batch->appendRow(_currentBatch.dequeue());
+    }
+
+    if (batch->empty()) {
+        loadBatch(batch);
+    }
+    return !batch->empty();
+}
+
+void DocumentSourceCursor::loadBatch(ColumnarDocumentBatch* columnarBatch) {
     if (!_exec || _exec->isDisposed()) {
         // No more documents.
         return;
@@ -148,12 +170,24 @@ void DocumentSourceCursor::loadBatch() {
         ON_BLOCK_EXIT([this] { recordPlanSummaryStats(); });
 
         while ((state = _exec->getNext(&resultObj, nullptr)) == PlanExecutor::ADVANCED) {
-            _currentBatch.enqueue(transformDoc(std::move(resultObj)));
+            if (columnarBatch) {
+                // Read the fields straight from the underlying BSON where the document has not
+                // been modified, rather than through the Document's field lookups.
+                if (auto obj = resultObj.toBsonIfTriviallyConvertible()) {
+                    columnarBatch->appendRow(*obj);
+                } else {
+                    columnarBatch->appendRow(resultObj);
+                }
+            } else {
+                _currentBatch.enqueue(transformDoc(std::move(resultObj)));
+            }
+            const size_t batchSizeBytes =
+                columnarBatch ? columnarBatch->memUsageBytes() : _currentBatch.memUsageBytes();
 
             // As long as we're waiting for inserts, we shouldn't do any batching at this level we
             // need the whole pipeline to see each document to see if we should stop waiting.
             if (awaitDataState(pExpCtx->opCtx).shouldWaitForInserts ||
-                static_cast<long long>(_currentBatch.memUsageBytes()) >
+                static_cast<long long>(batchSizeBytes) >
                     internalDocumentSourceCursorBatchSizeBytes.load()) {
                 // End this batch and prepare PlanExecutor for yielding.
                 _exec->saveState();
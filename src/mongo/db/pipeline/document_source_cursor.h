@@ -111,6 +111,14 @@ public:
         return _planSummaryStats.usedDisk;
     }
 
+    /**
+     * A $cursor stage can produce columnar batches when it returns whole documents and is not
+     * tracking the oplog, provided that no document has been read through getNext() yet. The
+     * columns are filled from the PlanExecutor's results without calling transformDoc(), so
+     * subclasses which override it must not produce columnar batches.
+     */
+    bool supportsColumnarBatches() const override;
+
 protected:
     DocumentSourceCursor(Collection* collection,
                          std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
@@ -120,6 +128,8 @@ protected:
 
     GetNextResult doGetNext() final;
 
+    bool doGetNextColumnarBatch(ColumnarDocumentBatch* batch) final;
+
     ~DocumentSourceCursor();
 
     /**
@@ -162,6 +172,10 @@ private:
 
         bool isEmpty() const;
 
+        CursorType type() const {
+            return _type;
+        }
+
         /**
          * Returns the approximate memory footprint of this batch, measured in bytes. Even after
          * documents are dequeued from the batch, continues to indicate the batch's peak memory
@@ -204,9 +218,10 @@ private:
 
     /**
      * Reads a batch of data from '_exec'. Subclasses can specify custom behavior to be performed on
-     * each document by overloading transformBSONObjToDocument().
+     * each document by overloading transformBSONObjToDocument(). If 'columnarBatch' is non-null,
+     * the documents' fields are appended to it rather than the documents to '_currentBatch'.
      */
-    void loadBatch();
+    void loadBatch(ColumnarDocumentBatch* columnarBatch = nullptr);
 
     void recordPlanSummaryStats();
 
@@ -219,6 +234,10 @@ private:
     // Batches results returned from the underlying PlanExecutor.
     Batch _currentBatch;
 
+    // True once a document has been returned through getNext(), after which this stage can no
+    // longer switch to producing columnar batches.
+    bool _returnedRowResults = false;
+
     // The underlying query plan which feeds this pipeline. Must be destroyed while holding the
     // collection lock.
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
@@ -35,11 +35,14 @@
 #include <iterator>
 #include <set>
 
+#include "mongo/db/client.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -343,7 +346,10 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx,
             // Some other consumer is already loading the buffers. There is nothing else we can do
             // but wait.
             MutexAndResourceLock mutexAndResourceLock(opCtx, std::move(lk), resourceYielder);
-            _haveBufferSpace.wait(mutexAndResourceLock);
+            opCtx->waitForConditionOrInterrupt(_haveBufferSpace, mutexAndResourceLock, [&] {
+                return !_errorInLoadNextBatch.isOK() || !_consumers[consumerId]->isEmpty() ||
+                    _loadingThreadId == kInvalidThreadId;
+            });
             lk = mutexAndResourceLock.releaseLockOwnership();
         }
     }
@@ -438,6 +444,17 @@ size_t Exchange::getTargetConsumer(const Document& input) {
     return cid;
 }
 
+std::vector<Value> Exchange::writeExplainOps(OperationContext* opCtx,
+                                             ExplainOptions::Verbosity verbosity) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // Only the ExpressionContext is needed to describe the input, so the stages are left detached.
+    auto& expCtx = _pipeline->getContext();
+    expCtx->opCtx = opCtx;
+    ON_BLOCK_EXIT([&] { expCtx->opCtx = nullptr; });
+    return _pipeline->writeExplainOps(verbosity);
+}
+
 void Exchange::dispose(OperationContext* opCtx, size_t consumerId) {
     stdx::lock_guard<Latch> lk(_mutex);
 
@@ -487,4 +504,205 @@ bool Exchange::ExchangeBuffer::appendDocument(DocumentSource::GetNextResult inpu
     return _bytesInBuffer >= limit;
 }
 
+boost::intrusive_ptr<DocumentSourceExchangeGather> DocumentSourceExchangeGather::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> consumers) {
+    return new DocumentSourceExchangeGather(expCtx, std::move(consumers));
+}
+
+DocumentSourceExchangeGather::DocumentSourceExchangeGather(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> consumers)
+    : DocumentSource(kStageName, expCtx),
+      _consumers(std::move(consumers)),
+      _consumerDisposed(_consumers.size(), false),
+      _firstResults(_consumers.size()),
+      _workerOpCtxs(_consumers.size(), nullptr) {
+    invariant(!_consumers.empty());
+    for (auto&& consumer : _consumers) {
+        auto exchange = dynamic_cast<DocumentSourceExchange*>(consumer->peekFront());
+        invariant(exchange);
+        if (!_exchange) {
+            _exchange = exchange->getExchange();
+        }
+        invariant(exchange->getExchange() == _exchange);
+        invariant(consumer->getSources().back()->constraints(Pipeline::SplitState::kUnsplit)
+                      .streamType == StreamType::kBlocking);
+        invariant(consumer->getContext() != pExpCtx);
+        invariant(consumer->getContext() != _exchange->getPipeline()->getContext());
+
+        // Consumers are disposed of explicitly as soon as they are exhausted.
+        consumer.get_deleter().dismissDisposal();
+    }
+}
+
+const char* DocumentSourceExchangeGather::getSourceName() const {
+    return kStageName.rawData();
+}
+
+Value DocumentSourceExchangeGather::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    // Every consumer runs the same pipeline, so describe only the first.
+    MutableDocument out;
+    out["consumers"] = Value(static_cast<long long>(_consumers.size()));
+    out["pipeline"] =
+        Value(explain ? _consumers[0]->writeExplainOps(*explain) : _consumers[0]->serialize());
+    if (explain) {
+        out["input"] = Value(_exchange->writeExplainOps(pExpCtx->opCtx, *explain));
+    }
+    return Value(DOC(getSourceName() << out.freezeToValue()));
+}
+
+void DocumentSourceExchangeGather::detachFromOperationContext() {
+    for (auto&& consumer : _consumers) {
+        consumer->detachFromOperationContext();
+    }
+}
+
+void DocumentSourceExchangeGather::reattachToOperationContext(OperationContext* opCtx) {
+    for (auto&& consumer : _consumers) {
+        consumer->reattachToOperationContext(opCtx);
+    }
+}
+
+bool DocumentSourceExchangeGather::usedDisk() {
+    return std::any_of(_consumers.begin(), _consumers.end(), [](auto&& consumer) {
+        return consumer->usedDisk();
+    });
+}
+
+DocumentSource::GetNextResult DocumentSourceExchangeGather::doGetNext() {
+    if (!_consumersRun) {
+        runConsumers();
+        _consumersRun = true;
+    }
+
+    // Every consumer has read all of its input, so the rest of its results can be pulled on this
+    // thread without waiting for the others.
+    while (_nextConsumer < _consumers.size()) {
+        if (auto& firstResult = _firstResults[_nextConsumer]) {
+            auto result = std::move(*firstResult);
+            firstResult = boost::none;
+            return std::move(result);
+        }
+
+        if (!_consumerDisposed[_nextConsumer]) {
+            auto& consumer = _consumers[_nextConsumer];
+            if (auto next = consumer->getNext()) {
+                return std::move(*next);
+            }
+            consumer->dispose(pExpCtx->opCtx);
+            _consumerDisposed[_nextConsumer] = true;
+        }
+        ++_nextConsumer;
+    }
+    return GetNextResult::makeEOF();
+}
+
+void DocumentSourceExchangeGather::runConsumer(size_t consumerId) {
+    auto& consumer = _consumers[consumerId];
+    auto disposeGuard = makeGuard([&] {
+        consumer->dispose(consumer->getContext()->opCtx);
+        _consumerDisposed[consumerId] = true;
+    });
+
+    if (auto next = consumer->getNext()) {
+        _firstResults[consumerId] = std::move(*next);
+        disposeGuard.dismiss();
+    }
+}
+
+void DocumentSourceExchangeGather::runWorker(size_t consumerId, ServiceContext* serviceContext) {
+    ThreadClient tc("ExchangeGatherConsumer", serviceContext);
+    auto opCtx = cc().makeOperationContext();
+    {
+        stdx::lock_guard<Latch> lk(_workersMutex);
+        _workerOpCtxs[consumerId] = opCtx.get();
+        if (_stoppingWorkers) {
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            serviceContext->killOperation(clientLock, opCtx.get());
+        }
+    }
+
+    Status status = Status::OK();
+    try {
+        auto& consumer = _consumers[consumerId];
+        consumer->reattachToOperationContext(opCtx.get());
+        ON_BLOCK_EXIT([&] { consumer->detachFromOperationContext(); });
+        runConsumer(consumerId);
+    } catch (const DBException& ex) {
+        status = ex.toStatus();
+    }
+
+    stdx::lock_guard<Latch> lk(_workersMutex);
+    _workerOpCtxs[consumerId] = nullptr;
+    if (_workersStatus.isOK()) {
+        _workersStatus = std::move(status);
+    }
+    if (--_numWorkersRunning == 0) {
+        _workersDone.notify_all();
+    }
+}
+
+void DocumentSourceExchangeGather::runConsumers() {
+    auto opCtx = pExpCtx->opCtx;
+    auto serviceContext = opCtx->getServiceContext();
+
+    // A consumer may wait for any other to drain its Exchange buffer, so all of them must run at
+    // once. Each gets a thread of its own for this reason: a bounded pool shared with other
+    // operations could leave some consumers queued behind the ones waiting on them.
+    std::vector<stdx::thread> workers;
+    Status status = Status::OK();
+    try {
+        for (size_t consumerId = 1; consumerId < _consumers.size(); ++consumerId) {
+            {
+                stdx::lock_guard<Latch> lk(_workersMutex);
+                ++_numWorkersRunning;
+            }
+            workers.emplace_back(
+                [this, consumerId, serviceContext] { runWorker(consumerId, serviceContext); });
+        }
+
+        runConsumer(0);
+
+        // Killing the operation interrupts this wait, and the workers are then stopped below.
+        stdx::unique_lock<Latch> lk(_workersMutex);
+        opCtx->waitForConditionOrInterrupt(
+            _workersDone, lk, [&] { return _numWorkersRunning == 0; });
+        status = _workersStatus;
+    } catch (const DBException& ex) {
+        status = ex.toStatus();
+    }
+
+    // Interrupt the workers still running, which only happens on error, and wait for all of them.
+    {
+        stdx::lock_guard<Latch> lk(_workersMutex);
+        _stoppingWorkers = true;
+        for (auto workerOpCtx : _workerOpCtxs) {
+            if (workerOpCtx) {
+                stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+                serviceContext->killOperation(clientLock, workerOpCtx);
+            }
+        }
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+
+    // The rest of the results of every consumer are pulled on this thread.
+    for (auto&& consumer : _consumers) {
+        consumer->reattachToOperationContext(opCtx);
+    }
+    uassertStatusOK(status);
+}
+
+void DocumentSourceExchangeGather::doDispose() {
+    for (size_t consumerId = 0; consumerId < _consumers.size(); ++consumerId) {
+        if (!_consumerDisposed[consumerId]) {
+            _consumers[consumerId]->dispose(pExpCtx->opCtx);
+            _consumerDisposed[consumerId] = true;
+        }
+    }
+}
+
 }  // namespace mongo
@@ -93,6 +93,20 @@ public:
         return _spec;
     }
 
+    /**
+     * Returns the input to the exchange operator, which is detached from any OperationContext.
+     */
+    const Pipeline* getPipeline() const {
+        return _pipeline.get();
+    }
+
+    /**
+     * Describes the input to the exchange operator for explain, temporarily attaching it to
+     * 'opCtx'. Must not be called while a consumer is running.
+     */
+    std::vector<Value> writeExplainOps(OperationContext* opCtx,
+                                       ExplainOptions::Verbosity verbosity);
+
     void dispose(OperationContext* opCtx, size_t consumerId);
 
     /**
@@ -259,4 +273,118 @@ private:
     std::unique_ptr<ResourceYielder> _resourceYielder;
 };
 
+/**
+ * Runs the consumer pipelines of an Exchange in parallel on this node and returns all of their
+ * results. Each consumer pipeline must begin with a DocumentSourceExchange, end with a blocking
+ * stage and have its own ExpressionContext, as must the input to the Exchange, which the consumers
+ * attach to their own OperationContexts while they load it. One consumer runs on the calling thread
+ * and each of the others on a thread of its own, under its own OperationContext, until it has read
+ * all of its input from the Exchange. The results of each consumer are then pulled from it in turn
+ * on the calling thread, so they are never buffered beyond what its last stage holds.
+ */
+class DocumentSourceExchangeGather final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalExchangeGather"_sd;
+
+    static boost::intrusive_ptr<DocumentSourceExchangeGather> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> consumers);
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kBlocking,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kNone,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed,
+                                     LookupRequirement::kNotAllowed,
+                                     UnionRequirement::kNotAllowed);
+
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    const char* getSourceName() const final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    void detachFromOperationContext() final;
+
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
+    bool usedDisk() final;
+
+    /**
+     * Returns the input to the Exchange which feeds the consumers.
+     */
+    const Pipeline* getInputPipeline() const {
+        return _exchange->getPipeline();
+    }
+
+private:
+    DocumentSourceExchangeGather(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                 std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> consumers);
+
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    /**
+     * Runs every consumer until it has read all of its input, starting a thread for each consumer
+     * but the first. If any consumer fails or the operation is killed, stops the others and throws.
+     */
+    void runConsumers();
+
+    /**
+     * Body of the thread which runs the consumer 'consumerId' under its own OperationContext.
+     */
+    void runWorker(size_t consumerId, ServiceContext* serviceContext);
+
+    /**
+     * Pulls the first result of the consumer 'consumerId' into '_firstResults'. Disposes of the
+     * consumer if it has no results or fails, so that it cannot leave the consumers still reading
+     * from the Exchange waiting for it to drain its buffer.
+     */
+    void runConsumer(size_t consumerId);
+
+    // The Exchange which every consumer reads from.
+    boost::intrusive_ptr<Exchange> _exchange;
+
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> _consumers;
+
+    // Whether each consumer has been disposed of. The worker threads may set their elements
+    // concurrently, which a vector<bool> would not allow.
+    std::vector<char> _consumerDisposed;
+
+    // The first result of each consumer which has one. The consumers' last stages are blocking, so
+    // these are ready once every consumer has read all of its input.
+    std::vector<boost::optional<Document>> _firstResults;
+
+    // Protects the state of the worker threads below.
+    Mutex _workersMutex = MONGO_MAKE_LATCH("DocumentSourceExchangeGather::_workersMutex");
+
+    // Notified when the last worker thread finishes.
+    stdx::condition_variable _workersDone;
+
+    // The OperationContext of each worker thread while it runs its consumer, indexed by consumer.
+    std::vector<OperationContext*> _workerOpCtxs;
+    size_t _numWorkersRunning = 0;
+
+    // Set once the worker threads are being stopped, so that one which has yet to start stops too.
+    bool _stoppingWorkers = false;
+
+    // The first error raised by a worker thread.
+    Status _workersStatus = Status::OK();
+
+    // Set once every consumer has been run.
+    bool _consumersRun = false;
+
+    // The consumer whose results are being returned.
+    size_t _nextConsumer = 0;
+};
+
 }  // namespace mongo
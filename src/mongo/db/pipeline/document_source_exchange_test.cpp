@@ -31,9 +31,11 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/executor/network_interface_factory.h"
@@ -118,6 +120,34 @@ protected:
         return source;
     }
 
+    /**
+     * Returns a $_internalExchangeGather over 'nConsumers' consumers of a round-robin Exchange
+     * which reads 'nDocs' documents. Each consumer computes a partial 'groupSpec' over its share.
+     */
+    auto makeGather(int nDocs, size_t nConsumers, int bufferSize, BSONObj groupSpec) {
+        ExchangeSpec spec;
+        spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+        spec.setConsumers(nConsumers);
+        spec.setBufferSize(bufferSize);
+
+        // The consumers attach the input to their own OperationContexts, so it must not share an
+        // ExpressionContext with anything else.
+        boost::intrusive_ptr<Exchange> ex = new Exchange(
+            spec,
+            Pipeline::create({getMockSource(nDocs)}, getExpCtx()->copyWith(getExpCtx()->ns)));
+
+        std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> consumers;
+        for (size_t id = 0; id < nConsumers; ++id) {
+            auto consumerExpCtx = getExpCtx()->copyWith(getExpCtx()->ns);
+            consumerExpCtx->needsMerge = true;
+            auto consumer = Pipeline::parse({groupSpec}, consumerExpCtx);
+            consumer->addInitialSource(
+                new DocumentSourceExchange(consumerExpCtx, ex, id, nullptr));
+            consumers.push_back(std::move(consumer));
+        }
+        return DocumentSourceExchangeGather::create(getExpCtx(), std::move(consumers));
+    }
+
     static auto getNewSeed() {
         auto seed = Date_t::now().asInt64();
         LOGV2(20898, "Generated new seed is {seed}", "seed"_attr = seed);
@@ -229,6 +259,36 @@ TEST_F(DocumentSourceExchangeTest, SimpleExchangeNConsumer) {
         _executor->wait(h);
 }
 
+TEST_F(DocumentSourceExchangeTest, GatherCombinesPartialGroupsComputedByEachConsumer) {
+    const int nDocs = 500;
+    auto groupSpec = fromjson("{$group: {_id: null, total: {$sum: '$a'}, count: {$sum: 1}}}");
+    auto gather = makeGather(nDocs, 4, 1024, groupSpec);
+
+    auto group = DocumentSourceGroup::createFromBson(groupSpec.firstElement(), getExpCtx());
+    auto mergingGroup = group->distributedPlanLogic()->mergingStage;
+    mergingGroup->setSource(gather.get());
+
+    auto next = mergingGroup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", BSONNULL},
+                                 {"total", nDocs * (nDocs - 1) / 2},
+                                 {"count", nDocs}}));
+    ASSERT_TRUE(mergingGroup->getNext().isEOF());
+    ASSERT_EQ(getExpCtx()->opCtx, getOpCtx());
+    mergingGroup->dispose();
+}
+
+TEST_F(DocumentSourceExchangeTest, GatherStopsEveryConsumerWhenTheOperationIsKilled) {
+    auto gather = makeGather(500, 4, 64, fromjson("{$group: {_id: '$a', count: {$sum: 1}}}"));
+
+    // Whether or not the consumer on this thread has to wait for the others, the operation being
+    // killed makes the gather stop the worker threads and fail.
+    getExpCtx()->opCtx->markKilled(ErrorCodes::Interrupted);
+    ASSERT_THROWS_CODE(gather->getNext(), AssertionException, ErrorCodes::Interrupted);
+    gather->dispose();
+}
+
 TEST_F(DocumentSourceExchangeTest, ExchangeNConsumerEarlyout) {
     const size_t nDocs = 500;
     auto source = getMockSource(500);
@@ -34,19 +34,26 @@
 #include <memory>
 #include <vector>
 
+#include "mongo/base/init.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -55,15 +62,39 @@ using std::pair;
 using std::string;
 using std::vector;
 
+namespace {
+// The executor on which facet pipelines run in parallel. It is shared by every $facet stage, which
+// bounds the number of threads used across all operations.
+std::unique_ptr<ThreadPool> facetExecutor;
+MONGO_INITIALIZER_WITH_PREREQUISITES(FacetExecutor, ("EndStartupOptionStorage"))
+(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "FacetExecutor";
+    options.threadNamePrefix = "FacetExecutor-";
+    options.minThreads = 0;
+    options.maxThreads = internalQueryFacetExecutorMaxThreads.load();
+    facetExecutor = std::make_unique<ThreadPool>(options);
+    facetExecutor->startup();
+
+    return Status::OK();
+}
+}  // namespace
+
+void DocumentSourceFacet::shutdownExecutor() {
+    facetExecutor->shutdown();
+    facetExecutor->join();
+}
+
 DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelines,
                                          const intrusive_ptr<ExpressionContext>& expCtx)
     : DocumentSource(kStageName, expCtx),
       _teeBuffer(TeeBuffer::create(facetPipelines.size())),
-      _facets(std::move(facetPipelines)) {
+      _facets(std::move(facetPipelines)),
+      _facetStats(_facets.size()) {
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
         facet.pipeline->addInitialSource(
-            DocumentSourceTeeConsumer::create(pExpCtx, facetId, _teeBuffer));
+            DocumentSourceTeeConsumer::create(facet.pipeline->getContext(), facetId, _teeBuffer));
     }
 }
 
@@ -138,22 +169,156 @@ void DocumentSourceFacet::doDispose() {
     }
 }
 
+bool DocumentSourceFacet::runFacetUntilPaused(size_t facetId, std::vector<Value>* results) {
+    Timer timer;
+    const auto& pipeline = _facets[facetId].pipeline;
+    auto next = pipeline->getSources().back()->getNext();
+    for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+        results->emplace_back(next.releaseDocument());
+    }
+    _facetStats[facetId].executionTimeMicros += timer.micros();
+    return next.isEOF();
+}
+
+std::vector<size_t> DocumentSourceFacet::prepareParallelFacets() {
+    if (internalQueryFacetMaxParallelism.load() <= 1 || _facets.size() < 2 || !pExpCtx->opCtx) {
+        return {};
+    }
+
+    std::vector<size_t> parallelFacetIds;
+    for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+        auto& facet = _facets[facetId];
+        // The ExpressionContext is mutated while expressions are evaluated, so only a facet which
+        // was parsed with a private one can run alongside the others. A facet which reads from
+        // another collection needs the locks and the snapshot held by this operation, so it has
+        // to stay on this thread.
+        if (facet.pipeline->getContext() == pExpCtx ||
+            !facet.pipeline->getInvolvedCollections().empty()) {
+            continue;
+        }
+
+        _facetStats[facetId].ranInParallel = true;
+        parallelFacetIds.push_back(facetId);
+    }
+    return parallelFacetIds;
+}
+
+void DocumentSourceFacet::runFacetsInParallel(const std::vector<size_t>& parallelFacetIds,
+                                              std::vector<std::vector<Value>>* results) {
+    // Divide the parallel facets among at most 'internalQueryFacetMaxParallelism' tasks.
+    const size_t nTasks = std::min(parallelFacetIds.size(),
+                                   static_cast<size_t>(internalQueryFacetMaxParallelism.load()));
+    std::vector<std::vector<size_t>> facetIdsByTask(nTasks);
+    for (size_t i = 0; i < parallelFacetIds.size(); ++i) {
+        facetIdsByTask[i % nTasks].push_back(parallelFacetIds[i]);
+    }
+
+    // Each task runs its facets under a Client and an OperationContext of its own, which are made
+    // once here and moved onto whichever executor thread runs the task for each batch.
+    struct TaskContext {
+        ServiceContext::UniqueClient client;
+        ServiceContext::UniqueOperationContext opCtx;
+    };
+    std::vector<TaskContext> taskContexts(nTasks);
+    for (auto&& taskContext : taskContexts) {
+        taskContext.client =
+            pExpCtx->opCtx->getServiceContext()->makeClient("FacetExecutor");
+        AlternativeClientRegion acr(taskContext.client);
+        taskContext.opCtx = cc().makeOperationContext();
+    }
+    ON_BLOCK_EXIT([&] {
+        for (auto&& taskContext : taskContexts) {
+            AlternativeClientRegion acr(taskContext.client);
+            taskContext.opCtx.reset();
+        }
+    });
+
+    // Each element is written only by the thread running that facet, so this must not be a
+    // vector<bool>.
+    std::vector<char> isEOF(_facets.size(), false);
+
+    bool allPipelinesEOF = false;
+    while (!allPipelinesEOF) {
+        _teeBuffer->loadNextSharedBatch();
+
+        std::vector<Future<void>> tasks;
+        for (size_t taskId = 0; taskId < nTasks; ++taskId) {
+            auto pf = makePromiseFuture<void>();
+            facetExecutor->schedule([this,
+                                     &facetIds = facetIdsByTask[taskId],
+                                     &taskContext = taskContexts[taskId],
+                                     &isEOF,
+                                     results,
+                                     promise = std::move(pf.promise)](auto status) mutable {
+                if (!status.isOK()) {
+                    promise.setError(status);
+                    return;
+                }
+
+                promise.setWith([&] {
+                    AlternativeClientRegion acr(taskContext.client);
+                    auto opCtx = taskContext.opCtx.get();
+                    for (auto facetId : facetIds) {
+                        if (isEOF[facetId]) {
+                            continue;
+                        }
+                        auto& pipeline = _facets[facetId].pipeline;
+                        pipeline->reattachToOperationContext(opCtx);
+                        ON_BLOCK_EXIT([&] { pipeline->detachFromOperationContext(); });
+                        isEOF[facetId] = runFacetUntilPaused(facetId, &(*results)[facetId]);
+                    }
+                });
+            });
+            tasks.push_back(std::move(pf.future));
+        }
+
+        // Run the remaining facets on this thread while the tasks proceed. The tasks refer to this
+        // stage, so they must finish before any error is rethrown.
+        Status status = Status::OK();
+        try {
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                if (!_facetStats[facetId].ranInParallel && !isEOF[facetId]) {
+                    isEOF[facetId] = runFacetUntilPaused(facetId, &(*results)[facetId]);
+                }
+            }
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+        for (auto&& task : tasks) {
+            auto taskStatus = task.getNoThrow();
+            if (status.isOK()) {
+                status = std::move(taskStatus);
+            }
+        }
+        for (auto facetId : parallelFacetIds) {
+            _facets[facetId].pipeline->reattachToOperationContext(pExpCtx->opCtx);
+        }
+        uassertStatusOK(status);
+
+        // The tasks run under their own OperationContexts, so check for interrupt between batches.
+        pExpCtx->opCtx->checkForInterrupt();
+
+        allPipelinesEOF = std::all_of(isEOF.begin(), isEOF.end(), [](char eof) { return eof; });
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     if (_done) {
         return GetNextResult::makeEOF();
     }
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                results[facetId].emplace_back(next.releaseDocument());
+    const auto parallelFacetIds = prepareParallelFacets();
+    if (!parallelFacetIds.empty()) {
+        runFacetsInParallel(parallelFacetIds, &results);
+    } else {
+        bool allPipelinesEOF = false;
+        while (!allPipelinesEOF) {
+            allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                const bool isEOF = runFacetUntilPaused(facetId, &results[facetId]);
+                allPipelinesEOF = allPipelinesEOF && isEOF;
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
         }
     }
 
@@ -172,6 +337,18 @@ Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity>
         serialized[facet.name] = Value(explain ? facet.pipeline->writeExplainOps(*explain)
                                                : facet.pipeline->serialize());
     }
+
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
+        MutableDocument facetStats;
+        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+            const auto& stats = _facetStats[facetId];
+            facetStats[_facets[facetId].name] = Value(
+                DOC("executionTimeMillisEstimate" << stats.executionTimeMicros / 1000
+                                                  << "ranInParallel" << stats.ranInParallel));
+        }
+        return Value(DOC("$facet" << serialized.freezeToValue() << "facetStats"
+                                  << facetStats.freezeToValue()));
+    }
     return Value(Document{{"$facet", serialized.freezeToValue()}});
 }
 
@@ -287,11 +464,16 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     boost::optional<std::string> needsMongoS;
     boost::optional<std::string> needsShard;
 
+    // The ExpressionContext is mutated while expressions are evaluated. When facets may run in
+    // parallel, each one is parsed with a private copy so that it can run alongside the others.
+    const bool mayRunInParallel = internalQueryFacetMaxParallelism.load() > 1;
+
     std::vector<FacetPipeline> facetPipelines;
     for (auto&& rawFacet : extractRawPipelines(elem)) {
         const auto facetName = rawFacet.first;
 
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
+        auto facetExpCtx = mayRunInParallel ? expCtx->copyWith(expCtx->ns, expCtx->uuid) : expCtx;
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
             auto sources = pipeline.getSources();
             std::for_each(sources.begin(), sources.end(), [](auto& stage) {
                 auto stageConstraints = stage->constraints();
@@ -95,6 +95,13 @@ public:
         std::vector<FacetPipeline> facetPipelines,
         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
+    /**
+     * Shuts down the threads on which facet pipelines run in parallel and waits for them to exit.
+     * Facets which have yet to run in parallel then fail with ShutdownInProgress. Must be called
+     * once at shutdown, after every operation has been killed.
+     */
+    static void shutdownExecutor();
+
     /**
      * Optimizes inner pipelines.
      */
@@ -153,9 +160,37 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Pulls results from the facet pipeline given by 'facetId' into 'results' until it pauses or
+     * is exhausted. Returns true if the pipeline is exhausted.
+     */
+    bool runFacetUntilPaused(size_t facetId, std::vector<Value>* results);
+
+    /**
+     * Returns the ids of the facets which may run on another thread, which are those parsed with an
+     * ExpressionContext of their own. Returns an empty vector if the facets should all run on this
+     * thread.
+     */
+    std::vector<size_t> prepareParallelFacets();
+
+    /**
+     * Runs every facet to completion, running those given by 'parallelFacetIds' on the $facet
+     * executor while the rest run on this thread. Each batch of input is loaded once every facet
+     * has consumed the previous one.
+     */
+    void runFacetsInParallel(const std::vector<size_t>& parallelFacetIds,
+                             std::vector<std::vector<Value>>* results);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
+    // Time spent running each facet pipeline, reported in explain with execution stats.
+    struct FacetExecStats {
+        long long executionTimeMicros = 0;
+        bool ranInParallel = false;
+    };
+    std::vector<FacetExecStats> _facetStats;
+
     bool _done = false;
 };
 }  // namespace mongo
@@ -44,8 +44,10 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -366,6 +368,50 @@ TEST_F(DocumentSourceFacetTest, MultipleFacetsShouldSeeTheSameDocuments) {
     ASSERT(facetStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceFacetTest, ParallelFacetsShouldProduceTheSameResultsAsSerialFacets) {
+    auto ctx = getExpCtx();
+
+    const auto originalParallelism = internalQueryFacetMaxParallelism.load();
+    const auto originalBufferSize = internalQueryFacetBufferSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryFacetMaxParallelism.store(originalParallelism);
+        internalQueryFacetBufferSizeBytes.store(originalBufferSize);
+    });
+    // Use a tiny buffer so that the input is split across many batches.
+    internalQueryFacetBufferSizeBytes.store(100);
+
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 50; ++i) {
+        inputs.emplace_back(Document{{"_id", i}, {"x", i % 7}});
+    }
+
+    auto spec = fromjson(
+        "{$facet: {"
+        "  counts: [{$group: {_id: '$x', count: {$sum: 1}}}, {$sort: {_id: 1}}],"
+        "  large: [{$match: {x: {$gte: 5}}}, {$project: {_id: 1, doubled: {$add: ['$x', '$x']}}}],"
+        "  firstThree: [{$limit: 3}]"
+        "}}");
+
+    auto runFacet = [&](int parallelism) {
+        internalQueryFacetMaxParallelism.store(parallelism);
+        auto mock = DocumentSourceMock::createForTest(inputs, ctx);
+        auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+        facetStage->setSource(mock.get());
+
+        auto output = facetStage->getNext();
+        ASSERT(output.isAdvanced());
+        ASSERT(facetStage->getNext().isEOF());
+        return output.releaseDocument();
+    };
+
+    auto serialOutput = runFacet(1);
+    auto parallelOutput = runFacet(2);
+    ASSERT_EQ(serialOutput["counts"].getArrayLength(), 7UL);
+    ASSERT_EQ(serialOutput["large"].getArrayLength(), 14UL);
+    ASSERT_EQ(serialOutput["firstThree"].getArrayLength(), 3UL);
+    ASSERT_DOCUMENT_EQ(parallelOutput, serialOutput);
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldAcceptEmptyPipelines) {
     auto ctx = getExpCtx();
     auto spec = BSON("$facet" << BSON("a" << BSONArray()));
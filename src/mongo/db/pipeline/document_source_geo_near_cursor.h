@@ -69,6 +69,14 @@ public:
 
     const char* getSourceName() const final;
 
+    /**
+     * The computed distance and matching point are added to each document by transformDoc(), so
+     * this stage only returns documents one at a time.
+     */
+    bool supportsColumnarBatches() const final {
+        return false;
+    }
+
 private:
     DocumentSourceGeoNearCursor(Collection*,
                                 std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>,
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -44,6 +45,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
@@ -57,6 +59,21 @@ void assertIsValidCollectionState(const boost::intrusive_ptr<ExpressionContext>&
         }
     }
 }
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number.
+ *
+ * Each user of the Sorter must implement this function to ensure that all temporary files that the
+ * Sorter instances produce are uniquely identified using a unique file name extension with separate
+ * atomic variable. This is necessary because the sorter.cpp code is separately included in multiple
+ * places, rather than compiled in one place and linked, and so cannot provide a globally unique ID.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookupFileCounter;
+    return "extsort-doc-graphlookup." +
+        std::to_string(documentSourceGraphLookupFileCounter.fetchAndAdd(1));
+}
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -112,19 +129,15 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasVisitedRemaining()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
     output.setNestedField(_as, Value(std::move(results)));
 
-    _visitedUsageBytes = 0;
-
-    invariant(_visited.empty());
+    resetVisited();
 
     return output.freeze();
 }
@@ -135,7 +148,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisitedRemaining()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -151,7 +164,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisitedRemaining()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -165,13 +178,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -181,7 +192,47 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
 void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
+    _spilledFrontier.clear();
+    _levelSpilledFrontier.clear();
+    _levelSpilledFrontierRunOpen = false;
+    resetVisited();
+}
+
+bool DocumentSourceGraphLookUp::usedDisk() {
+    return _usedDisk;
+}
+
+Document DocumentSourceGraphLookUp::popVisited() {
+    invariant(hasVisitedRemaining());
+    if (!_visited.empty()) {
+        auto it = _visited.begin();
+        Document result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+
+    auto& run = _spilledVisited.front();
+    if (!_spilledVisitedRunOpen) {
+        run->openSource();
+        _spilledVisitedRunOpen = true;
+    }
+
+    Document result = run->next().second.getDocument();
+    if (!run->more()) {
+        run->closeSource();
+        _spilledVisitedRunOpen = false;
+        _spilledVisited.pop_front();
+    }
+    return result;
+}
+
+void DocumentSourceGraphLookUp::resetVisited() {
     _visited.clear();
+    _visitedUsageBytes = 0;
+    _spilledVisited.clear();
+    _spilledVisitedRunOpen = false;
+    _spilledVisitedIds.clear();
+    _spilledVisitedIdsUsageBytes = 0;
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -191,49 +242,20 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
     do {
         shouldPerformAnotherQuery = false;
 
-        // Check whether each key in the frontier exists in the cache or needs to be queried.
-        auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
-
-        ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
-        _frontier.swap(queried);
+        // Take over the frontier for this level, including any part of it that was spilled to
+        // disk, leaving '_frontier' to be populated for the next iteration of search.
+        ValueUnorderedSet frontier = pExpCtx->getValueComparator().makeUnorderedValueSet();
+        _frontier.swap(frontier);
         _frontierUsageBytes = 0;
+        _levelSpilledFrontier = std::move(_spilledFrontier);
+        _spilledFrontier.clear();
 
-        // Process cached values, populating '_frontier' for the next iteration of search.
-        while (!cached.empty()) {
-            auto doc = *cached.begin();
-            cached.erase(cached.begin());
+        // A frontier which spilled is searched one batch at a time, so that neither it nor the
+        // query built from it has to be held in memory all at once.
+        do {
             shouldPerformAnotherQuery =
-                addToVisitedAndFrontier(std::move(doc), depth) || shouldPerformAnotherQuery;
-            checkMemoryUsage();
-        }
-
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
-            // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
-            MakePipelineOptions pipelineOpts;
-            pipelineOpts.optimize = true;
-            pipelineOpts.attachCursorSource = true;
-            // By default, $graphLookup doesn't support a sharded 'from' collection.
-            pipelineOpts.allowTargetingShards = internalQueryAllowShardedLookup.load();
-            _variables.copyToExpCtx(_variablesParseState, _fromExpCtx.get());
-            auto pipeline = Pipeline::makePipeline(_fromPipeline, _fromExpCtx, pipelineOpts);
-            while (auto next = pipeline->getNext()) {
-                uassert(40271,
-                        str::stream()
-                            << "Documents in the '" << _from.ns()
-                            << "' namespace must contain an _id for de-duplication in $graphLookup",
-                        !(*next)["_id"].missing());
-
-                shouldPerformAnotherQuery =
-                    addToVisitedAndFrontier(*next, depth) || shouldPerformAnotherQuery;
-                addToCache(std::move(*next), queried);
-            }
-            checkMemoryUsage();
-        }
+                searchFrontierBatch(&frontier, depth) || shouldPerformAnotherQuery;
+        } while (loadFrontierBatch(&frontier));
 
         ++depth;
     } while (shouldPerformAnotherQuery && depth < std::numeric_limits<long long>::max() &&
@@ -241,12 +263,99 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+    _spilledFrontier.clear();
+    _levelSpilledFrontier.clear();
+    _levelSpilledFrontierRunOpen = false;
+}
+
+bool DocumentSourceGraphLookUp::searchFrontierBatch(ValueUnorderedSet* frontier,
+                                                    long long depth) {
+    bool shouldPerformAnotherQuery = false;
+
+    // Check whether each key in the frontier exists in the cache or needs to be queried.
+    auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
+    auto matchStage = makeMatchStageFromFrontier(frontier, &cached);
+
+    ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
+    frontier->swap(queried);
+
+    // Process cached values, populating '_frontier' for the next iteration of search.
+    while (!cached.empty()) {
+        auto doc = *cached.begin();
+        cached.erase(cached.begin());
+        shouldPerformAnotherQuery =
+            addToVisitedAndFrontier(std::move(doc), depth) || shouldPerformAnotherQuery;
+        checkMemoryUsage();
+    }
+
+    if (matchStage) {
+        // Query for all keys that were in the frontier and not in the cache, populating
+        // '_frontier' for the next iteration of search.
+
+        // We've already allocated space for the trailing $match stage in '_fromPipeline'.
+        _fromPipeline.back() = *matchStage;
+        MakePipelineOptions pipelineOpts;
+        pipelineOpts.optimize = true;
+        pipelineOpts.attachCursorSource = true;
+        // By default, $graphLookup doesn't support a sharded 'from' collection.
+        pipelineOpts.allowTargetingShards = internalQueryAllowShardedLookup.load();
+        _variables.copyToExpCtx(_variablesParseState, _fromExpCtx.get());
+        auto pipeline = Pipeline::makePipeline(_fromPipeline, _fromExpCtx, pipelineOpts);
+        while (auto next = pipeline->getNext()) {
+            uassert(40271,
+                    str::stream()
+                        << "Documents in the '" << _from.ns()
+                        << "' namespace must contain an _id for de-duplication in $graphLookup",
+                    !(*next)["_id"].missing());
+
+            shouldPerformAnotherQuery =
+                addToVisitedAndFrontier(*next, depth) || shouldPerformAnotherQuery;
+            addToCache(std::move(*next), queried);
+            if (_allowDiskUse) {
+                // Check as we go so that a large result set spills rather than piling up.
+                checkMemoryUsage();
+            }
+        }
+        checkMemoryUsage();
+    }
+
+    return shouldPerformAnotherQuery;
+}
+
+bool DocumentSourceGraphLookUp::loadFrontierBatch(ValueUnorderedSet* frontier) {
+    invariant(frontier->empty());
+
+    size_t batchUsageBytes = 0;
+    while (!_levelSpilledFrontier.empty() && batchUsageBytes < _maxMemoryUsageBytes / 2) {
+        auto& run = _levelSpilledFrontier.front();
+        if (!_levelSpilledFrontierRunOpen) {
+            run->openSource();
+            _levelSpilledFrontierRunOpen = true;
+        }
+        while (run->more() && batchUsageBytes < _maxMemoryUsageBytes / 2) {
+            auto value = run->next().first;
+            batchUsageBytes += value.getApproximateSize();
+            frontier->insert(std::move(value));
+        }
+
+        if (run->more()) {
+            // The batch is full. The run stays open so that the next batch resumes reading it
+            // where this one stopped.
+            break;
+        }
+        run->closeSource();
+        _levelSpilledFrontierRunOpen = false;
+        _levelSpilledFrontier.pop_front();
+    }
+
+    return !frontier->empty();
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() ||
+        _spilledVisitedIds.find(id) != _spilledVisitedIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -280,32 +389,29 @@ bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long lo
 
 void DocumentSourceGraphLookUp::addToCache(const Document& result,
                                            const ValueUnorderedSet& queried) {
+    // Cached documents outlive the query which found them, so they must not keep the chunks of a
+    // document arena alive.
+    const Document cachedResult = result.copyOutOfArena();
     document_path_support::visitAllValuesAtPath(
-        result, _connectToField, [this, &queried, &result](const Value& connectToValue) {
+        result, _connectToField, [this, &queried, &cachedResult](const Value& connectToValue) {
             // It is possible that 'connectToValue' is a single value, but was not queried for. For
             // instance, with a connectToField of "a.b" and a document with the structure:
             // {a: [{b: 1}, {b: 0}]}, this document will be retrieved by querying for "{b: 1}", but
             // the outer for loop will split this into two separate connectToValues. {b: 0} was not
             // queried for, and thus, we cannot cache under it.
             if (queried.find(connectToValue) != queried.end()) {
-                _cache.insert(connectToValue, result);
+                _cache.insert(connectToValue.copyOutOfArena(), cachedResult);
             }
         });
 }
 
 boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
-    DocumentUnorderedSet* cached) {
-    // Add any cached values to 'cached' and remove them from '_frontier'.
-    for (auto it = _frontier.begin(); it != _frontier.end();) {
+    ValueUnorderedSet* frontier, DocumentUnorderedSet* cached) {
+    // Add any cached values to 'cached' and remove them from 'frontier'.
+    for (auto it = frontier->begin(); it != frontier->end();) {
         if (auto entry = _cache[*it]) {
             cached->insert(entry->begin(), entry->end());
-            size_t valueSize = it->getApproximateSize();
-            _frontier.erase(it++);
-
-            // If the cached value increased in size while in the cache, we don't want to underflow
-            // '_frontierUsageBytes'.
-            invariant(valueSize <= _frontierUsageBytes);
-            _frontierUsageBytes -= valueSize;
+            frontier->erase(it++);
         } else {
             ++it;
         }
@@ -330,7 +436,7 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
                     BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
                     {
                         BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
+                        for (auto&& value : *frontier) {
                             in << value;
                         }
                     }
@@ -339,12 +445,13 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return frontier->empty() ? boost::none : boost::optional<BSONObj>(match.obj());
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
+    resetVisited();
 
     Value startingValue = _startWith->evaluate(*_input, &pExpCtx->variables);
 
@@ -393,13 +500,60 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if (_allowDiskUse && (_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes) {
+        // The cache only holds copies of documents we can fetch again, so it is evicted first
+        // below. What remains of the traversal state moves to disk.
+        if (!_frontier.empty()) {
+            spillFrontier();
+        }
+        if (!_visited.empty()) {
+            spillVisited();
+        }
+    }
+
+    // With allowDiskUse this only fires once the '_id' values of the visited nodes alone fill the
+    // available memory.
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    _usedDisk = true;
+    SortedFileWriter<Value, Value> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
+
+    // Only the '_id' values stay behind, which is what lets a traversal much larger than memory
+    // still recognize the nodes it has already visited.
+    while (!_visited.empty()) {
+        // Remove elements one at a time to avoid consuming more memory.
+        auto it = _visited.begin();
+        writer.addAlreadySorted(it->first, Value(it->second));
+        _spilledVisitedIdsUsageBytes += it->first.getApproximateSize();
+        _spilledVisitedIds.insert(it->first);
+        _visited.erase(it);
+    }
+    _visitedUsageBytes = _spilledVisitedIdsUsageBytes;
+
+    _spilledVisited.emplace_back(writer.done());
+    _nextSortedFileWriterOffset = writer.getFileEndOffset();
+}
+
+void DocumentSourceGraphLookUp::spillFrontier() {
+    _usedDisk = true;
+    SortedFileWriter<Value, Value> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
+    for (auto&& value : _frontier) {
+        writer.addAlreadySorted(value, Value());
+    }
+    _frontier.clear();
+    _frontierUsageBytes = 0;
+
+    _spilledFrontier.emplace_back(writer.done());
+    _nextSortedFileWriterOffset = writer.getFileEndOffset();
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     // Serialize default options.
@@ -457,7 +611,8 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     boost::optional<BSONObj> additionalFilter,
     boost::optional<FieldPath> depthField,
     boost::optional<long long> maxDepth,
-    boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc)
+    boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc,
+    boost::optional<size_t> maxMemoryUsageBytes)
     : DocumentSource(kStageName, expCtx),
       _from(std::move(from)),
       _as(std::move(as)),
@@ -467,8 +622,13 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes
+                               ? *maxMemoryUsageBytes
+                               : internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
+      _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -481,6 +641,16 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline = resolvedNamespace.pipeline;
     _fromPipeline.reserve(_fromPipeline.size() + 1);
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
+
+    if (_allowDiskUse) {
+        _fileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+}
+
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    if (_usedDisk) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
+    }
 }
 
 intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
@@ -493,7 +663,8 @@ intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
     boost::optional<BSONObj> additionalFilter,
     boost::optional<FieldPath> depthField,
     boost::optional<long long> maxDepth,
-    boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc) {
+    boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc,
+    boost::optional<size_t> maxMemoryUsageBytes) {
     intrusive_ptr<DocumentSourceGraphLookUp> source(
         new DocumentSourceGraphLookUp(expCtx,
                                       std::move(fromNs),
@@ -504,7 +675,8 @@ intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
                                       additionalFilter,
                                       depthField,
                                       maxDepth,
-                                      unwindSrc));
+                                      unwindSrc,
+                                      maxMemoryUsageBytes));
     return source;
 }
 
@@ -602,6 +774,7 @@ intrusive_ptr<DocumentSource> DocumentSourceGraphLookUp::createFromBson(
                                       additionalFilter,
                                       depthField,
                                       maxDepth,
+                                      boost::none,
                                       boost::none));
 
     return std::move(newSource);
@@ -616,3 +789,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
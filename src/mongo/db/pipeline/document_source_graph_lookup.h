@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -95,7 +96,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -121,6 +122,13 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx) final;
 
+    bool usedDisk() final;
+
+    /**
+     * Convenience method for creating a new $graphLookup stage. If maxMemoryUsageBytes is
+     * boost::none, then it will actually use the value of
+     * internalDocumentSourceGraphLookupMaxMemoryBytes.
+     */
     static boost::intrusive_ptr<DocumentSourceGraphLookUp> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         NamespaceString fromNs,
@@ -131,7 +139,8 @@ public:
         boost::optional<BSONObj> additionalFilter,
         boost::optional<FieldPath> depthField,
         boost::optional<long long> maxDepth,
-        boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc);
+        boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc,
+        boost::optional<size_t> maxMemoryUsageBytes = boost::none);
 
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
@@ -157,7 +166,10 @@ private:
         boost::optional<BSONObj> additionalFilter,
         boost::optional<FieldPath> depthField,
         boost::optional<long long> maxDepth,
-        boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc);
+        boost::optional<boost::intrusive_ptr<DocumentSourceUnwind>> unwindSrc,
+        boost::optional<size_t> maxMemoryUsageBytes);
+
+    ~DocumentSourceGraphLookUp();
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final {
         // Should not be called; use serializeToArray instead.
@@ -166,14 +178,25 @@ private:
 
     /**
      * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * contents of 'frontier'.
      *
-     * Fills 'cached' with any values that were retrieved from the cache.
+     * Fills 'cached' with any values that were retrieved from the cache, removing them from
+     * 'frontier'.
      *
      * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
      * Otherwise, returns a query object.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    boost::optional<BSONObj> makeMatchStageFromFrontier(ValueUnorderedSet* frontier,
+                                                        DocumentUnorderedSet* cached);
+
+    /**
+     * Looks up the values in 'frontier', one batch of the frontier at 'depth', through the cache
+     * and the 'from' collection. Leaves 'frontier' empty and adds the values of the next level
+     * of the search to '_frontier'.
+     *
+     * Returns whether any new node was visited, and thus, whether the search should recurse.
+     */
+    bool searchFrontierBatch(ValueUnorderedSet* frontier, long long depth);
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -200,11 +223,50 @@ private:
     void addToCache(const Document& result, const ValueUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * If '_visited' and '_frontier' have exceeded the maximum memory usage, spill them to disk when
+     * allowed to. Assert that they are within the maximum memory usage, and then evict from
+     * '_cache' until this source is using less than '_maxMemoryUsageBytes'.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to a run on disk, keeping only their '_id' values in
+     * memory so that nodes which have already been visited are still recognized.
+     */
+    void spillVisited();
+
+    /**
+     * Writes the values in '_frontier' to a run on disk, to be searched in batches once the
+     * current level of the search is done.
+     */
+    void spillFrontier();
+
+    /**
+     * Refills 'frontier' from '_levelSpilledFrontier' until it holds up to half of
+     * '_maxMemoryUsageBytes' of values, consuming the runs as it goes. Returns false if there was
+     * nothing left to read.
+     */
+    bool loadFrontierBatch(ValueUnorderedSet* frontier);
+
+    /**
+     * Returns whether the last search left any discovered documents to be returned, either in
+     * '_visited' or on disk.
+     */
+    bool hasVisitedRemaining() const {
+        return !_visited.empty() || !_spilledVisited.empty();
+    }
+
+    /**
+     * Removes and returns one of the documents discovered by the last search, reading those
+     * spilled to disk once '_visited' is empty. Expects hasVisitedRemaining() to be true.
+     */
+    Document popVisited();
+
+    /**
+     * Clears the state of the last search, including anything it spilled to disk.
+     */
+    void resetVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -230,12 +292,18 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
     size_t _frontierUsageBytes = 0;
 
+    // Whether the traversal state may overflow to disk, and the file it is written to.
+    const bool _allowDiskUse;
+    bool _usedDisk = false;
+    std::string _fileName;
+    std::streampos _nextSortedFileWriterOffset = 0;
+
     // Only used during the breadth-first search, tracks the set of values on the current frontier.
     ValueUnorderedSet _frontier;
 
@@ -244,6 +312,24 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // Runs of frontier values that did not fit in '_frontier'. They belong to the same level of the
+    // search as '_frontier'.
+    std::deque<std::shared_ptr<Sorter<Value, Value>::Iterator>> _spilledFrontier;
+
+    // The spilled runs of the level currently being searched, read back one batch at a time. The
+    // first one is open while it is read.
+    std::deque<std::shared_ptr<Sorter<Value, Value>::Iterator>> _levelSpilledFrontier;
+    bool _levelSpilledFrontierRunOpen = false;
+
+    // Runs of documents moved out of '_visited' during the current search, keyed by '_id'. Every
+    // run in here still has documents left to read; the first one is open while it is read.
+    std::deque<std::shared_ptr<Sorter<Value, Value>::Iterator>> _spilledVisited;
+    bool _spilledVisitedRunOpen = false;
+
+    // The '_id' values of the documents in '_spilledVisited', compared using the simple collation.
+    ValueUnorderedSet _spilledVisitedIds;
+    size_t _spilledVisitedIdsUsageBytes = 0;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <set>
 
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
@@ -68,11 +70,17 @@ public:
             ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_results, pipeline->getContext()));
+        ++_numQueries;
         return pipeline;
     }
 
+    int getNumQueries() const {
+        return _numQueries;
+    }
+
 private:
     std::deque<DocumentSource::GetNextResult> _results;
+    int _numQueries = 0;
 };
 
 TEST_F(DocumentSourceGraphLookUpTest,
@@ -236,6 +244,196 @@ TEST_F(DocumentSourceGraphLookUpTest,
     }
 }
 
+/**
+ * Returns a chain of 'numNodes' documents, each padded so that a few of them exceed
+ * 'maxMemoryUsageBytes'.
+ */
+std::deque<DocumentSource::GetNextResult> makeLargeChain(int numNodes, size_t maxMemoryUsageBytes) {
+    std::string padding(maxMemoryUsageBytes / 4, 'x');
+    std::deque<DocumentSource::GetNextResult> nodes;
+    for (int i = 0; i < numNodes; ++i) {
+        nodes.emplace_back(Document{{"_id", i}, {"to", i}, {"from", i + 1}, {"padding", padding}});
+    }
+    return nodes;
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillTraversalStateToDiskWhenAllowed) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 10 * 1024;
+    const int numNodes = 50;
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(makeLargeChain(numNodes, maxMemoryUsageBytes));
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx.get(), "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          maxMemoryUsageBytes);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+
+    // Every node should be returned exactly once, whether it was kept in memory or read back from
+    // disk.
+    auto resultsValue = next.getDocument().getField("results");
+    ASSERT(resultsValue.isArray());
+    std::set<int> ids;
+    for (auto&& result : resultsValue.getArray()) {
+        ASSERT_TRUE(ids.insert(result.getDocument().getField("_id").coerceToInt()).second);
+    }
+    ASSERT_EQ(static_cast<size_t>(numNodes), ids.size());
+
+    ASSERT_TRUE(graphLookupStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillTraversalStateToDiskWhileUnwinding) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 10 * 1024;
+    const int numNodes = 50;
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(makeLargeChain(numNodes, maxMemoryUsageBytes));
+    auto unwindStage = DocumentSourceUnwind::create(expCtx, "results", false, boost::none);
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx.get(), "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          unwindStage,
+                                          maxMemoryUsageBytes);
+    graphLookupStage->setSource(inputMock.get());
+
+    std::set<int> ids;
+    for (auto next = graphLookupStage->getNext(); next.isAdvanced();
+         next = graphLookupStage->getNext()) {
+        auto result = next.getDocument().getField("results");
+        ASSERT_TRUE(ids.insert(result.getDocument().getField("_id").coerceToInt()).second);
+    }
+    ASSERT_EQ(static_cast<size_t>(numNodes), ids.size());
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillAFrontierLargerThanTheMemoryLimit) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 10 * 1024;
+    const int numLeaves = 20;
+
+    // The root connects to 'numLeaves' values which together are more than twice the memory
+    // limit, so the frontier of the second level can only be held on disk.
+    std::vector<Value> leafValues;
+    std::deque<DocumentSource::GetNextResult> fromContents;
+    for (int i = 1; i <= numLeaves; ++i) {
+        leafValues.emplace_back(std::string(maxMemoryUsageBytes / 8, 'a' + i));
+        fromContents.emplace_back(Document{{"_id", i}, {"to", leafValues.back()}});
+    }
+    fromContents.emplace_front(Document{{"_id", 0}, {"to", 0}, {"from", Value(leafValues)}});
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx.get(), "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          maxMemoryUsageBytes);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+
+    auto resultsValue = next.getDocument().getField("results");
+    ASSERT(resultsValue.isArray());
+    std::set<int> ids;
+    for (auto&& result : resultsValue.getArray()) {
+        ASSERT_TRUE(ids.insert(result.getDocument().getField("_id").coerceToInt()).second);
+    }
+    ASSERT_EQ(static_cast<size_t>(numLeaves + 1), ids.size());
+
+    // The spilled frontier is searched in batches of at most half the memory limit, each with its
+    // own query, after the query for the starting value.
+    ASSERT_GT(mongoInterface->getNumQueries(), 3);
+
+    ASSERT_TRUE(graphLookupStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldErrorWhenTraversalStateIsTooLargeWithoutDiskUse) {
+    auto expCtx = getExpCtx();
+    expCtx->allowDiskUse = false;
+    const size_t maxMemoryUsageBytes = 10 * 1024;
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(makeLargeChain(50, maxMemoryUsageBytes));
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "from",
+                                          "to",
+                                          ExpressionFieldPath::create(expCtx.get(), "_id"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          maxMemoryUsageBytes);
+    graphLookupStage->setSource(inputMock.get());
+
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), AssertionException, 40099);
+}
+
 TEST_F(DocumentSourceGraphLookUpTest, ShouldPropagatePauses) {
     auto expCtx = getExpCtx();
 
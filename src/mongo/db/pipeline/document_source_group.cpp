@@ -30,8 +30,10 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <algorithm>
 #include <memory>
 
+#include "mongo/db/exec/document_value/columnar_document_batch.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
@@ -61,11 +63,30 @@ std::string nextFileName() {
     return "extsort-doc-group." + std::to_string(documentSourceGroupFileCounter.fetchAndAdd(1));
 }
 
+// Bounds how many times a spilled partition that still does not fit in memory is split again. Each
+// level multiplies the fan-out by the number of partitions, so reaching this depth means the
+// remaining keys share a hash and splitting them further cannot help.
+constexpr int kMaxSpillDepth = 8;
+
+/**
+ * Maps the hash of a group key to one of 'numPartitions' spill partitions. The depth is mixed into
+ * the hash so that keys which shared a partition at one level are spread over all of the
+ * partitions at the next.
+ */
+size_t spillPartitionForHash(size_t keyHash, int depth, size_t numPartitions) {
+    uint64_t h = static_cast<uint64_t>(keyHash) + depth * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h % numPartitions;
+}
+
 }  // namespace
 
 using boost::intrusive_ptr;
 using std::pair;
-using std::shared_ptr;
 using std::vector;
 
 Document GroupFromFirstDocumentTransformation::applyTransformation(const Document& input) {
@@ -140,10 +161,6 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
         invariant(initializationResult.isEOF());
     }
 
-    for (auto&& accum : _currentAccumulators) {
-        accum->reset();  // Prep accumulators for a new group.
-    }
-
     if (_spilled) {
         return getNextSpilled();
     } else {
@@ -152,48 +169,19 @@ DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
-    // We aren't streaming, and we have spilled to disk.
-    if (!_sorterIterator)
-        return GetNextResult::makeEOF();
-
-    _currentId = _firstPartOfNextGroup.first;
-    const size_t numAccumulators = _accumulatedFields.size();
-
-    // Call startNewGroup on every accumulator.
-    Value expandedId = expandId(_currentId);
-    Document idDoc =
-        expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-    for (size_t i = 0; i < numAccumulators; ++i) {
-        Value initializerValue =
-            _accumulatedFields[i].expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-        _currentAccumulators[i]->startNewGroup(initializerValue);
-    }
-
-    while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
-        // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
-        // At loop exit, it is the first value to be processed in the next group.
-        switch (numAccumulators) {  // mirrors switch in spill()
-            case 1:                 // Single accumulators serialize as a single Value.
-                _currentAccumulators[0]->process(_firstPartOfNextGroup.second, true);
-            case 0:  // No accumulators so no Values.
-                break;
-            default: {  // Multiple accumulators serialize as an array of Values.
-                const vector<Value>& accumulatorStates = _firstPartOfNextGroup.second.getArray();
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators[i]->process(accumulatorStates[i], true);
-                }
-            }
-        }
-
-        if (!_sorterIterator->more()) {
+    // We aren't streaming, and we have spilled to disk. The groups are returned one partition at a
+    // time, re-aggregating the next pending partition once the current one is exhausted.
+    while (groupsIterator == _groups->end()) {
+        if (_pendingPartitions.empty()) {
             dispose();
-            break;
+            return GetNextResult::makeEOF();
         }
-
-        _firstPartOfNextGroup = _sorterIterator->next();
+        reaggregateNextPartition();
     }
 
-    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    ++groupsIterator;
+    return std::move(out);
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
@@ -212,7 +200,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-    _sorterIterator.reset();
+    _partitions.clear();
+    _pendingPartitions.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -344,6 +333,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _doingMerge(false),
       _maxMemoryUsageBytes(maxMemoryUsageBytes ? *maxMemoryUsageBytes
                                                : internalDocumentSourceGroupMaxMemoryBytes.load()),
+      _numSpillPartitions(internalDocumentSourceGroupSpillPartitions.load()),
       _initialized(false),
       _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
@@ -355,7 +345,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
 }
 
 DocumentSourceGroup::~DocumentSourceGroup() {
-    if (_ownsFileDeletion) {
+    if (!_fileName.empty()) {
         DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
     }
 }
@@ -447,106 +437,157 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
 
 namespace {
 
-using GroupsMap = DocumentSourceGroup::GroupsMap;
-
-class SorterComparator {
-public:
-    typedef pair<Value, Value> Data;
-
-    SorterComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
-
-    int operator()(const Data& lhs, const Data& rhs) const {
-        return _valueComparator.compare(lhs.first, rhs.first);
+/**
+ * An operand of a $group which is read from a column of a ColumnarDocumentBatch, or which is a
+ * constant when 'column' is not set.
+ */
+struct ColumnarOperand {
+    const Value& at(const ColumnarDocumentBatch& batch, size_t row) const {
+        return column ? batch.column(*column)[row] : constant;
     }
 
-private:
-    ValueComparator _valueComparator;
+    boost::optional<size_t> column;
+    Value constant;
 };
 
-class SpillSTLComparator {
-public:
-    SpillSTLComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
+/**
+ * Returns the columnar form of 'expr', adding the field it reads to 'fieldNames' if necessary, or
+ * boost::none if 'expr' is neither a constant nor a path to a top-level field of $$CURRENT.
+ */
+boost::optional<ColumnarOperand> makeColumnarOperand(const Expression* expr,
+                                                     std::vector<std::string>* fieldNames) {
+    if (auto constant = dynamic_cast<const ExpressionConstant*>(expr)) {
+        return ColumnarOperand{boost::none, constant->getValue()};
+    }
+
+    auto fieldPathExpr = dynamic_cast<const ExpressionFieldPath*>(expr);
+    if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath() ||
+        fieldPathExpr->getFieldPath().getPathLength() != 2) {
+        return boost::none;
+    }
 
-    bool operator()(const GroupsMap::value_type* lhs, const GroupsMap::value_type* rhs) const {
-        return _valueComparator.evaluate(lhs->first < rhs->first);
+    const auto fieldName = fieldPathExpr->getFieldPath().getFieldName(1);
+    auto it = std::find(fieldNames->begin(), fieldNames->end(), fieldName);
+    if (it == fieldNames->end()) {
+        it = fieldNames->insert(fieldNames->end(), fieldName.toString());
     }
+    return ColumnarOperand{static_cast<size_t>(it - fieldNames->begin()), Value()};
+}
 
-private:
-    ValueComparator _valueComparator;
-};
 }  // namespace
 
-DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
+template <typename ArgumentFn>
+void DocumentSourceGroup::accumulate(const Value& id, const ArgumentFn& argumentFor) {
     const size_t numAccumulators = _accumulatedFields.size();
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
-    for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
-            uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
-                    "Exceeded memory limit for $group, but didn't allow external sort."
-                    " Pass allowDiskUse:true to opt in.",
-                    _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
-        }
+    if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                "Exceeded memory limit for $group, but didn't allow external sort."
+                " Pass allowDiskUse:true to opt in.",
+                _allowDiskUse);
+        spill();
+    }
 
-        // We release the result document here so that it does not outlive the end of this loop
-        // iteration. Not releasing could lead to an array copy when this group follows an unwind.
-        auto rootDocument = input.releaseDocument();
-        Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Initialize and add the accumulators
-            Value expandedId = expandId(id);
-            Document idDoc =
-                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
-                Value initializerValue =
-                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
+    bool inserted;
+    Accumulators& group = findOrCreateGroup(id, &inserted);
+
+    if (inserted) {
+        _memoryUsageBytes += id.getApproximateSize();
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= groupObj->memUsageForSorter();
         }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        // Accumulators may keep their inputs, so those must not pin the chunks of the arena.
+        group[i]->process(
+            pExpCtx->documentArena ? argumentFor(i).copyOutOfArena() : argumentFor(i),
+            _doingMerge);
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+    }
 
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (!inserted &&                 // is a dup
+            !pExpCtx->inMongos &&        // can't spill to disk in mongos
+            !_allowDiskUse &&            // don't change behavior when testing external sort
+            _numSpills < 20) {           // don't write too many runs
 
-            _memoryUsageBytes += group[i]->memUsageForSorter();
+            spill();
         }
+    }
+}
 
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
+bool DocumentSourceGroup::accumulateColumnarInput() {
+    if (_doingMerge || !pSource->supportsColumnarBatches()) {
+        return false;
+    }
 
-                _sortedFiles.push_back(spill());
+    std::vector<std::string> fieldNames;
+    std::vector<ColumnarOperand> idOperands;
+    for (auto&& idExpr : _idExpressions) {
+        auto operand = makeColumnarOperand(idExpr.get(), &fieldNames);
+        if (!operand) {
+            return false;
+        }
+        idOperands.push_back(std::move(*operand));
+    }
+
+    std::vector<ColumnarOperand> argumentOperands;
+    for (auto&& accumulatedField : _accumulatedFields) {
+        auto operand = makeColumnarOperand(accumulatedField.expr.argument.get(), &fieldNames);
+        if (!operand) {
+            return false;
+        }
+        argumentOperands.push_back(std::move(*operand));
+    }
+
+    ColumnarDocumentBatch batch(std::move(fieldNames));
+    while (pSource->getNextColumnarBatch(&batch)) {
+        for (size_t row = 0; row < batch.size(); ++row) {
+            // Mirrors computeId().
+            Value id;
+            if (idOperands.size() == 1) {
+                id = idOperands[0].at(batch, row);
+                if (id.missing()) {
+                    id = Value(BSONNULL);
+                }
+            } else {
+                std::vector<Value> vals;
+                vals.reserve(idOperands.size());
+                for (auto&& operand : idOperands) {
+                    vals.push_back(operand.at(batch, row));
+                }
+                id = Value(std::move(vals));
             }
+
+            accumulate(id, [&](size_t i) -> const Value& {
+                return argumentOperands[i].at(batch, row);
+            });
         }
     }
+    return true;
+}
+
+DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. When the input
+    // can be read column-wise, it is consumed entirely by accumulateColumnarInput() instead.
+    GetNextResult input =
+        accumulateColumnarInput() ? GetNextResult::makeEOF() : pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        // We release the result document here so that it does not outlive the end of this loop
+        // iteration. Not releasing could lead to an array copy when this group follows an unwind.
+        auto rootDocument = input.releaseDocument();
+        accumulate(computeId(rootDocument), [&](size_t i) {
+            return _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables);
+        });
+    }
 
     switch (input.getStatus()) {
         case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
@@ -557,30 +598,17 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
+            if (!_partitions.empty()) {
                 _spilled = true;
                 if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
+                    spill();
                 }
+                queueSpilledPartitions();
 
-                // We won't be using groups again so free its memory.
+                // We won't be using the groups built so far again so free their memory. The
+                // partitions fill '_groups' back up one at a time as they are returned.
                 _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
-
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles,
-                    _fileName,
-                    SortOptions(),
-                    SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
-
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
-                }
-
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
+                groupsIterator = _groups->end();
             } else {
                 // start the group iterator
                 groupsIterator = _groups->begin();
@@ -599,48 +627,182 @@ bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
 
-shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
+DocumentSourceGroup::Accumulators& DocumentSourceGroup::findOrCreateGroup(const Value& id,
+                                                                       bool* inserted) {
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    Accumulators* groupPtr;
+    if (pExpCtx->documentArena && id.isInArena()) {
+        // The key of a new group outlives the input it was computed from, so it is stored on the
+        // heap rather than left to pin the chunks of the document arena.
+        auto it = _groups->find(id);
+        if (it == _groups->end()) {
+            it = _groups->emplace(id.copyOutOfArena(), Accumulators()).first;
+        }
+        groupPtr = &it->second;
+    } else {
+        groupPtr = &(*_groups)[id];
+    }
+    Accumulators& group = *groupPtr;
+    *inserted = _groups->size() != oldSize;
+
+    if (*inserted) {
+        // Initialize and add the accumulators
+        Value expandedId = expandId(id);
+        Document idDoc =
+            expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+        group.reserve(_accumulatedFields.size());
+        for (auto&& accumulatedField : _accumulatedFields) {
+            auto accum = accumulatedField.makeAccumulator();
+            Value initializerValue =
+                accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+            accum->startNewGroup(initializerValue);
+            group.push_back(accum);
+        }
+    }
+    return group;
+}
+
+void DocumentSourceGroup::spill() {
     _usedDisk = true;
-    vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
-    ptrs.reserve(_groups->size());
-    for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
-        ptrs.push_back(&*it);
+    ++_numSpills;
+
+    if (_partitions.empty()) {
+        _partitions.resize(_numSpillPartitions);
+        for (auto&& partition : _partitions) {
+            partition.depth = _spillDepth;
+        }
     }
 
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    // Bucket the groups by partition so that each partition's run is written out contiguously.
+    // Unlike a sorted spill, this needs only a hash of each key rather than O(n log n) comparisons.
+    const auto& valueComparator = pExpCtx->getValueComparator();
+    vector<vector<const GroupsMap::value_type*>> buckets(_partitions.size());
+    for (auto&& group : *_groups) {
+        auto partition =
+            spillPartitionForHash(valueComparator.hash(group.first), _spillDepth, buckets.size());
+        buckets[partition].push_back(&group);
+    }
+
+    for (size_t partition = 0; partition < buckets.size(); ++partition) {
+        if (buckets[partition].empty()) {
+            continue;
+        }
+
+        SortedFileWriter<Value, Value> writer(
+            SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
+        for (auto&& group : buckets[partition]) {
+            const Accumulators& accums = group->second;
+            switch (accums.size()) {
+                case 0:  // no values, essentially a distinct
+                    writer.addAlreadySorted(group->first, Value());
+                    break;
+
+                case 1:  // just one value, use optimized serialization as single Value
+                    writer.addAlreadySorted(group->first,
+                                            accums[0]->getValue(/*toBeMerged=*/true));
+                    break;
+
+                default: {  // multiple values, serialize as array-typed Value
+                    vector<Value> values;
+                    values.reserve(accums.size());
+                    for (auto&& accum : accums) {
+                        values.push_back(accum->getValue(/*toBeMerged=*/true));
+                    }
+                    writer.addAlreadySorted(group->first, Value(std::move(values)));
+                    break;
+                }
+            }
+        }
+
+        _partitions[partition].runs.emplace_back(writer.done());
+        _nextSortedFileWriterOffset = writer.getFileEndOffset();
+    }
+
+    _groups->clear();
+    _memoryUsageBytes = 0;
+}
+
+void DocumentSourceGroup::queueSpilledPartitions() {
+    for (auto&& partition : _partitions) {
+        if (!partition.runs.empty()) {
+            _pendingPartitions.push_back(std::move(partition));
+        }
+    }
+    _partitions.clear();
+}
+
+void DocumentSourceGroup::reaggregateNextPartition() {
+    invariant(_partitions.empty());
+    SpilledPartition partition = std::move(_pendingPartitions.back());
+    _pendingPartitions.pop_back();
 
-    SortedFileWriter<Value, Value> writer(
-        SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+    _groups->clear();
+    _memoryUsageBytes = 0;
+    _spillDepth = partition.depth + 1;
+
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    // The runs are read back in the order they were spilled, so that order-sensitive accumulators
+    // such as $first and $last combine their partial results in input order.
+    for (auto&& run : partition.runs) {
+        run->openSource();
+        while (run->more()) {
+            // A partition that still does not fit is split again rather than growing without
+            // bound, unless it has come down to a single group or to keys that keep colliding.
+            if (_memoryUsageBytes > _maxMemoryUsageBytes && _allowDiskUse &&
+                _groups->size() > 1 && _spillDepth <= kMaxSpillDepth) {
+                spill();
+            }
+
+            auto spilledGroup = run->next();
+            bool inserted;
+            Accumulators& group = findOrCreateGroup(spilledGroup.first, &inserted);
+
+            if (inserted) {
+                _memoryUsageBytes += spilledGroup.first.getApproximateSize();
+            } else {
+                for (auto&& groupObj : group) {
+                    _memoryUsageBytes -= groupObj->memUsageForSorter();
+                }
             }
-            break;
 
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+            if (pExpCtx->documentArena) {
+                spilledGroup.second = spilledGroup.second.copyOutOfArena();
             }
-            break;
 
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
+            switch (numAccumulators) {  // mirrors switch in spill()
+                case 1:                 // Single accumulators serialize as a single Value.
+                    group[0]->process(spilledGroup.second, true);
+                case 0:  // No accumulators so no Values.
+                    break;
+                default: {  // Multiple accumulators serialize as an array of Values.
+                    const vector<Value>& accumulatorStates = spilledGroup.second.getArray();
+                    for (size_t i = 0; i < numAccumulators; i++) {
+                        group[i]->process(accumulatorStates[i], true);
+                    }
                 }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
             }
-            break;
+
+            for (auto&& groupObj : group) {
+                _memoryUsageBytes += groupObj->memUsageForSorter();
+            }
+        }
+        run->closeSource();
     }
 
-    _groups->clear();
+    if (!_partitions.empty()) {
+        // The partition was split while re-aggregating it. Its groups will be returned once the new
+        // partitions are re-aggregated in turn.
+        if (!_groups->empty()) {
+            spill();
+        }
+        queueSpilledPartitions();
+    }
 
-    Sorter<Value, Value>::Iterator* iteratorPtr = writer.done();
-    _nextSortedFileWriterOffset = writer.getFileEndOffset();
-    return shared_ptr<Sorter<Value, Value>::Iterator>(iteratorPtr);
+    groupsIterator = _groups->begin();
 }
 
 Value DocumentSourceGroup::computeId(const Document& root) {
@@ -760,30 +922,39 @@ bool DocumentSourceGroup::canRunInParallelBeforeWriteStage(
     return true;
 }
 
-std::unique_ptr<GroupFromFirstDocumentTransformation>
-DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
+boost::optional<std::string> DocumentSourceGroup::getSingleFieldGroupId() const {
     if (!_idFieldNames.empty()) {
-        // This transformation is only intended for $group stages that group on a single field.
-        return nullptr;
+        return boost::none;
     }
 
     invariant(_idExpressions.size() == 1);
     auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
     if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath()) {
-        return nullptr;
+        return boost::none;
     }
 
     const auto fieldPath = fieldPathExpr->getFieldPath();
     if (fieldPath.getPathLength() == 1) {
         // The path is $$CURRENT or $$ROOT. This isn't really a sensible value to group by (since
         // each document has a unique _id, it will just return the entire collection). We only
-        // apply the rewrite when grouping by a single field, so we cannot apply it in this case,
-        // where we are grouping by the entire document.
+        // apply the rewrites when grouping by a single field, so we cannot apply them in this
+        // case, where we are grouping by the entire document.
         invariant(fieldPath.getFieldName(0) == "CURRENT" || fieldPath.getFieldName(0) == "ROOT");
+        return boost::none;
+    }
+
+    return fieldPath.tail().fullPath();
+}
+
+std::unique_ptr<GroupFromFirstDocumentTransformation>
+DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
+    // This transformation is only intended for $group stages that group on a single field.
+    auto singleFieldGroupId = getSingleFieldGroupId();
+    if (!singleFieldGroupId) {
         return nullptr;
     }
 
-    const auto groupId = fieldPath.tail().fullPath();
+    const auto groupId = *singleFieldGroupId;
 
     // We can't do this transformation if there are any non-$first accumulators.
     for (auto&& accumulator : _accumulatedFields) {
@@ -806,6 +977,26 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
     return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
 }
 
+boost::optional<DocumentSourceGroup::CountByField> DocumentSourceGroup::getCountByField() const {
+    auto groupId = getSingleFieldGroupId();
+    if (!groupId || _accumulatedFields.size() != 1) {
+        return boost::none;
+    }
+
+    // Only {$sum: 1} counts the documents with the same result type as a count of index keys.
+    const auto& accumulator = _accumulatedFields.front();
+    auto constant = dynamic_cast<ExpressionConstant*>(accumulator.expr.argument.get());
+    if (!constant || accumulator.makeAccumulator()->getOpName() != "$sum"_sd) {
+        return boost::none;
+    }
+    const auto value = constant->getValue();
+    if (value.getType() != NumberInt || value.getInt() != 1) {
+        return boost::none;
+    }
+
+    return CountByField{std::move(*groupId), accumulator.fieldName};
+}
+
 }  // namespace mongo
 
 #include "mongo/db/sorter/sorter.cpp"
@@ -177,6 +177,21 @@ public:
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument()
         const;
 
+    /**
+     * Describes a $group which counts the documents of each value of a single field.
+     */
+    struct CountByField {
+        std::string groupId;
+        std::string countFieldName;
+    };
+
+    /**
+     * If this stage groups on a single field and its only accumulator counts the documents in each
+     * group, as in {$group: {_id: "$a", n: {$sum: 1}}}, returns that field and the name of the
+     * count. The query system may then be able to count the keys of an index on the field instead.
+     */
+    boost::optional<CountByField> getCountByField() const;
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -188,9 +203,18 @@ private:
     ~DocumentSourceGroup();
 
     /**
-     * getNext() dispatches to one of these three depending on what type of $group it is. These
-     * methods expect '_currentAccumulators' to have been reset before being called, and also expect
-     * initialize() to have been called already.
+     * A partition of the spilled groups: every run holds partial aggregates whose keys hash to the
+     * same partition at 'depth', in the order they were spilled. 'depth' counts how many times the
+     * keys have been repartitioned because a partition did not fit in memory.
+     */
+    struct SpilledPartition {
+        std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> runs;
+        int depth = 0;
+    };
+
+    /**
+     * getNext() dispatches to one of these two depending on whether the $group has spilled. These
+     * methods expect initialize() to have been called already.
      */
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
@@ -208,11 +232,45 @@ private:
     GetNextResult initialize();
 
     /**
-     * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
+     * Looks up the group for 'id' in '_groups', adding it with freshly initialized accumulators if
+     * it is not present. Sets '*inserted' to whether the group was added.
+     */
+    Accumulators& findOrCreateGroup(const Value& id, bool* inserted);
+
+    /**
+     * Adds one input to the group for 'id', spilling first if the groups map has grown beyond the
+     * memory limit. 'argumentFor(i)' must return the argument for the 'i'th accumulator.
+     */
+    template <typename ArgumentFn>
+    void accumulate(const Value& id, const ArgumentFn& argumentFor);
+
+    /**
+     * If the previous stage can produce columnar batches and every _id expression and accumulator
+     * argument is either a constant or a top-level field of the input, exhausts the previous stage
+     * by reading its columns directly and returns true. Otherwise consumes nothing and returns
+     * false.
+     */
+    bool accumulateColumnarInput();
+
+    /**
+     * Hash-partitions the groups map to disk, appending one run to each partition in '_partitions'
+     * that received at least one group, and then clears the groups map. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
      * store of documents at any one time, only an unsorted group can spill to disk.
      */
-    std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
+    void spill();
+
+    /**
+     * Reads the runs of the next pending partition back into '_groups', combining the partial
+     * aggregates of each key. If the partition does not fit in memory it is repartitioned one level
+     * deeper, the new partitions are queued in '_pendingPartitions' and '_groups' is left empty.
+     */
+    void reaggregateNextPartition();
+
+    /**
+     * Queues every non-empty partition in '_partitions' for re-aggregation and clears it.
+     */
+    void queueSpilledPartitions();
 
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
@@ -227,6 +285,11 @@ private:
      */
     Value expandId(const Value& val);
 
+    /**
+     * Returns the path of the field this stage groups on, if it groups on a single field.
+     */
+    boost::optional<std::string> getSingleFieldGroupId() const;
+
     /**
      * Returns true if 'dottedPath' is one of the group keys present in '_idExpressions'.
      */
@@ -240,32 +303,34 @@ private:
     size_t _maxMemoryUsageBytes;
     std::string _fileName;
     std::streampos _nextSortedFileWriterOffset = 0;
-    bool _ownsFileDeletion = true;  // unless a MergeIterator is made that takes over.
+    const size_t _numSpillPartitions;
 
     std::vector<std::string> _idFieldNames;  // used when id is a document
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
 
     bool _initialized;
 
-    Value _currentId;
-    Accumulators _currentAccumulators;
-
     // We use boost::optional to defer initialization until the ExpressionContext containing the
     // correct comparator is injected, since the groups must be built using the comparator's
     // definition of equality.
     boost::optional<GroupsMap> _groups;
 
-    std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
+    size_t _numSpills = 0;
 
-    // Only used when '_spilled' is false.
+    // Iterates the groups to return: all of them if '_spilled' is false, otherwise those of the
+    // partition most recently re-aggregated.
     GroupsMap::iterator groupsIterator;
 
-    // Only used when '_spilled' is true.
-    std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
-    const bool _allowDiskUse;
+    // The partitions that spill() currently writes to, all at depth '_spillDepth'. Empty until the
+    // first spill at that depth.
+    std::vector<SpilledPartition> _partitions;
+    int _spillDepth = 0;
+
+    // Spilled partitions still waiting to be re-aggregated and returned.
+    std::vector<SpilledPartition> _pendingPartitions;
 
-    std::pair<Value, Value> _firstPartOfNextGroup;
+    const bool _allowDiskUse;
 };
 
 }  // namespace mongo
@@ -147,6 +147,52 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     ASSERT_EQ(idSet.count(2), 1UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldRepartitionSpilledGroupsThatDoNotFitInMemory) {
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    // With this little memory, each partition written by the first spills still holds too many
+    // groups to be re-aggregated at once, so it has to be split again.
+    const size_t maxMemoryUsageBytes = 1000;
+    const int numGroups = 500;
+    const int numPasses = 3;
+
+    auto&& parser = AccumulationStatement::getParser("$sum", boost::none);
+    auto accumulatorArg = BSON(""
+                               << "$x");
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement sumStatement{"total", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$_id", expCtx->variablesParseState);
+    auto group =
+        DocumentSourceGroup::create(expCtx, groupByExpression, {sumStatement}, maxMemoryUsageBytes);
+
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int pass = 0; pass < numPasses; ++pass) {
+        for (int id = 0; id < numGroups; ++id) {
+            inputs.emplace_back(Document{{"_id", id}, {"x", id}});
+        }
+    }
+    auto mock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+    group->setSource(mock.get());
+
+    // Every group should come back exactly once, with the partial sums of all spills combined.
+    stdx::unordered_set<int> idSet;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        const int id = doc["_id"].coerceToInt();
+        ASSERT_TRUE(idSet.insert(id).second);
+        ASSERT_EQ(doc["total"].coerceToInt(), id * numPasses);
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->usedDisk());
+    ASSERT_EQ(idSet.size(), static_cast<size_t>(numGroups));
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSetIsTooLarge) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
@@ -244,6 +290,29 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldReportCountBySingleField) {
+    auto spec = fromjson("{$group: {_id: '$a', n: {$sum: 1}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), getExpCtx());
+    auto countByField = static_cast<DocumentSourceGroup*>(group.get())->getCountByField();
+    ASSERT(countByField);
+    ASSERT_EQ(countByField->groupId, "a");
+    ASSERT_EQ(countByField->countFieldName, "n");
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotReportCountByFieldForOtherGroups) {
+    for (auto&& spec : {"{$group: {_id: '$a', n: {$sum: 2}}}",
+                        "{$group: {_id: '$a', n: {$sum: 1.0}}}",
+                        "{$group: {_id: '$a', n: {$sum: '$b'}}}",
+                        "{$group: {_id: '$a', n: {$max: 1}}}",
+                        "{$group: {_id: '$a', n: {$sum: 1}, m: {$sum: 1}}}",
+                        "{$group: {_id: {a: '$a', b: '$b'}, n: {$sum: 1}}}",
+                        "{$group: {_id: null, n: {$sum: 1}}}"}) {
+        auto specObj = fromjson(spec);
+        auto group = DocumentSourceGroup::createFromBson(specObj.firstElement(), getExpCtx());
+        ASSERT_FALSE(static_cast<DocumentSourceGroup*>(group.get())->getCountByField()) << spec;
+    }
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
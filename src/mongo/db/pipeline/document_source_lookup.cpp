@@ -31,13 +31,17 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <numeric>
 
 #include "mongo/base/init.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -57,7 +61,8 @@ DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
       _fromNs(std::move(fromNs)),
       _as(std::move(as)),
       _variables(expCtx->variables),
-      _variablesParseState(expCtx->variablesParseState.copyWith(_variables.useIdGenerator())) {
+      _variablesParseState(expCtx->variablesParseState.copyWith(_variables.useIdGenerator())),
+      _batchSize(internalDocumentSourceLookupBatchSize.load()) {
     const auto& resolvedNamespace = expCtx->getResolvedNamespace(_fromNs);
     _resolvedNs = resolvedNamespace.ns;
     _resolvedPipeline = resolvedNamespace.pipeline;
@@ -234,6 +239,73 @@ BSONObj buildEqualityOrQuery(const std::string& fieldName, const BSONArray& valu
     return orBuilder.obj();
 }
 
+/**
+ * Builds the $match stage which joins on 'localFieldList', the local values of one or more input
+ * documents. See makeMatchStageFromInput() for the shapes of the query.
+ */
+BSONObj makeMatchStageFromLocalValues(const BSONArray& localFieldList,
+                                      bool containsRegex,
+                                      const std::string& foreignFieldName,
+                                      const BSONObj& additionalFilter) {
+    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
+    // constructing a pipeline to execute.
+    BSONObjBuilder match;
+    BSONObjBuilder query(match.subobjStart("$match"));
+
+    BSONArrayBuilder andObj(query.subarrayStart("$and"));
+    BSONObjBuilder joiningObj(andObj.subobjStart());
+
+    if (localFieldList.nFields() > 1) {
+        // A $lookup on an array value corresponds to finding documents in the foreign collection
+        // that have a value of any of the elements in the array value, rather than finding
+        // documents that have a value equal to the entire array value. These semantics are
+        // automatically provided to us by using the $in query operator.
+        if (containsRegex) {
+            // A regular expression inside the $in query operator will perform pattern matching on
+            // any string values. Since we want regular expressions to only match other RegEx types,
+            // we write the query as a $or of equality comparisons instead.
+            BSONObj orQuery = buildEqualityOrQuery(foreignFieldName, localFieldList);
+            joiningObj.appendElements(orQuery);
+        } else {
+            // { <foreignFieldName> : { "$in" : <localFieldList> } }
+            BSONObjBuilder subObj(joiningObj.subobjStart(foreignFieldName));
+            subObj << "$in" << localFieldList;
+            subObj.doneFast();
+        }
+    } else {
+        // { <foreignFieldName> : { "$eq" : <localFieldList[0]> } }
+        BSONObjBuilder subObj(joiningObj.subobjStart(foreignFieldName));
+        subObj << "$eq" << localFieldList[0];
+        subObj.doneFast();
+    }
+
+    joiningObj.doneFast();
+
+    BSONObjBuilder additionalFilterObj(andObj.subobjStart());
+    additionalFilterObj.appendElements(additionalFilter);
+    additionalFilterObj.doneFast();
+
+    andObj.doneFast();
+
+    query.doneFast();
+    return match.obj();
+}
+
+/**
+ * Returns the values at 'localFieldPath' in 'input' which a $lookup joins on, treating a missing
+ * value as null.
+ */
+std::vector<Value> getLocalValues(const Document& input, const FieldPath& localFieldPath) {
+    std::vector<Value> localValues;
+    document_path_support::visitAllValuesAtPath(
+        input, localFieldPath, [&](const Value& nextValue) { localValues.push_back(nextValue); });
+    if (localValues.empty()) {
+        // Missing values are treated as null.
+        localValues.push_back(Value(BSONNULL));
+    }
+    return localValues;
+}
+
 void assertIsValidCollectionState(const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     if (expCtx->mongoProcessInterface->isSharded(expCtx->opCtx, expCtx->ns)) {
         const bool foreignShardedAllowed =
@@ -260,13 +332,24 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
+    if (!_checkedForeignIndexes) {
+        _checkedForeignIndexes = true;
+        enlargeBatchIfForeignFieldIsUnindexed();
+    }
+
+    if (canBatchLookups()) {
+        return getNextBatched();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
-    auto inputDoc = nextInput.releaseDocument();
+    return lookUpDocument(nextInput.releaseDocument());
+}
 
+Document DocumentSourceLookUp::lookUpDocument(Document inputDoc) {
     // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
@@ -303,6 +386,189 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     return output.freeze();
 }
 
+void DocumentSourceLookUp::enlargeBatchIfForeignFieldIsUnindexed() {
+    const auto unindexedBatchSize =
+        static_cast<size_t>(internalDocumentSourceLookupUnindexedBatchSize.load());
+    if (unindexedBatchSize <= _batchSize || wasConstructedWithPipelineSyntax() || _unwindSrc ||
+        pExpCtx->inMongos) {
+        return;
+    }
+
+    // A view's pipeline may rename or compute the foreign field, so the indexes of the underlying
+    // collection say nothing about how the join is answered.
+    if (_resolvedPipeline.size() > 1) {
+        return;
+    }
+
+    const auto foreignField = _foreignField->fullPath();
+    for (auto&& indexSpec : pExpCtx->mongoProcessInterface->getIndexSpecs(
+             pExpCtx->opCtx, _resolvedNs, false /* includeBuildUUIDs */)) {
+        if (indexSpec.getObjectField("key").firstElementFieldNameStringData() == foreignField) {
+            return;
+        }
+    }
+    _batchSize = unindexedBatchSize;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::getNextBatched() {
+    if (_batchOutput.empty()) {
+        if (_batchEndResult) {
+            // Everything buffered before the pause or EOF has been returned, so pass it on now.
+            auto batchEndResult = std::move(*_batchEndResult);
+            _batchEndResult.reset();
+            return batchEndResult;
+        }
+
+        std::vector<Document> batch;
+        while (batch.size() < _batchSize) {
+            auto nextInput = pSource->getNext();
+            if (!nextInput.isAdvanced()) {
+                if (batch.empty()) {
+                    return nextInput;
+                }
+                _batchEndResult = std::move(nextInput);
+                break;
+            }
+            batch.push_back(nextInput.releaseDocument());
+        }
+
+        lookUpBatch(std::move(batch));
+    }
+
+    auto output = std::move(_batchOutput.front());
+    _batchOutput.pop_front();
+    return std::move(output);
+}
+
+void DocumentSourceLookUp::lookUpBatch(std::vector<Document> batch) {
+    invariant(!_matchSrc);
+
+    if (batch.size() == 1) {
+        _batchOutput.push_back(lookUpDocument(std::move(batch.front())));
+        return;
+    }
+
+    // Halving the batch, rather than looking up each document on its own, isolates the few
+    // documents which match too much with a number of foreign queries logarithmic in the batch
+    // size. This matters when each query scans an unindexed foreign collection.
+    auto lookUpEachHalf = [&] {
+        const auto middle = batch.begin() + batch.size() / 2;
+        std::vector<Document> secondHalf(std::make_move_iterator(middle),
+                                         std::make_move_iterator(batch.end()));
+        batch.erase(middle, batch.end());
+        lookUpBatch(std::move(batch));
+        lookUpBatch(std::move(secondHalf));
+    };
+
+    // Gather the distinct local values of the whole batch, compared as the foreign query would.
+    const auto& valueComparator = _fromExpCtx->getValueComparator();
+    std::vector<std::vector<Value>> localValues;
+    localValues.reserve(batch.size());
+    auto distinctLocalValues = valueComparator.makeUnorderedValueSet();
+    BSONArrayBuilder localFieldList;
+    bool containsRegex = false;
+    for (auto&& inputDoc : batch) {
+        localValues.push_back(getLocalValues(inputDoc, *_localField));
+        for (auto&& localValue : localValues.back()) {
+            if (distinctLocalValues.insert(localValue).second) {
+                localFieldList << localValue;
+                containsRegex = containsRegex || localValue.getType() == BSONType::RegEx;
+            }
+        }
+
+        if (localFieldList.len() > BSONObjMaxUserSize / 2) {
+            // The query over the whole batch would be too large.
+            return lookUpEachHalf();
+        }
+    }
+
+    // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
+    _resolvedPipeline.back() = makeMatchStageFromLocalValues(
+        localFieldList.arr(), containsRegex, _foreignField->fullPath(), BSONObj());
+    auto pipeline = buildPipeline(batch.front());
+
+    // Index the results by each of their values at the foreign field, remembering the order in
+    // which they were returned.
+    std::vector<Document> results;
+    std::vector<BSONObj> resultObjs;
+    auto resultsByForeignValue = valueComparator.makeUnorderedValueMap<std::vector<size_t>>();
+    long long objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    while (auto result = pipeline->getNext()) {
+        long long safeSum = 0;
+        if (overflow::add(objsize, result->getApproximateSize(), &safeSum) || safeSum > maxBytes) {
+            // The batch matches more than a single lookup may. Each document might still be within
+            // the limit on its own, so join smaller batches.
+            _usedDisk = _usedDisk || pipeline->usedDisk();
+            pipeline.reset();
+            return lookUpEachHalf();
+        }
+        objsize = safeSum;
+
+        const size_t resultIndex = results.size();
+        document_path_support::visitAllValuesAtPath(
+            *result, *_foreignField, [&](const Value& foreignValue) {
+                resultsByForeignValue[foreignValue].push_back(resultIndex);
+            });
+        resultObjs.push_back(result->toBson());
+        results.push_back(std::move(*result));
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        // Collect the results which share a value with this document. Null and array local values
+        // can match results without an equal value at the foreign field (for instance, null
+        // matches a missing field), so those documents consider every result.
+        std::vector<size_t> candidates;
+        bool considerAllResults = false;
+        for (auto&& localValue : localValues[i]) {
+            if (localValue.nullish() || localValue.isArray()) {
+                considerAllResults = true;
+                break;
+            }
+            auto it = resultsByForeignValue.find(localValue);
+            if (it != resultsByForeignValue.end()) {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+        if (considerAllResults) {
+            candidates.resize(results.size());
+            std::iota(candidates.begin(), candidates.end(), 0);
+        } else {
+            // Keep the order in which the foreign query returned the results.
+            std::sort(candidates.begin(), candidates.end());
+            candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        }
+
+        // The candidates are confirmed against this document's own join predicate, so that it is
+        // joined with exactly the documents its own query would have returned.
+        std::vector<Value> joined;
+        if (!candidates.empty()) {
+            auto matchStage = makeMatchStageFromInput(
+                batch[i], *_localField, _foreignField->fullPath(), BSONObj());
+            auto expr = uassertStatusOK(
+                MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(),
+                                             _fromExpCtx));
+            long long joinedSize = 0;
+            for (auto&& candidate : candidates) {
+                if (expr->matchesBSON(resultObjs[candidate])) {
+                    joinedSize += results[candidate].getApproximateSize();
+                    uassert(5100013,
+                            str::stream() << "Total size of documents in " << _fromNs.coll()
+                                          << " matching pipeline's $lookup stage exceeds "
+                                          << maxBytes << " bytes",
+                            joinedSize <= maxBytes);
+                    joined.emplace_back(results[candidate]);
+                }
+            }
+        }
+
+        MutableDocument output(std::move(batch[i]));
+        output.setNestedField(_as, Value(std::move(joined)));
+        _batchOutput.push_back(output.freeze());
+    }
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -498,6 +764,7 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    _batchOutput.clear();
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
@@ -514,21 +781,13 @@ BSONObj DocumentSourceLookUp::makeMatchStageFromInput(const Document& input,
     // element to 'localFieldList'.
     BSONArrayBuilder arrBuilder;
     bool containsRegex = false;
-    document_path_support::visitAllValuesAtPath(input, localFieldPath, [&](const Value& nextValue) {
-        arrBuilder << nextValue;
-        if (!containsRegex && nextValue.getType() == BSONType::RegEx) {
+    for (auto&& localValue : getLocalValues(input, localFieldPath)) {
+        arrBuilder << localValue;
+        if (!containsRegex && localValue.getType() == BSONType::RegEx) {
             containsRegex = true;
         }
-    });
-
-    if (arrBuilder.arrSize() == 0) {
-        // Missing values are treated as null.
-        arrBuilder << BSONNULL;
     }
 
-    const auto localFieldListSize = arrBuilder.arrSize();
-    const auto localFieldList = arrBuilder.arr();
-
     // We construct a query of one of the following forms, depending on the contents of
     // 'localFieldList'.
     //
@@ -544,49 +803,8 @@ BSONObj DocumentSourceLookUp::makeMatchStageFromInput(const Document& input,
     //           <additionalFilter>]}
     //     if 'localFieldList' contains more than one element and it contains at least one element
     //     that is a regular expression.
-
-    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
-    // constructing a pipeline to execute.
-    BSONObjBuilder match;
-    BSONObjBuilder query(match.subobjStart("$match"));
-
-    BSONArrayBuilder andObj(query.subarrayStart("$and"));
-    BSONObjBuilder joiningObj(andObj.subobjStart());
-
-    if (localFieldListSize > 1) {
-        // A $lookup on an array value corresponds to finding documents in the foreign collection
-        // that have a value of any of the elements in the array value, rather than finding
-        // documents that have a value equal to the entire array value. These semantics are
-        // automatically provided to us by using the $in query operator.
-        if (containsRegex) {
-            // A regular expression inside the $in query operator will perform pattern matching on
-            // any string values. Since we want regular expressions to only match other RegEx types,
-            // we write the query as a $or of equality comparisons instead.
-            BSONObj orQuery = buildEqualityOrQuery(foreignFieldName, localFieldList);
-            joiningObj.appendElements(orQuery);
-        } else {
-            // { <foreignFieldName> : { "$in" : <localFieldList> } }
-            BSONObjBuilder subObj(joiningObj.subobjStart(foreignFieldName));
-            subObj << "$in" << localFieldList;
-            subObj.doneFast();
-        }
-    } else {
-        // { <foreignFieldName> : { "$eq" : <localFieldList[0]> } }
-        BSONObjBuilder subObj(joiningObj.subobjStart(foreignFieldName));
-        subObj << "$eq" << localFieldList[0];
-        subObj.doneFast();
-    }
-
-    joiningObj.doneFast();
-
-    BSONObjBuilder additionalFilterObj(andObj.subobjStart());
-    additionalFilterObj.appendElements(additionalFilter);
-    additionalFilterObj.doneFast();
-
-    andObj.doneFast();
-
-    query.doneFast();
-    return match.obj();
+    return makeMatchStageFromLocalValues(
+        arrBuilder.arr(), containsRegex, foreignFieldName, additionalFilter);
 }
 
 DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -242,6 +243,42 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if the lookups for consecutive input documents may be answered by a single
+     * query. This requires the localField/foreignField syntax and no absorbed $unwind.
+     */
+    bool canBatchLookups() const {
+        return _batchSize > 1 && !wasConstructedWithPipelineSyntax() && !_unwindSrc;
+    }
+
+    /**
+     * Raises '_batchSize' to 'internalDocumentSourceLookupUnindexedBatchSize' if no index of the
+     * foreign collection begins with the foreign field. Each batch then costs a scan of the
+     * foreign collection, filtered by membership in the batch's local values, so it pays to join
+     * as many input documents with each scan as possible.
+     */
+    void enlargeBatchIfForeignFieldIsUnindexed();
+
+    /**
+     * getNext() dispatches to this function when lookups are batched. Buffers up to '_batchSize'
+     * input documents, joins them all at once, and then returns them one per call.
+     */
+    GetNextResult getNextBatched();
+
+    /**
+     * Joins 'inputDoc' with the matching documents of the foreign collection by running the
+     * sub-pipeline for it alone.
+     */
+    Document lookUpDocument(Document inputDoc);
+
+    /**
+     * Joins every document in 'batch' with the matching documents of the foreign collection using
+     * a single query over the distinct local values of the batch, and appends the results to
+     * '_batchOutput' in input order. Splits the batch in two and joins each half on its own if the
+     * combined query or its result set would be too large.
+     */
+    void lookUpBatch(std::vector<Document> batch);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -317,6 +354,15 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // The following members are used to hold onto state across getNext() calls when lookups are
+    // batched: the joined documents not yet returned, and the non-advanced result which ended the
+    // last batch, to be returned once those documents have been. '_batchSize' may be raised once,
+    // on the first call, if the foreign field turns out to be unindexed.
+    size_t _batchSize;
+    bool _checkedForeignIndexes = false;
+    std::deque<Document> _batchOutput;
+    boost::optional<GetNextResult> _batchEndResult;
 };
 
 }  // namespace mongo
@@ -31,11 +31,13 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
+#include <list>
 #include <vector>
 
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
@@ -48,6 +50,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -493,10 +496,28 @@ public:
         return false;
     }
 
+    std::list<BSONObj> getIndexSpecs(OperationContext* opCtx,
+                                     const NamespaceString& ns,
+                                     bool includeBuildUUIDs) final {
+        return _indexSpecs;
+    }
+
+    void setIndexSpecs(std::list<BSONObj> indexSpecs) {
+        _indexSpecs = std::move(indexSpecs);
+    }
+
+    /**
+     * Returns the number of queries of the foreign collection.
+     */
+    int numQueries() const {
+        return _numQueries;
+    }
+
     std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipeline(
         Pipeline* ownedPipeline, bool allowTargetingShards = true) final {
         std::unique_ptr<Pipeline, PipelineDeleter> pipeline(
             ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
+        ++_numQueries;
 
         while (_removeLeadingQueryStages && !pipeline->getSources().empty()) {
             if (pipeline->popFrontWithName("$match") || pipeline->popFrontWithName("$sort") ||
@@ -514,6 +535,8 @@ public:
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    std::list<BSONObj> _indexSpecs;
+    int _numQueries = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -569,6 +592,139 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, BatchedLookupShouldJoinEachDocumentAsItsOwnQueryWould) {
+    const auto originalBatchSize = internalDocumentSourceLookupBatchSize.load();
+    internalDocumentSourceLookupBatchSize.store(4);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupBatchSize.store(originalBatchSize); });
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    // The documents are joined four at a time. The pause and the EOF each end a batch early.
+    const vector<Value> zeroAndTwo{Value(0), Value(2)};
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({Document{{"_id", "a"_sd}, {"key", 0}},
+                                           Document{{"_id", "b"_sd}, {"key", 1}},
+                                           Document{{"_id", "c"_sd}, {"key", zeroAndTwo}},
+                                           Document{{"_id", "d"_sd}, {"key", BSONNULL}},
+                                           Document{{"_id", "e"_sd}, {"key", 3}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"_id", "f"_sd}, {"key", 1}}},
+                                          expCtx);
+
+    Document foreign0{{"_id", 0}, {"key", 0}};
+    Document foreign1{{"_id", 1}, {"key", 1}};
+    Document foreign2{{"_id", 2}, {"key", vector<Value>{Value(1), Value(2)}}};
+    Document foreign3{{"_id", 3}};
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document(foreign0), Document(foreign1), Document(foreign2), Document(foreign3)};
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "key"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "joined"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+    lookup->setSource(mockLocalSource.get());
+
+    auto assertNextJoined = [&](StringData id, std::vector<Value> joined) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto doc = next.releaseDocument();
+        ASSERT_VALUE_EQ(doc["_id"], Value(id));
+        ASSERT_VALUE_EQ(doc["joined"], Value(std::move(joined)));
+    };
+
+    assertNextJoined("a"_sd, {Value(foreign0)});
+    assertNextJoined("b"_sd, {Value(foreign1), Value(foreign2)});
+    assertNextJoined("c"_sd, {Value(foreign0), Value(foreign2)});
+    // A null local value matches the document which is missing the foreign field.
+    assertNextJoined("d"_sd, {Value(foreign3)});
+    assertNextJoined("e"_sd, {});
+    ASSERT_TRUE(lookup->getNext().isPaused());
+    assertNextJoined("f"_sd, {Value(foreign1), Value(foreign2)});
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+/**
+ * Joins documents with the local values 0, 1, 2 and 0 to a foreign collection holding one document
+ * for each of 0, 1 and 2 on the field 'key', which has the indexes 'foreignIndexSpecs', and returns
+ * the number of queries of the foreign collection.
+ */
+int runLookupOnForeignKey(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                          std::list<BSONObj> foreignIndexSpecs) {
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({Document{{"key", 0}},
+                                                              Document{{"key", 1}},
+                                                              Document{{"key", 2}},
+                                                              Document{{"key", 0}}},
+                                                             expCtx);
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"_id", 0}, {"key", 0}},
+        Document{{"_id", 1}, {"key", 1}},
+        Document{{"_id", 2}, {"key", 2}}};
+    auto mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    mongoProcessInterface->setIndexSpecs(std::move(foreignIndexSpecs));
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "key"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "joined"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+    lookup->setSource(mockLocalSource.get());
+
+    for (auto key : {0, 1, 2, 0}) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(
+            next.releaseDocument(),
+            (Document{{"key", key},
+                      {"joined", vector<Value>{Value(Document{{"_id", key}, {"key", key}})}}}));
+    }
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+
+    return mongoProcessInterface->numQueries();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldJoinLargerBatchesWhenForeignFieldIsUnindexed) {
+    const auto originalBatchSize = internalDocumentSourceLookupUnindexedBatchSize.load();
+    internalDocumentSourceLookupUnindexedBatchSize.store(3);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupUnindexedBatchSize.store(originalBatchSize); });
+
+    // Only the _id index exists, so the four documents are joined three at a time.
+    ASSERT_EQ(
+        2, runLookupOnForeignKey(getExpCtx(), {fromjson("{v: 2, key: {_id: 1}, name: '_id_'}")}));
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotJoinLargerBatchesWhenForeignFieldIsIndexed) {
+    const auto originalBatchSize = internalDocumentSourceLookupUnindexedBatchSize.load();
+    internalDocumentSourceLookupUnindexedBatchSize.store(3);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceLookupUnindexedBatchSize.store(originalBatchSize); });
+
+    // An index answers the join for each document, so they are looked up one at a time.
+    ASSERT_EQ(4,
+              runLookupOnForeignKey(
+                  getExpCtx(), {fromjson("{v: 2, key: {key: 1, _id: 1}, name: 'key_1__id_1'}")}));
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_query_stats.h"
+
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_DOCUMENT_SOURCE(queryStats,
+                         DocumentSourceQueryStats::LiteParsed::parse,
+                         DocumentSourceQueryStats::createFromBson);
+
+intrusive_ptr<DocumentSource> DocumentSourceQueryStats::createFromBson(
+    BSONElement spec, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName
+                          << " value must be an object. Found: " << typeName(spec.type()),
+            spec.type() == BSONType::Object);
+
+    uassert(5100012,
+            str::stream() << kStageName << " is not supported on mongos",
+            !pExpCtx->inMongos);
+
+    const NamespaceString& nss = pExpCtx->ns;
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << kStageName
+                          << " must be run against the 'admin' database with {aggregate: 1}",
+            nss.db() == NamespaceString::kAdminDb && nss.isCollectionlessAggregateNS());
+
+    bool includeHistograms = false;
+    for (auto&& elem : spec.embeddedObject()) {
+        const auto fieldName = elem.fieldNameStringData();
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << "Unrecognized option '" << fieldName << "' in " << kStageName
+                              << " stage.",
+                fieldName == "histograms"_sd);
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << "The 'histograms' parameter of the " << kStageName
+                              << " stage must be a boolean value, but found: "
+                              << typeName(elem.type()),
+                elem.type() == BSONType::Bool);
+        includeHistograms = elem.boolean();
+    }
+
+    return new DocumentSourceQueryStats(pExpCtx, includeHistograms);
+}
+
+DocumentSourceQueryStats::DocumentSourceQueryStats(const intrusive_ptr<ExpressionContext>& pExpCtx,
+                                                   bool includeHistograms)
+    : DocumentSource(kStageName, pExpCtx), _includeHistograms(includeHistograms) {}
+
+DocumentSource::GetNextResult DocumentSourceQueryStats::doGetNext() {
+    if (!_haveRetrievedStats) {
+        _results = pExpCtx->mongoProcessInterface->getQueryShapeStats(pExpCtx->opCtx,
+                                                                      _includeHistograms);
+        _resultsIter = _results.cbegin();
+        _haveRetrievedStats = true;
+    }
+
+    if (_resultsIter == _results.cend()) {
+        return GetNextResult::makeEOF();
+    }
+    return Document{*_resultsIter++};
+}
+
+Value DocumentSourceQueryStats::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(
+        DOC(getSourceName() << (_includeHistograms ? DOC("histograms" << true) : Document())));
+}
+
+}  // namespace mongo
@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_query_stats.h"
+#include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Sets the ExpressionContext's namespace to 'admin' with {aggregate: 1}, as $queryStats requires.
+ */
+class DocumentSourceQueryStatsTest : public AggregationContextFixture {
+public:
+    DocumentSourceQueryStatsTest()
+        : AggregationContextFixture(NamespaceString::makeCollectionlessAggregateNSS("admin")) {}
+};
+
+/**
+ * A MongoProcessInterface used for testing which returns artificial query shape statistics.
+ */
+class QueryShapeStatsMongoProcessInterface final : public StubMongoProcessInterface {
+public:
+    QueryShapeStatsMongoProcessInterface(std::vector<BSONObj> shapes)
+        : _shapes(std::move(shapes)) {}
+
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx,
+                                            bool includeHistograms) const override {
+        std::vector<BSONObj> shapes;
+        for (auto&& shape : _shapes) {
+            shapes.push_back(includeHistograms ? shape : shape.removeField("histogram"));
+        }
+        return shapes;
+    }
+
+private:
+    std::vector<BSONObj> _shapes;
+};
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldRequireTheTopAction) {
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto liteParsed =
+        DocumentSourceQueryStats::LiteParsed::parse(getExpCtx()->ns, specObj.firstElement());
+    auto privileges = liteParsed->requiredPrivileges(false, false);
+    ASSERT_EQ(1U, privileges.size());
+    ASSERT_TRUE(privileges[0].getResourcePattern().isClusterResourcePattern());
+    ASSERT_TRUE(privileges[0].getActions().equals(ActionSet({ActionType::top})));
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfSpecIsNotObject) {
+    const auto specObj = fromjson("{$queryStats: 1}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseUnknownOptionsOrNonBooleanHistograms) {
+    for (auto&& spec : {"{$queryStats: {unknownOption: true}}", "{$queryStats: {histograms: 1}}"}) {
+        const auto specObj = fromjson(spec);
+        ASSERT_THROWS_CODE(
+            DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+            AssertionException,
+            ErrorCodes::FailedToParse);
+    }
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfNotRunOnAdminWithAggregateOne) {
+    const auto specObj = fromjson("{$queryStats: {}}");
+    getExpCtx()->ns = NamespaceString("admin.coll");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::InvalidNamespace);
+
+    getExpCtx()->ns = NamespaceString::makeCollectionlessAggregateNSS("test");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::InvalidNamespace);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, CanParseAndSerializeSuccessfully) {
+    for (auto&& spec : {"{$queryStats: {}}", "{$queryStats: {histograms: true}}"}) {
+        const auto specObj = fromjson(spec);
+        auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+        std::vector<Value> serialized;
+        stage->serializeToArray(serialized);
+        ASSERT_EQ(1u, serialized.size());
+        ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+    }
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ReturnsTheShapesOfTheProcessInterface) {
+    getExpCtx()->mongoProcessInterface =
+        std::make_shared<QueryShapeStatsMongoProcessInterface>(std::vector<BSONObj>{
+            fromjson("{queryHash: '00000001', histogram: [{micros: 2, count: 1}]}"),
+            fromjson("{queryHash: '00000002', histogram: [{micros: 4, count: 1}]}")});
+
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+
+    auto next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{queryHash: '00000001'}")));
+    next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{queryHash: '00000002'}")));
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -31,12 +31,15 @@
 
 #include "mongo/db/pipeline/document_source_sample.h"
 
+#include <cmath>
+
 #include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 using boost::intrusive_ptr;
@@ -59,6 +62,10 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
         PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
         auto nextInput = pSource->getNext();
         for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+            if (_reservoir) {
+                addToReservoir(nextInput.releaseDocument(), prng);
+                continue;
+            }
             MutableDocument doc(nextInput.releaseDocument());
             doc.metadata().setRandVal(prng.nextCanonicalDouble());
             _sortStage->loadDocument(doc.freeze());
@@ -71,6 +78,9 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
                 return nextInput;  // Propagate the pause.
             }
             case GetNextResult::ReturnStatus::kEOF: {
+                if (_reservoir) {
+                    loadReservoirIntoSort(prng);
+                }
                 _sortStage->loadingDone();
             }
         }
@@ -80,6 +90,45 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
     return _sortStage->getNext();
 }
 
+void DocumentSourceSample::addToReservoir(Document&& doc, PseudoRandom& prng) {
+    if (!_reservoir->wouldKeepNext()) {
+        _reservoir->skipNext();
+        return;
+    }
+
+    _reservoirMemoryUsageBytes += doc.getApproximateSize();
+    if (auto evicted = _reservoir->keepNext(std::move(doc), prng)) {
+        _reservoirMemoryUsageBytes -= evicted->getApproximateSize();
+    }
+
+    // Let the $sort stage enforce the memory limit from here on, spilling to disk if allowed.
+    if (_reservoirMemoryUsageBytes > _maxReservoirMemoryUsageBytes) {
+        loadReservoirIntoSort(prng);
+    }
+}
+
+void DocumentSourceSample::loadReservoirIntoSort(PseudoRandom& prng) {
+    // Had each of the 'n' documents seen so far been assigned a uniform random value, the sample
+    // would be the documents with the highest values. Those values are distributed as the top
+    // order statistics of 'n' uniform variables, which we can generate directly from the largest
+    // down: the largest is U^(1/n), and each following one is the previous one scaled by
+    // U^(1/(n-i)). The reservoir holds a uniform sample in a random order, so handing these values
+    // out in turn yields exactly the documents and values the $sort-based approach would produce.
+    const auto numSeen = _reservoir->numSeen();
+    auto sampled = _reservoir->release(prng);
+
+    double randVal = 1.0;
+    for (size_t i = 0; i < sampled.size(); ++i) {
+        randVal *= std::pow(1.0 - prng.nextCanonicalDouble(), 1.0 / (numSeen - i));
+        MutableDocument doc(std::move(sampled[i]));
+        doc.metadata().setRandVal(randVal);
+        _sortStage->loadDocument(doc.freeze());
+    }
+
+    _reservoir.reset();
+    _reservoirMemoryUsageBytes = 0;
+}
+
 Value DocumentSourceSample::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     return Value(DOC(kStageName << DOC("size" << _size)));
 }
@@ -111,6 +160,8 @@ intrusive_ptr<DocumentSource> DocumentSourceSample::createFromBson(
     uassert(28749, "$sample stage must specify a size", sizeSpecified);
 
     sample->_sortStage = DocumentSourceSort::create(expCtx, randSortSpec, sample->_size);
+    sample->_reservoir = std::make_unique<ReservoirSampler<Document>>(sample->_size);
+    sample->_maxReservoirMemoryUsageBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
 
     return sample;
 }
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/reservoir_sampler.h"
 
 namespace mongo {
 
@@ -72,9 +73,29 @@ private:
 
     GetNextResult doGetNext() final;
 
+    /**
+     * Offers 'doc' to the reservoir. If the reservoir grows beyond its memory limit, moves its
+     * contents into '_sortStage' and stops using the reservoir.
+     */
+    void addToReservoir(Document&& doc, PseudoRandom& prng);
+
+    /**
+     * Assigns each document in the reservoir the random value it would have among the highest
+     * random values had every document seen so far been given one, and loads them into
+     * '_sortStage'.
+     */
+    void loadReservoirIntoSort(PseudoRandom& prng);
+
     long long _size;
 
-    // Uses a $sort stage to randomly sort the documents.
+    // Holds a uniform sample of the input, so that documents which will not be returned are never
+    // assigned a random value or sorted. Reset once its contents have been moved to '_sortStage'.
+    std::unique_ptr<ReservoirSampler<Document>> _reservoir;
+    size_t _reservoirMemoryUsageBytes = 0;
+    size_t _maxReservoirMemoryUsageBytes = 0;
+
+    // Uses a $sort stage to order the sampled documents by their random values, and to sample any
+    // input which arrives after the reservoir exceeded its memory limit.
     boost::intrusive_ptr<DocumentSourceSort> _sortStage;
 };
 
@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
 #include <memory>
 
@@ -41,9 +42,12 @@
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/reservoir_sampler.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/tick_source_mock.h"
 
 namespace mongo {
@@ -188,6 +192,112 @@ TEST_F(SampleBasics, ShouldPropagatePauses) {
     assertEOF();
 }
 
+/**
+ * Once the sampled documents no longer fit within the blocking sort memory limit, the $sample stage
+ * should defer to its $sort stage, which fails the query if it may not spill to disk.
+ */
+TEST_F(SampleBasics, ShouldFailWhenSampleExceedsMemoryLimitWithoutDiskUse) {
+    auto originalMaxBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryMaxBlockingSortMemoryUsageBytes.store(originalMaxBytes); });
+    internalQueryMaxBlockingSortMemoryUsageBytes.store(1024);
+
+    getExpCtx()->allowDiskUse = false;
+    createSample(100);
+    const std::string largeString(200, 'x');
+    for (int i = 0; i < 100; i++) {
+        source()->push_back(DOC("_id" << i << "payload" << largeString));
+    }
+    ASSERT_THROWS_CODE(sample()->getNext(),
+                       AssertionException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+/**
+ * Every item of the stream should be equally likely to end up in the sample.
+ */
+TEST(ReservoirSamplerTest, SamplesEachItemWithEqualProbability) {
+    PseudoRandom prng(1);
+    const int kNumItems = 100;
+    const size_t kSampleSize = 10;
+    const int kNumTrials = 2000;
+
+    std::vector<int> timesSampled(kNumItems, 0);
+    for (int trial = 0; trial < kNumTrials; trial++) {
+        ReservoirSampler<int> sampler(kSampleSize);
+        for (int i = 0; i < kNumItems; i++) {
+            if (sampler.wouldKeepNext()) {
+                sampler.keepNext(i, prng);
+            } else {
+                sampler.skipNext();
+            }
+        }
+        ASSERT_EQ(sampler.numSeen(), static_cast<uint64_t>(kNumItems));
+        auto sampled = sampler.release(prng);
+        ASSERT_EQ(sampled.size(), kSampleSize);
+        for (auto item : sampled) {
+            timesSampled[item]++;
+        }
+    }
+
+    // Each item is expected to be sampled 200 times.
+    for (int i = 0; i < kNumItems; i++) {
+        ASSERT_GT(timesSampled[i], 130) << "item " << i;
+        ASSERT_LT(timesSampled[i], 270) << "item " << i;
+    }
+}
+
+/**
+ * Merging samples of two streams of different lengths should produce a uniform sample of both.
+ */
+TEST(ReservoirSamplerTest, MergedSamplesAreUniformOverBothStreams) {
+    PseudoRandom prng(2);
+    const int kNumItems = 100;
+    const int kFirstStreamLength = 20;
+    const size_t kSampleSize = 10;
+    const int kNumTrials = 2000;
+
+    auto sampleRange = [&](int begin, int end) {
+        ReservoirSampler<int> sampler(kSampleSize);
+        for (int i = begin; i < end; i++) {
+            if (sampler.wouldKeepNext()) {
+                sampler.keepNext(i, prng);
+            } else {
+                sampler.skipNext();
+            }
+        }
+        return sampler;
+    };
+
+    std::vector<int> timesSampled(kNumItems, 0);
+    for (int trial = 0; trial < kNumTrials; trial++) {
+        auto sampler = sampleRange(0, kFirstStreamLength);
+        sampler.merge(sampleRange(kFirstStreamLength, kNumItems), prng);
+        ASSERT_EQ(sampler.numSeen(), static_cast<uint64_t>(kNumItems));
+        auto sampled = sampler.release(prng);
+        ASSERT_EQ(sampled.size(), kSampleSize);
+        for (auto item : sampled) {
+            timesSampled[item]++;
+        }
+    }
+
+    for (int i = 0; i < kNumItems; i++) {
+        ASSERT_GT(timesSampled[i], 130) << "item " << i;
+        ASSERT_LT(timesSampled[i], 270) << "item " << i;
+    }
+}
+
+TEST(ReservoirSamplerTest, ShortStreamIsSampledEntirely) {
+    PseudoRandom prng(3);
+    ReservoirSampler<int> sampler(10);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(sampler.wouldKeepNext());
+        ASSERT_FALSE(sampler.keepNext(i, prng));
+    }
+    auto sampled = sampler.release(prng);
+    std::sort(sampled.begin(), sampled.end());
+    ASSERT(sampled == std::vector<int>({0, 1, 2, 3}));
+}
+
 /**
  * Fixture to test error cases of the $sample stage.
  */
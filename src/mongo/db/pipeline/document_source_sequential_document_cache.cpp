@@ -72,7 +72,9 @@ DocumentSource::GetNextResult DocumentSourceSequentialDocumentCache::doGetNext()
             _cache->freeze();
             _cacheIsEOF = true;
         } else {
-            _cache->add(nextResult.getDocument());
+            // The cache outlives the execution of the sub-pipeline, so it must not keep documents
+            // in the sub-pipeline's document arena.
+            _cache->add(nextResult.getDocument().copyOutOfArena());
         }
     }
 
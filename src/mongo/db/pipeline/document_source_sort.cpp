@@ -227,6 +227,12 @@ void DocumentSourceSort::loadDocument(Document&& doc) {
     // already computed the sort key we'd have split the pipeline there, would be merging presorted
     // documents, and wouldn't use this method.
     std::tie(sortKey, docForSorter) = extractSortKey(std::move(doc));
+    if (pExpCtx->documentArena) {
+        // Buffered documents must not pin the chunks of the document arena, which the sort's
+        // memory limit does not account for.
+        sortKey = sortKey.copyOutOfArena();
+        docForSorter = docForSorter.copyOutOfArena();
+    }
     _sortExecutor->add(sortKey, docForSorter);
 }
 
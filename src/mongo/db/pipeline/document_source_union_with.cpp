@@ -33,10 +33,13 @@
 #include <iterator>
 
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -164,12 +167,75 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceUnionWith::createFromBson(
             expCtx, expCtx->getResolvedNamespace(std::move(unionNss)), std::move(pipeline)));
 }
 
+void DocumentSourceUnionWith::attachCursorSourceToSubPipeline() {
+    auto serializedPipe = _pipeline->serializeToBson();
+    LOGV2_DEBUG(23869,
+                1,
+                "$unionWith attaching cursor to pipeline {pipeline}",
+                "pipeline"_attr = serializedPipe);
+    try {
+        _pipeline =
+            pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
+        _subPipelineAttached = true;
+    } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
+        _pipeline = buildPipelineFromViewDefinition(
+            pExpCtx,
+            ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
+            serializedPipe);
+        LOGV2_DEBUG(4556300,
+                    3,
+                    "$unionWith found view definition. ns: {ns}, pipeline: {pipeline}. New "
+                    "$unionWith sub-pipeline: {new_pipe}",
+                    "ns"_attr = e->getNamespace(),
+                    "pipeline"_attr = Value(e->getPipeline()),
+                    "new_pipe"_attr = _pipeline->serializeToBson());
+        attachCursorSourceToSubPipeline();
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     if (!_pipeline) {
         // We must have already been disposed, so we're finished.
         return GetNextResult::makeEOF();
     }
 
+    if (!_subPipelineAttached && _executionState == ExecutionProgress::kIteratingSource &&
+        internalQueryUnionWithEagerCursorEstablishment.load()) {
+        // Establish the sub-pipeline's cursors before iterating the input, and ask any remote
+        // cursors for their first batch without waiting for it. On a sharded cluster, the requests
+        // for both sides are then in flight at the same time rather than one after the other.
+        attachCursorSourceToSubPipeline();
+        _pipeline->getSources().front()->prefetchRemoteResults();
+        if (!_orderRequired) {
+            _executionState = ExecutionProgress::kInterleaving;
+        }
+    }
+
+    if (_executionState == ExecutionProgress::kInterleaving) {
+        _lastResultFromSubPipeline = !_lastResultFromSubPipeline;
+        if (_lastResultFromSubPipeline) {
+            if (auto res = _pipeline->getNext()) {
+                return std::move(*res);
+            }
+            _executionState = ExecutionProgress::kFinishingSource;
+        } else {
+            auto nextInput = pSource->getNext();
+            if (!nextInput.isEOF()) {
+                return nextInput;
+            }
+            // Only the sub-pipeline remains, so iterate it by falling through below.
+            _executionState = ExecutionProgress::kIteratingSubPipeline;
+        }
+    }
+
+    if (_executionState == ExecutionProgress::kFinishingSource) {
+        auto nextInput = pSource->getNext();
+        if (nextInput.isEOF()) {
+            _executionState = ExecutionProgress::kFinished;
+        }
+        return nextInput;
+    }
+
     if (_executionState == ExecutionProgress::kIteratingSource) {
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
@@ -181,29 +247,14 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
-        auto serializedPipe = _pipeline->serializeToBson();
-        LOGV2_DEBUG(23869,
-                    1,
-                    "$unionWith attaching cursor to pipeline {pipeline}",
-                    "pipeline"_attr = serializedPipe);
-        try {
-            _pipeline =
-                pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
-            _executionState = ExecutionProgress::kIteratingSubPipeline;
-        } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
-            _pipeline = buildPipelineFromViewDefinition(
-                pExpCtx,
-                ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
-                serializedPipe);
-            LOGV2_DEBUG(4556300,
-                        3,
-                        "$unionWith found view definition. ns: {ns}, pipeline: {pipeline}. New "
-                        "$unionWith sub-pipeline: {new_pipe}",
-                        "ns"_attr = e->getNamespace(),
-                        "pipeline"_attr = Value(e->getPipeline()),
-                        "new_pipe"_attr = _pipeline->serializeToBson());
-            return doGetNext();
+        if (!_subPipelineAttached) {
+            attachCursorSourceToSubPipeline();
         }
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
+    }
+
+    if (_executionState == ExecutionProgress::kFinished) {
+        return GetNextResult::makeEOF();
     }
 
     auto res = _pipeline->getNext();
@@ -229,6 +280,22 @@ Pipeline::SourceContainer::iterator DocumentSourceUnionWith::doOptimizeAt(
                      (*std::next(itr)).get()))
             return duplicateAcrossUnion(nextProject);
     }
+
+    // The results of the two sides may be interleaved if the next stage discards their order: a
+    // $sort, or a $group whose accumulators all give the same result in any order.
+    _orderRequired = true;
+    if (std::next(itr) != container->end()) {
+        auto nextStage = std::next(itr)->get();
+        if (dynamic_cast<DocumentSourceSort*>(nextStage)) {
+            _orderRequired = false;
+        } else if (auto nextGroup = dynamic_cast<DocumentSourceGroup*>(nextStage)) {
+            const auto& accumulatedFields = nextGroup->getAccumulatedFields();
+            _orderRequired =
+                !std::all_of(accumulatedFields.begin(),
+                             accumulatedFields.end(),
+                             [](auto&& field) { return field.makeAccumulator()->isCommutative(); });
+        }
+    }
     return std::next(itr);
 };
 
@@ -254,13 +321,12 @@ Value DocumentSourceUnionWith::serialize(boost::optional<ExplainOptions::Verbosi
 
         auto pipeCopy = Pipeline::create(_pipeline->getSources(), _pipeline->getContext());
 
-        // If we have already started getting documents from the sub-pipeline, this is an explain
-        // that has done some execution. We don't want to serialize the mergeCursors stage, and
-        // explain will attach a new cursor stage if we were reading local only. Therefore, remove
-        // the cursor stage of the pipeline. There is an implicit invariant that if we are in
-        // either of these states, the pipeline starts with one of the two cursor stages.
-        if (_executionState != ExecutionProgress::kStartingSubPipeline &&
-            _executionState != ExecutionProgress::kIteratingSource) {
+        // If we have already attached a cursor to the sub-pipeline, this is an explain that has
+        // done some execution. We don't want to serialize the mergeCursors stage, and explain will
+        // attach a new cursor stage if we were reading local only. Therefore, remove the cursor
+        // stage of the pipeline. With eager cursor establishment, the cursor may be attached while
+        // the input is still being iterated, so this cannot be told from '_executionState'.
+        if (_subPipelineAttached) {
             pipeCopy->popFront();
         }
         BSONObj explainObj = pExpCtx->mongoProcessInterface->attachCursorSourceAndExplain(
@@ -145,6 +145,11 @@ private:
         // We finished iterating 'pSource' and are now iterating '_pipeline', but haven't finished
         // yet.
         kIteratingSubPipeline,
+        // The order of the results doesn't matter, so we are alternating between 'pSource' and
+        // '_pipeline' until one of them is exhausted.
+        kInterleaving,
+        // '_pipeline' was exhausted while interleaving, so only 'pSource' remains.
+        kFinishingSource,
 
         // There are no more results.
         kFinished
@@ -154,9 +159,24 @@ private:
 
     void addViewDefinition(NamespaceString nss, std::vector<BSONObj> viewPipeline);
 
+    /**
+     * Attaches a cursor source to '_pipeline', resolving it against a view definition if needed.
+     */
+    void attachCursorSourceToSubPipeline();
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     bool _usedDisk = false;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+
+    // Whether a cursor source has been attached to '_pipeline' yet.
+    bool _subPipelineAttached = false;
+
+    // Set during optimization if the stage which follows discards the order of its input, in
+    // which case the two sides may be interleaved.
+    bool _orderRequired = true;
+
+    // Which side the last result was taken from while interleaving.
+    bool _lastResultFromSubPipeline = false;
 };
 
 }  // namespace mongo
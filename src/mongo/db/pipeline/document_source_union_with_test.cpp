@@ -42,20 +42,58 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_facet.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_replace_root.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
 
 using MockMongoInterface = StubLookupSingleDocumentProcessInterface;
 
+/**
+ * Like MockMongoInterface, but can also explain a sub-pipeline. As on mongod, attaching a cursor
+ * source to a pipeline which already has one is an error.
+ */
+class MockExplainMongoInterface final : public StubMongoProcessInterface {
+public:
+    MockExplainMongoInterface(std::deque<DocumentSource::GetNextResult> mockResults)
+        : _mockResults(std::move(mockResults)) {}
+
+    std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipeline(
+        Pipeline* ownedPipeline, bool allowTargetingShards = true) final {
+        return attachCursorSourceToPipelineForLocalRead(ownedPipeline);
+    }
+
+    std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipelineForLocalRead(
+        Pipeline* ownedPipeline) final {
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline(
+            ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
+        ASSERT(pipeline->getSources().empty() ||
+               !dynamic_cast<DocumentSourceMock*>(pipeline->peekFront()));
+        pipeline->addInitialSource(
+            DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        return pipeline;
+    }
+
+    BSONObj attachCursorSourceAndExplain(Pipeline* ownedPipeline,
+                                         ExplainOptions::Verbosity verbosity) final {
+        auto pipeline = attachCursorSourceToPipelineForLocalRead(ownedPipeline);
+        return BSON("pipeline" << Value(pipeline->writeExplainOps(verbosity)));
+    }
+
+private:
+    std::deque<DocumentSource::GetNextResult> _mockResults;
+};
+
 // This provides access to getExpCtx(), but we'll use a different name for this test suite.
 using DocumentSourceUnionWithTest = AggregationContextFixture;
 
@@ -325,6 +363,89 @@ TEST_F(DocumentSourceUnionWithTest, PropagatePauses) {
     ASSERT_TRUE(unionWithTwo.getNext().isEOF());
 }
 
+TEST_F(DocumentSourceUnionWithTest, ExecStatsExplainOfEagerUnionDoesNotAttachASecondCursor) {
+    const auto originalEager = internalQueryUnionWithEagerCursorEstablishment.load();
+    ON_BLOCK_EXIT([&] { internalQueryUnionWithEagerCursorEstablishment.store(originalEager); });
+    internalQueryUnionWithEagerCursorEstablishment.store(true);
+
+    const auto mockCtx = getExpCtx()->copyWith({});
+    mockCtx->mongoProcessInterface = std::make_unique<MockExplainMongoInterface>(
+        std::deque<DocumentSource::GetNextResult>{Document{{"inner", 0}}});
+    auto unionWith = make_intrusive<DocumentSourceUnionWith>(
+        mockCtx, Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{}, getExpCtx()));
+    auto mock = DocumentSourceMock::createForTest(
+        {Document{{"outer", 0}}, Document{{"outer", 1}}}, getExpCtx());
+    unionWith->setSource(mock.get());
+
+    // Stop after the first result. The cursor of the sub-pipeline has been attached, but the input
+    // is still being iterated.
+    ASSERT_TRUE(unionWith->getNext().isAdvanced());
+
+    std::vector<Value> explain;
+    unionWith->serializeToArray(explain, ExplainOptions::Verbosity::kExecStats);
+    ASSERT_EQ(1UL, explain.size());
+    ASSERT_EQ(1UL, explain[0]["$unionWith"]["pipeline"].getArrayLength());
+}
+
+TEST_F(DocumentSourceUnionWithTest, EagerUnionInterleavesOnlyWhenOrderIsNotRequired) {
+    const auto originalEager = internalQueryUnionWithEagerCursorEstablishment.load();
+    ON_BLOCK_EXIT([&] { internalQueryUnionWithEagerCursorEstablishment.store(originalEager); });
+    internalQueryUnionWithEagerCursorEstablishment.store(true);
+
+    const auto outerDocs = std::vector<Document>{
+        Document{{"outer", 0}}, Document{{"outer", 1}}, Document{{"outer", 2}}};
+    const auto innerDocs = std::vector<Document>{Document{{"inner", 0}}, Document{{"inner", 1}}};
+    const auto mockDeque =
+        std::deque<DocumentSource::GetNextResult>{Document{innerDocs[0]}, Document{innerDocs[1]}};
+
+    auto runUnion = [&](bool followWithGroup) {
+        const auto mockCtx = getExpCtx()->copyWith({});
+        mockCtx->mongoProcessInterface = std::make_unique<MockMongoInterface>(mockDeque);
+        auto unionWith = make_intrusive<DocumentSourceUnionWith>(
+            mockCtx,
+            Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{}, getExpCtx()));
+        std::list<boost::intrusive_ptr<DocumentSource>> stages{unionWith};
+        if (followWithGroup) {
+            stages.push_back(DocumentSourceGroup::createFromBson(
+                BSON("$group" << BSON("_id" << BSONNULL << "count" << BSON("$sum" << 1)))
+                    .firstElement(),
+                getExpCtx()));
+        }
+        auto pipeline = Pipeline::create(std::move(stages), getExpCtx());
+        pipeline->optimizePipeline();
+
+        auto mock = DocumentSourceMock::createForTest(
+            {Document{outerDocs[0]}, Document{outerDocs[1]}, Document{outerDocs[2]}}, getExpCtx());
+        unionWith->setSource(mock.get());
+
+        std::vector<Document> results;
+        for (auto next = unionWith->getNext(); next.isAdvanced(); next = unionWith->getNext()) {
+            results.push_back(next.releaseDocument());
+        }
+        ASSERT_TRUE(unionWith->getNext().isEOF());
+        return results;
+    };
+
+    // Without a following stage that discards the order, the input still comes first.
+    auto results = runUnion(false);
+    ASSERT_EQ(results.size(), 5UL);
+    for (size_t i = 0; i < outerDocs.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(results[i], outerDocs[i]);
+    }
+    for (size_t i = 0; i < innerDocs.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(results[outerDocs.size() + i], innerDocs[i]);
+    }
+
+    // A following $group with only commutative accumulators lets the two sides alternate.
+    results = runUnion(true);
+    ASSERT_EQ(results.size(), 5UL);
+    ASSERT_DOCUMENT_EQ(results[0], innerDocs[0]);
+    ASSERT_DOCUMENT_EQ(results[1], outerDocs[0]);
+    ASSERT_DOCUMENT_EQ(results[2], innerDocs[1]);
+    ASSERT_DOCUMENT_EQ(results[3], outerDocs[1]);
+    ASSERT_DOCUMENT_EQ(results[4], outerDocs[2]);
+}
+
 TEST_F(DocumentSourceUnionWithTest, ReturnEOFAfterBeingDisposed) {
     const auto mockInput = DocumentSourceMock::createForTest({Document(), Document()}, getExpCtx());
     const auto mockUnionInput = std::deque<DocumentSource::GetNextResult>{};
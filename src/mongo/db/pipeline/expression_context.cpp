@@ -125,6 +125,9 @@ ExpressionContext::ExpressionContext(
     if (!isMapReduce) {
         jsHeapLimitMB = internalQueryJavaScriptHeapSizeLimitMB.load();
     }
+    if (internalQueryEnableDocumentArena.load()) {
+        documentArena = std::make_unique<DocumentArena>();
+    }
     if (letParameters)
         variables.seedVariablesWithLetParameters(this, *letParameters);
 }
@@ -37,6 +37,7 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/document_arena.h"
 #include "mongo/db/exec/document_value/document_comparator.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/namespace_string.h"
@@ -332,6 +333,11 @@ public:
     // under any Scope returned by getJsExecWithScope().
     int jsFnTimeoutMillis;
 
+    // When set, Documents and arrays created while a pipeline using this context is being iterated
+    // are allocated from this arena rather than individually from the heap. See
+    // Pipeline::getNext().
+    std::unique_ptr<DocumentArena> documentArena;
+
     // An interface for accessing information or performing operations that have different
     // implementations on mongod and mongos, or that only make sense on one of the two.
     // Additionally, putting some of this functionality behind an interface prevents aggregation
@@ -451,6 +451,7 @@ void Pipeline::stitch() {
 
 boost::optional<Document> Pipeline::getNext() {
     invariant(!_sources.empty());
+    DocumentArena::Scope arenaScope(pCtx->documentArena.get());
     auto nextResult = _sources.back()->getNext();
     while (nextResult.isPaused()) {
         nextResult = _sources.back()->getNext();
@@ -59,6 +59,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
 #include "mongo/db/pipeline/document_source_geo_near_cursor.h"
 #include "mongo/db/pipeline/document_source_group.h"
@@ -71,6 +72,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -183,6 +185,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     BSONObj sortObj,
     boost::optional<long long> limit,
     boost::optional<std::string> groupIdForDistinctScan,
+    boost::optional<DocumentSourceGroup::CountByField> countByField,
     const AggregationRequest* aggRequest,
     const size_t plannerOpts,
     const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
@@ -250,6 +253,27 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         }
     }
 
+    if (countByField) {
+        // When the pipeline begins with a $group that counts the documents of each value of a
+        // single field, we use getExecutorGroupCount() to attempt to get an executor that counts
+        // the keys of an index on that field instead. When that's not possible, we return an
+        // error, and the caller is responsible for trying again without passing 'countByField'.
+        auto groupCountExecutor = getExecutorGroupCount(collection,
+                                                        plannerOpts,
+                                                        std::move(cq.getValue()),
+                                                        countByField->groupId,
+                                                        countByField->countFieldName);
+        if (!groupCountExecutor.isOK()) {
+            return groupCountExecutor.getStatus().withContext(
+                "Unable to use index keys to optimize $group stage");
+        } else if (!groupCountExecutor.getValue()) {
+            return {ErrorCodes::NoQueryExecutionPlans,
+                    "Unable to use index keys to optimize $group stage"};
+        } else {
+            return groupCountExecutor;
+        }
+    }
+
     bool permitYield = true;
     return getExecutorFind(
         expCtx->opCtx, collection, std::move(cq.getValue()), permitYield, plannerOpts);
@@ -515,8 +539,12 @@ PipelineD::buildInnerQueryExecutorGeneric(Collection* collection,
 
     auto&& [sortStage, groupStage] = getSortAndGroupStagesFromPipeline(pipeline->_sources);
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage;
+    boost::optional<DocumentSourceGroup::CountByField> countByField;
     if (groupStage) {
         rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
+        if (!sortStage && internalQueryEnableIndexGroupCount.load()) {
+            countByField = groupStage->getCountByField();
+        }
     }
 
     // If there is a $limit stage (or multiple $limit stages) that could be pushed down into the
@@ -548,6 +576,7 @@ PipelineD::buildInnerQueryExecutorGeneric(Collection* collection,
                                                 pipeline,
                                                 sortStage,
                                                 std::move(rewrittenGroupStage),
+                                                std::move(countByField),
                                                 unavailableMetadata,
                                                 queryObj,
                                                 limit,
@@ -607,7 +636,8 @@ PipelineD::buildInnerQueryExecutorGeoNear(Collection* collection,
                         nss,
                         pipeline,
                         nullptr, /* sortStage */
-                        nullptr, /* rewrittenGroupStage */
+                        nullptr,     /* rewrittenGroupStage */
+                        boost::none, /* countByField */
                         DepsTracker::kDefaultUnavailableMetadata & ~DepsTracker::kAllGeoNearData,
                         std::move(fullQuery),
                         boost::none, /* limit */
@@ -642,6 +672,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
     Pipeline* pipeline,
     const boost::intrusive_ptr<DocumentSourceSort>& sortStage,
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage,
+    boost::optional<DocumentSourceGroup::CountByField> countByField,
     QueryMetadataBitSet unavailableMetadata,
     const BSONObj& queryObj,
     boost::optional<long long> limit,
@@ -705,6 +736,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       sortObj,
                                                       boost::none, /* limit */
                                                       rewrittenGroupStage->groupId(),
+                                                      boost::none, /* countByField */
                                                       aggRequest,
                                                       plannerOpts,
                                                       matcherFeatures);
@@ -736,6 +768,33 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
+    if (countByField && !limit) {
+        // See if the query system can compute the $group stage by counting index keys. The
+        // executor produces the $group's output documents itself, so nothing else in the pipeline
+        // depends on the projection.
+        auto swExecutorGroupCount = attemptToGetExecutor(expCtx,
+                                                         collection,
+                                                         nss,
+                                                         queryObj,
+                                                         BSONObj(), /* projectionObj */
+                                                         QueryMetadataBitSet(),
+                                                         BSONObj(), /* sortObj */
+                                                         boost::none, /* limit */
+                                                         boost::none, /* groupIdForDistinctScan */
+                                                         std::move(countByField),
+                                                         aggRequest,
+                                                         plannerOpts,
+                                                         matcherFeatures);
+
+        if (swExecutorGroupCount.isOK()) {
+            pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+            return swExecutorGroupCount;
+        } else if (swExecutorGroupCount != ErrorCodes::NoQueryExecutionPlans) {
+            return swExecutorGroupCount.getStatus().withContext(
+                "Failed to determine whether query system can count index keys for $group");
+        }
+    }
+
     return attemptToGetExecutor(expCtx,
                                 collection,
                                 nss,
@@ -745,6 +804,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                 sortObj,
                                 limit,
                                 boost::none, /* groupIdForDistinctScan */
+                                boost::none, /* countByField */
                                 aggRequest,
                                 plannerOpts,
                                 matcherFeatures);
@@ -764,6 +824,12 @@ std::string PipelineD::getPlanSummaryStr(const Pipeline* pipeline) {
         return docSourceCursor->getPlanSummaryStr();
     }
 
+    // A parallelized $group reads from a $cursor stage which feeds the consumers of an Exchange.
+    if (auto gather =
+            dynamic_cast<DocumentSourceExchangeGather*>(pipeline->_sources.front().get())) {
+        return getPlanSummaryStr(gather->getInputPipeline());
+    }
+
     return "";
 }
 
@@ -773,6 +839,9 @@ void PipelineD::getPlanSummaryStats(const Pipeline* pipeline, PlanSummaryStats*
     if (auto docSourceCursor =
             dynamic_cast<DocumentSourceCursor*>(pipeline->_sources.front().get())) {
         *statsOut = docSourceCursor->getPlanSummaryStats();
+    } else if (auto gather = dynamic_cast<DocumentSourceExchangeGather*>(
+                   pipeline->_sources.front().get())) {
+        getPlanSummaryStats(gather->getInputPipeline(), statsOut);
     }
 
     for (auto&& source : pipeline->_sources) {
@@ -174,6 +174,9 @@ private:
      * compatible with a DISTINCT_SCAN plan that visits the first document in each group
      * (SERVER-9507).
      *
+     * Set 'countByField' when the pipeline begins with a $group that counts the documents of each
+     * value of a single field, so that the $group may be computed by counting index keys.
+     *
      * Sets the 'hasNoRequirements' out-parameter based on whether the dependency set is both finite
      * and empty. In this case, the query has count semantics.
      */
@@ -184,6 +187,7 @@ private:
         Pipeline* pipeline,
         const boost::intrusive_ptr<DocumentSourceSort>& sortStage,
         std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage,
+        boost::optional<DocumentSourceGroup::CountByField> countByField,
         QueryMetadataBitSet metadataAvailable,
         const BSONObj& queryObj,
         boost::optional<long long> limit,
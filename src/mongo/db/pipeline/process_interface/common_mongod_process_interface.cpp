@@ -62,6 +62,7 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/fill_locker_info.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/storage_stats.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
 #include "mongo/db/storage/durable_catalog.h"
@@ -210,6 +211,11 @@ void CommonMongodProcessInterface::appendLatencyStats(OperationContext* opCtx,
     Top::get(opCtx->getServiceContext()).appendLatencyStats(nss, includeHistograms, builder);
 }
 
+std::vector<BSONObj> CommonMongodProcessInterface::getQueryShapeStats(
+    OperationContext* opCtx, bool includeHistograms) const {
+    return QueryShapeStats::get(opCtx->getServiceContext()).getShapes(includeHistograms);
+}
+
 Status CommonMongodProcessInterface::appendStorageStats(OperationContext* opCtx,
                                                         const NamespaceString& nss,
                                                         const BSONObj& param,
@@ -401,9 +407,16 @@ BackupCursorExtendState CommonMongodProcessInterface::extendBackupCursor(
 
 std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCacheEntryStats(
     OperationContext* opCtx, const NamespaceString& nss, const MatchExpression* matchExp) const {
-    const auto serializer = [](const PlanCacheEntry& entry) {
+    const auto serializer = [](const PlanCacheEntry& entry,
+                               const PlanCache::ShardStats& shardStats) {
         BSONObjBuilder out;
         Explain::planCacheEntryToBSON(entry, &out);
+        BSONObjBuilder shardBob(out.subobjStart("cacheShard"));
+        shardBob.appendNumber("id", shardStats.shardId);
+        shardBob.appendNumber("hits", shardStats.hits);
+        shardBob.appendNumber("misses", shardStats.misses);
+        shardBob.appendNumber("numEntries", shardStats.numEntries);
+        shardBob.doneFast();
         return out.obj();
     };
 
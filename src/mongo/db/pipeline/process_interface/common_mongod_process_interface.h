@@ -65,6 +65,8 @@ public:
                             const NamespaceString& nss,
                             bool includeHistograms,
                             BSONObjBuilder* builder) const final;
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx,
+                                            bool includeHistograms) const final;
     Status appendStorageStats(OperationContext* opCtx,
                               const NamespaceString& nss,
                               const BSONObj& param,
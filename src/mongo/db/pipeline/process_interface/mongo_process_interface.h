@@ -194,6 +194,13 @@ public:
                                     bool includeHistograms,
                                     BSONObjBuilder* builder) const = 0;
 
+    /**
+     * Returns the statistics of each query shape recorded on this node, in decreasing order of
+     * total execution time. Each includes a latency histogram if 'includeHistograms' is true.
+     */
+    virtual std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx,
+                                                    bool includeHistograms) const = 0;
+
     /**
      * Appends storage statistics for collection "nss" to "builder"
      */
@@ -101,6 +101,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx,
+                                            bool includeHistograms) const final {
+        MONGO_UNREACHABLE;
+    }
+
     Status appendStorageStats(OperationContext* opCtx,
                               const NamespaceString& nss,
                               const BSONObj& param,
@@ -97,6 +97,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getQueryShapeStats(OperationContext* opCtx,
+                                            bool includeHistograms) const override {
+        MONGO_UNREACHABLE;
+    }
+
     Status appendStorageStats(OperationContext* opCtx,
                               const NamespaceString& nss,
                               const BSONObj& param,
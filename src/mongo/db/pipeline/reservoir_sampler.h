@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/platform/random.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * Maintains a uniform random sample of up to 'capacity' items from a stream of unknown length,
+ * using Algorithm L (Li, 1994). After the reservoir has filled, the sampler computes how many items
+ * to skip before the next one it keeps, so items which are not kept cost only a counter increment
+ * and no random numbers.
+ *
+ * Callers offer each item in turn by asking wouldKeepNext(), and then calling either keepNext() or
+ * skipNext(). This lets a caller avoid any work on items which will not be kept.
+ */
+template <typename T>
+class ReservoirSampler {
+public:
+    explicit ReservoirSampler(size_t capacity) : _capacity(capacity) {}
+
+    /**
+     * Returns true if the next item of the stream belongs in the sample.
+     */
+    bool wouldKeepNext() const {
+        return _capacity > 0 && (_numSeen < _capacity || _numSeen == _nextKept);
+    }
+
+    /**
+     * Accounts for the next item of the stream, which must not belong in the sample.
+     */
+    void skipNext() {
+        dassert(!wouldKeepNext());
+        ++_numSeen;
+    }
+
+    /**
+     * Adds the next item of the stream, which must belong in the sample, to the sample. Returns
+     * the item it replaces, if any.
+     */
+    boost::optional<T> keepNext(T item, PseudoRandom& prng) {
+        invariant(wouldKeepNext());
+        invariant(!_merged);
+
+        boost::optional<T> evicted;
+        if (_items.size() < _capacity) {
+            _items.push_back(std::move(item));
+        } else {
+            auto& slot = _items[prng.nextInt64(_items.size())];
+            evicted = std::exchange(slot, std::move(item));
+        }
+        ++_numSeen;
+
+        if (_numSeen == _capacity) {
+            _w = std::exp(std::log(nextOpenUnitDouble(prng)) / _capacity);
+            advanceNextKept(prng);
+        } else if (_numSeen > _capacity) {
+            _w *= std::exp(std::log(nextOpenUnitDouble(prng)) / _capacity);
+            advanceNextKept(prng);
+        }
+        return evicted;
+    }
+
+    /**
+     * Combines 'other', a sample of a disjoint stream with the same capacity, into this sample, so
+     * that this becomes a uniform sample of the union of both streams. This is how samples taken
+     * in parallel over partitions of the input are combined. No further items may be added after a
+     * merge.
+     */
+    void merge(ReservoirSampler&& other, PseudoRandom& prng) {
+        invariant(_capacity == other._capacity);
+        std::shuffle(_items.begin(), _items.end(), PrngUrbg{prng});
+        std::shuffle(other._items.begin(), other._items.end(), PrngUrbg{prng});
+
+        // Draw the combined sample without replacement from the union of both streams. Each draw
+        // comes from a stream with probability proportional to the number of its items not yet
+        // drawn. Both samples are uniform, so drawing from a stream takes the next of its items in
+        // a random order, and neither sample can be drawn from more times than it has items.
+        const size_t combinedSize = std::min<uint64_t>(_capacity, _numSeen + other._numSeen);
+        uint64_t thisRemaining = _numSeen;
+        uint64_t otherRemaining = other._numSeen;
+        std::vector<T> combined;
+        combined.reserve(combinedSize);
+        while (combined.size() < combinedSize) {
+            auto pick = static_cast<uint64_t>(prng.nextInt64(thisRemaining + otherRemaining));
+            auto& source = pick < thisRemaining ? _items : other._items;
+            (pick < thisRemaining ? thisRemaining : otherRemaining)--;
+            combined.push_back(std::move(source.back()));
+            source.pop_back();
+        }
+
+        _items = std::move(combined);
+        _numSeen += other._numSeen;
+        _merged = true;
+        other._items.clear();
+    }
+
+    /**
+     * Returns the sampled items in a random order, leaving the sample empty.
+     */
+    std::vector<T> release(PseudoRandom& prng) {
+        std::shuffle(_items.begin(), _items.end(), PrngUrbg{prng});
+        return std::move(_items);
+    }
+
+    /**
+     * The number of items offered to the sampler, whether or not they were kept.
+     */
+    uint64_t numSeen() const {
+        return _numSeen;
+    }
+
+    size_t size() const {
+        return _items.size();
+    }
+
+private:
+    /**
+     * Adapts a PseudoRandom to the UniformRandomBitGenerator requirements of std::shuffle.
+     */
+    struct PrngUrbg {
+        using result_type = uint64_t;
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+        result_type operator()() {
+            return static_cast<result_type>(prng.nextInt64());
+        }
+
+        PseudoRandom& prng;
+    };
+
+    // Returns a random double in (0, 1], so that its logarithm is finite.
+    static double nextOpenUnitDouble(PseudoRandom& prng) {
+        return 1.0 - prng.nextCanonicalDouble();
+    }
+
+    void advanceNextKept(PseudoRandom& prng) {
+        const double skip =
+            std::floor(std::log(nextOpenUnitDouble(prng)) / std::log1p(-_w));
+        const auto maxSkip = std::numeric_limits<uint64_t>::max() - _numSeen;
+        _nextKept = skip < static_cast<double>(maxSkip) ? _numSeen + static_cast<uint64_t>(skip)
+                                                        : std::numeric_limits<uint64_t>::max();
+    }
+
+    const size_t _capacity;
+    std::vector<T> _items;
+    uint64_t _numSeen = 0;
+
+    // The position in the stream of the next item to keep, once the reservoir is full.
+    uint64_t _nextKept = 0;
+
+    // The running threshold of Algorithm L.
+    double _w = 0;
+
+    bool _merged = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/spilled_accumulator_values.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/destructor_guard.h"
+
+namespace mongo {
+
+namespace {
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number.
+ *
+ * Each user of the Sorter must implement this function to ensure that all temporary files that the
+ * Sorter instances produce are uniquely identified using a unique file name extension with separate
+ * atomic variable. This is necessary because the sorter.cpp code is separately included in multiple
+ * places, rather than compiled in one place and linked, and so cannot provide a globally unique ID.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> accumulatorFileCounter;
+    return "extsort-accumulator." + std::to_string(accumulatorFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+SpilledAccumulatorValues::SpilledAccumulatorValues(ExpressionContext* expCtx)
+    : _expCtx(expCtx), _fileName(expCtx->tempDir + "/" + nextFileName()) {
+    invariant(canSpill(expCtx));
+}
+
+SpilledAccumulatorValues::~SpilledAccumulatorValues() {
+    clear();
+}
+
+bool SpilledAccumulatorValues::canSpill(const ExpressionContext* expCtx) {
+    return expCtx->allowDiskUse && !expCtx->inMongos && !expCtx->tempDir.empty();
+}
+
+void SpilledAccumulatorValues::spill(const std::vector<Value>& values) {
+    SortedFileWriter<Value, Value> writer(
+        SortOptions().TempDir(_expCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
+    for (auto&& value : values) {
+        writer.addAlreadySorted(value, Value());
+    }
+    _runs.emplace_back(writer.done());
+    _nextSortedFileWriterOffset = writer.getFileEndOffset();
+    _numValues += values.size();
+}
+
+void SpilledAccumulatorValues::clear() {
+    if (_runs.empty()) {
+        return;
+    }
+    _runs.clear();
+    _nextSortedFileWriterOffset = 0;
+    _numValues = 0;
+    DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
+}
+
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/sorter/sorter.h"
+
+namespace mongo {
+
+class ExpressionContext;
+
+/**
+ * Values which an accumulator has written to disk to stay within its memory limit. Each call to
+ * spill() appends one run to a temporary file, and forEach() reads the runs back in the order they
+ * were spilled. The file is removed when this object is cleared or destroyed.
+ */
+class SpilledAccumulatorValues {
+public:
+    SpilledAccumulatorValues(const SpilledAccumulatorValues&) = delete;
+    SpilledAccumulatorValues& operator=(const SpilledAccumulatorValues&) = delete;
+
+    explicit SpilledAccumulatorValues(ExpressionContext* expCtx);
+    ~SpilledAccumulatorValues();
+
+    /**
+     * Returns whether accumulators running under 'expCtx' may spill their state to disk.
+     */
+    static bool canSpill(const ExpressionContext* expCtx);
+
+    /**
+     * Writes 'values' to disk as a new run.
+     */
+    void spill(const std::vector<Value>& values);
+
+    /**
+     * Calls 'callback' with every spilled value, run by run in the order the runs were spilled.
+     */
+    template <typename Callback>
+    void forEach(Callback&& callback) const {
+        for (auto&& run : _runs) {
+            run->openSource();
+            while (run->more()) {
+                callback(run->next().first);
+            }
+            run->closeSource();
+        }
+    }
+
+    bool empty() const {
+        return _runs.empty();
+    }
+
+    size_t numValues() const {
+        return _numValues;
+    }
+
+    /**
+     * Discards every run and removes the file.
+     */
+    void clear();
+
+private:
+    ExpressionContext* const _expCtx;
+    const std::string _fileName;
+    std::streampos _nextSortedFileWriterOffset = 0;
+    std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _runs;
+    size_t _numValues = 0;
+};
+
+}  // namespace mongo
@@ -50,6 +50,10 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_sharedReads) {
+        return getNextShared(consumerId);
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -104,4 +108,60 @@ void TeeBuffer::loadNextBatch() {
     }
 }
 
+DocumentSource::GetNextResult TeeBuffer::getNextShared(size_t consumerId) {
+    // Only this consumer's own entry may be touched here, since other consumers may be running
+    // concurrently.
+    auto& consumer = _consumers[consumerId];
+    if (consumer.nLeftToReturn == 0) {
+        return _sharedInputExhausted ? DocumentSource::GetNextResult::makeEOF()
+                                     : DocumentSource::GetNextResult::makePauseExecution();
+    }
+
+    const auto& input = _sharedBuffer[_sharedBuffer.size() - consumer.nLeftToReturn];
+    --consumer.nLeftToReturn;
+
+    MutableDocument doc{Document(input.bson)};
+    doc.setMetadata(DocumentMetadataFields(input.metadata));
+    return doc.freeze();
+}
+
+bool TeeBuffer::loadNextSharedBatch() {
+    _sharedReads = true;
+    _buffer.clear();
+    _sharedBuffer.clear();
+
+    if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        })) {
+        if (_source && !_sharedInputExhausted) {
+            _source->dispose();
+        }
+        _sharedInputExhausted = true;
+        return false;
+    }
+
+    size_t bytesInBuffer = 0;
+    auto input = _source->getNext();
+    for (; input.isAdvanced(); input = _source->getNext()) {
+        const auto& doc = input.getDocument();
+        bytesInBuffer += doc.getApproximateSize();
+        _sharedBuffer.push_back({doc.toBson().getOwned(), doc.metadata()});
+
+        if (bytesInBuffer >= _bufferSizeBytes) {
+            break;  // Need to break here so we don't get the next input and accidentally ignore it.
+        }
+    }
+
+    // See loadNextBatch() for why the input can never be paused.
+    invariant(!input.isPaused());
+
+    _sharedInputExhausted = _sharedBuffer.empty();
+    for (auto&& consumer : _consumers) {
+        if (consumer.stillInUse) {
+            consumer.nLeftToReturn = _sharedBuffer.size();
+        }
+    }
+    return !_sharedInputExhausted;
+}
+
 }  // namespace mongo
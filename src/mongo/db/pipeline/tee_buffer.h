@@ -66,6 +66,11 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
+        if (_sharedReads) {
+            // Other consumers may be reading concurrently, so releasing the buffer and the source
+            // is left to the next call to loadNextSharedBatch().
+            return;
+        }
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
             })) {
@@ -83,6 +88,16 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * Switches this buffer to shared reads, in which consumers may call getNext() and dispose()
+     * concurrently with one another. In this mode the buffer is never refilled by a consumer;
+     * instead, the owner of the buffer calls this method to load each batch once every consumer
+     * has paused. Each consumer receives its own copy of every buffered document, so no two
+     * consumers touch the same Document. Returns false once the input is exhausted, after which
+     * every consumer receives EOF.
+     */
+    bool loadNextSharedBatch();
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
@@ -93,11 +108,23 @@ private:
      */
     void loadNextBatch();
 
+    DocumentSource::GetNextResult getNextShared(size_t consumerId);
+
     DocumentSource* _source = nullptr;
 
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
 
+    // The buffered input while in shared read mode. Documents are kept as owned BSON plus their
+    // metadata, from which each consumer materializes a private Document.
+    struct SharedInput {
+        BSONObj bson;
+        DocumentMetadataFields metadata;
+    };
+    std::vector<SharedInput> _sharedBuffer;
+    bool _sharedReads = false;
+    bool _sharedInputExhausted = false;
+
     struct ConsumerInfo {
         bool stillInUse = true;
         int nLeftToReturn = 0;
@@ -47,6 +47,7 @@
 #include "mongo/db/exec/ensure_sorted.h"
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/geo_near.h"
+#include "mongo/db/exec/group_count_scan.h"
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/limit.h"
 #include "mongo/db/exec/merge_sort.h"
@@ -343,6 +344,26 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.endKeyInclusive = csn->endKeyInclusive;
             return std::make_unique<CountScan>(expCtx, _collection, std::move(params), _ws);
         }
+        case STAGE_GROUP_COUNT_SCAN: {
+            const GroupCountScanNode* gcsn = static_cast<const GroupCountScanNode*>(root);
+
+            invariant(_collection);
+            auto descriptor = _collection->getIndexCatalog()->findIndexByName(
+                _opCtx, gcsn->index.identifier.catalogName);
+            invariant(descriptor);
+
+            GroupCountScanParams params{descriptor,
+                                        gcsn->index.identifier.catalogName,
+                                        gcsn->index.keyPattern,
+                                        gcsn->countFieldName};
+
+            params.startKey = gcsn->startKey;
+            params.startKeyInclusive = gcsn->startKeyInclusive;
+            params.endKey = gcsn->endKey;
+            params.endKeyInclusive = gcsn->endKeyInclusive;
+            return std::make_unique<GroupCountScan>(
+                expCtx, _collection, std::move(params), _ws);
+        }
         case STAGE_ENSURE_SORTED: {
             const EnsureSortedNode* esn = static_cast<const EnsureSortedNode*>(root);
             auto childStage = build(esn->children[0]);
@@ -36,6 +36,7 @@
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
+#include "mongo/db/exec/group_count_scan.h"
 #include "mongo/db/exec/idhack.h"
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/multi_plan.h"
@@ -162,6 +163,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_DISTINCT_SCAN == type) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_GROUP_COUNT_SCAN == type) {
+        const GroupCountScanStats* spec = static_cast<const GroupCountScanStats*>(specific);
+        return spec->keysExamined;
     }
 
     return 0;
@@ -220,6 +224,10 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
         const NearStats* spec = static_cast<const NearStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
+    } else if (STAGE_GROUP_COUNT_SCAN == stage->stageType()) {
+        const GroupCountScanStats* spec = static_cast<const GroupCountScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
     } else if (STAGE_IXSCAN == stage->stageType()) {
         const IndexScanStats* spec = static_cast<const IndexScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
@@ -478,6 +486,23 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             }
             intervalsBob.doneFast();
         }
+    } else if (STAGE_GROUP_COUNT_SCAN == stats.stageType) {
+        GroupCountScanStats* spec = static_cast<GroupCountScanStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", spec->keysExamined);
+            bob->appendNumber("groupsReturned", spec->groupsReturned);
+        }
+
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+
+        BSONObjBuilder indexBoundsBob;
+        indexBoundsBob.append("startKey", spec->startKey);
+        indexBoundsBob.append("startKeyInclusive", spec->startKeyInclusive);
+        indexBoundsBob.append("endKey", spec->endKey);
+        indexBoundsBob.append("endKeyInclusive", spec->endKeyInclusive);
+        bob->append("indexBounds", indexBoundsBob.obj());
     } else if (STAGE_IDHACK == stats.stageType) {
         IDHackStats* spec = static_cast<IDHackStats*>(stats.specific.get());
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
@@ -1038,6 +1063,11 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const DistinctScanStats* distinctScanStats =
                 static_cast<const DistinctScanStats*>(distinctScan->getSpecificStats());
             statsOut->indexesUsed.insert(distinctScanStats->indexName);
+        } else if (STAGE_GROUP_COUNT_SCAN == stages[i]->stageType()) {
+            const GroupCountScan* groupCountScan = static_cast<const GroupCountScan*>(stages[i]);
+            const GroupCountScanStats* groupCountScanStats =
+                static_cast<const GroupCountScanStats*>(groupCountScan->getSpecificStats());
+            statsOut->indexesUsed.insert(groupCountScanStats->indexName);
         } else if (STAGE_TEXT == stages[i]->stageType()) {
             const TextStage* textStage = static_cast<const TextStage*>(stages[i]);
             const TextStats* textStats =
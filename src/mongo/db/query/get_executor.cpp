@@ -33,12 +33,14 @@
 
 #include "mongo/db/query/get_executor.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <limits>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
@@ -69,8 +71,10 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/index_statistics_store.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cost_model.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -85,6 +89,7 @@
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
 #include "mongo/db/query/sbe_sub_planner.h"
+#include "mongo/db/query/shared_plan_cache.h"
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/repl/optime.h"
@@ -322,6 +327,24 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
 
+    // Only the 'analyze' statistics tell how many distinct values the leading field of an index
+    // has, so an index which has not been analyzed is never skip scanned.
+    if (internalQueryPlannerEnableSkipScan.load()) {
+        if (auto stats = index_statistics_store::get(opCtx, collection)) {
+            const auto maxPrefixCardinality =
+                internalQueryPlannerSkipScanMaxPrefixCardinality.load();
+            for (auto&& index : plannerParams->indices) {
+                const auto* indexStats = stats->getIndex(index.identifier.catalogName);
+                if (indexStats && !indexStats->histogram.empty() &&
+                    SimpleBSONObjComparator::kInstance.evaluate(indexStats->keyPattern ==
+                                                                index.keyPattern) &&
+                    indexStats->histogram.distinctCount() <= maxPrefixCardinality) {
+                    plannerParams->skipScanIndexes.insert(index.identifier.catalogName);
+                }
+            }
+        }
+    }
+
     plannerParams->options |= QueryPlannerParams::SPLIT_LIMITED_SORT;
 
     if (shouldWaitForOplogVisibility(
@@ -577,10 +600,20 @@ public:
             CurOp::get(_opCtx)->debug().planCacheKey =
                 canonical_query_encoder::computeHash(planCacheKey.toString());
 
-            // Try to look up a cached solution for the query.
-            if (auto cs = CollectionQueryInfo::get(_collection)
-                              .getPlanCache()
-                              ->getCacheEntryIfActive(planCacheKey)) {
+            // Try to look up a cached solution for the query, falling back to the plans shared by
+            // collections with the same indexes.
+            auto cs = CollectionQueryInfo::get(_collection)
+                          .getPlanCache()
+                          ->getCacheEntryIfActive(planCacheKey);
+            if (!cs && internalQueryEnableSharedPlanCache.load() &&
+                !plannerParams.indexFiltersApplied) {
+                cs = shared_plan_cache::getCacheEntryIfActive(
+                    *shared_plan_cache::get(_opCtx->getServiceContext()),
+                    *_cq,
+                    planCacheKey,
+                    plannerParams.indices);
+            }
+            if (cs) {
                 // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
                 auto statusWithQs = QueryPlanner::planFromCache(*_cq, plannerParams, *cs);
 
@@ -641,6 +674,10 @@ public:
             }
         }
 
+        if (solutions.size() > 1 && internalQueryEnableCostBasedPlanSelection.load()) {
+            pruneCandidatesByCost(&solutions);
+        }
+
         if (1 == solutions.size()) {
             auto result = makeResult();
             // Only one possible plan. Run it. Build the stages from the solution.
@@ -662,6 +699,34 @@ public:
         return buildMultiPlan(std::move(solutions), plannerParams);
     }
 
+private:
+    /**
+     * Discards the candidates in 'solutions' which the collection's index statistics show to be
+     * clearly more expensive than the cheapest, so that multi-planning does not need to run them.
+     */
+    void pruneCandidatesByCost(std::vector<std::unique_ptr<QuerySolution>>* solutions) const {
+        auto stats = index_statistics_store::get(_opCtx, _collection);
+        if (!stats) {
+            return;
+        }
+
+        const auto numCandidates = solutions->size();
+        const auto numPruned =
+            plan_cost_model::pruneCandidates(*stats,
+                                             _collection->numRecords(_opCtx),
+                                             _cq->getCollator(),
+                                             internalQueryCostBasedPlanPruningRatio.load(),
+                                             solutions);
+        if (numPruned > 0) {
+            LOGV2_DEBUG(5100008,
+                        2,
+                        "Discarded candidate plans by estimated cost",
+                        "query"_attr = redact(_cq->toStringShort()),
+                        "numCandidates"_attr = numCandidates,
+                        "numPruned"_attr = numPruned);
+        }
+    }
+
 protected:
     /**
      * Creates a result instance to be returned to the caller holding the result of the
@@ -828,15 +893,17 @@ protected:
         // Add a CachedPlanStage on top of the previous root.
         //
         // 'decisionWorks' is used to determine whether the existing cache entry should
-        // be evicted, and the query replanned.
-        result->emplace(std::make_unique<CachedPlanStage>(_cq->getExpCtxRaw(),
-                                                          _collection,
-                                                          _ws,
-                                                          _cq,
-                                                          plannerParams,
-                                                          decisionWorks,
-                                                          std::move(root)),
-                        std::move(solution));
+        // be evicted, and the query replanned. The solution is owned by the executor, which
+        // outlives the CachedPlanStage's trial period.
+        auto cachedPlanStage = std::make_unique<CachedPlanStage>(_cq->getExpCtxRaw(),
+                                                                 _collection,
+                                                                 _ws,
+                                                                 _cq,
+                                                                 plannerParams,
+                                                                 decisionWorks,
+                                                                 std::move(root),
+                                                                 solution.get());
+        result->emplace(std::move(cachedPlanStage), std::move(solution));
         return result;
     }
 
@@ -2246,4 +2313,144 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDist
     }
 }
 
+namespace {
+/**
+ * Replaces an index scan which makes up the whole of 'soln' with a GROUP_COUNT_SCAN, if the scan
+ * covers a single interval of a non-multikey index whose key pattern begins with 'groupField'.
+ */
+bool turnIxscanIntoGroupCount(QuerySolution* soln,
+                              StringData groupField,
+                              const std::string& countField) {
+    QuerySolutionNode* root = soln->root.get();
+    if (STAGE_IXSCAN != root->getType() || nullptr != root->filter.get()) {
+        return false;
+    }
+
+    IndexScanNode* isn = static_cast<IndexScanNode*>(root);
+    if (isn->bounds.isSimpleRange || isn->index.multikey ||
+        isn->index.keyPattern.firstElement().fieldNameStringData() != groupField) {
+        return false;
+    }
+
+    BSONObj startKey;
+    bool startKeyInclusive;
+    BSONObj endKey;
+    bool endKeyInclusive;
+    if (!IndexBoundsBuilder::isSingleInterval(
+            isn->bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
+        return false;
+    }
+
+    // The groups are counted in a forward scan, whatever the direction of the index scan.
+    if (isn->direction < 0) {
+        startKey.swap(endKey);
+        std::swap(startKeyInclusive, endKeyInclusive);
+    }
+
+    auto gcsn = std::make_unique<GroupCountScanNode>(isn->index, countField);
+    gcsn->startKey = startKey;
+    gcsn->startKeyInclusive = startKeyInclusive;
+    gcsn->endKey = endKey;
+    gcsn->endKeyInclusive = endKeyInclusive;
+    soln->root = std::move(gcsn);
+    return true;
+}
+}  // namespace
+
+StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorGroupCount(
+    Collection* collection,
+    size_t plannerOptions,
+    std::unique_ptr<CanonicalQuery> cq,
+    const std::string& groupField,
+    const std::string& countField) {
+    auto expCtx = cq->getExpCtx();
+    OperationContext* opCtx = expCtx->opCtx;
+    const auto yieldPolicy = opCtx->inMultiDocumentTransaction()
+        ? PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY
+        : PlanYieldPolicy::YieldPolicy::YIELD_AUTO;
+
+    // Index keys only tell values apart as $group does under the simple collation.
+    if (!collection || cq->getCollator() || cq->getSortPattern() || cq->getProj() ||
+        !cq->getQueryRequest().getHint().isEmpty()) {
+        return {nullptr};
+    }
+
+    if (OperationShardingState::isOperationVersioned(opCtx)) {
+        plannerOptions |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    }
+
+    QueryPlannerParams plannerParams;
+    plannerParams.options = plannerOptions | QueryPlannerParams::IS_COUNT;
+    fillOutPlannerParams(opCtx, collection, cq.get(), &plannerParams);
+
+    // The keys of orphaned documents cannot be told apart from the others without fetching them.
+    if (plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
+        return {nullptr};
+    }
+
+    auto& indices = plannerParams.indices;
+    indices.erase(std::remove_if(indices.begin(),
+                                 indices.end(),
+                                 [&](const IndexEntry& index) {
+                                     return index.type != INDEX_BTREE || index.multikey ||
+                                         index.collator ||
+                                         index.keyPattern.firstElement().fieldNameStringData() !=
+                                         groupField;
+                                 }),
+                  indices.end());
+    if (indices.empty()) {
+        return {nullptr};
+    }
+
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    if (cq->root()->matchType() == MatchExpression::AND && cq->root()->numChildren() == 0) {
+        // Without a predicate the planner would not scan an index, so scan the whole of one which
+        // has a key for every document.
+        auto index = std::find_if(indices.begin(), indices.end(), [](const IndexEntry& index) {
+            return !index.sparse && !index.filterExpr;
+        });
+        if (index == indices.end()) {
+            return {nullptr};
+        }
+
+        auto isn = std::make_unique<IndexScanNode>(*index);
+        IndexBoundsBuilder::allValuesBounds(isn->index.keyPattern, &isn->bounds);
+        solutions.push_back(
+            QueryPlannerAnalysis::analyzeDataAccess(*cq, plannerParams, std::move(isn)));
+    } else {
+        auto statusWithSolutions = QueryPlanner::plan(*cq, plannerParams);
+        if (!statusWithSolutions.isOK()) {
+            return {nullptr};
+        }
+        solutions = std::move(statusWithSolutions.getValue());
+    }
+
+    for (auto&& soln : solutions) {
+        if (!soln || !turnIxscanIntoGroupCount(soln.get(), groupField, countField)) {
+            continue;
+        }
+
+        std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
+        auto&& root =
+            stage_builder::buildClassicExecutableTree(opCtx, collection, *cq, *soln, ws.get());
+
+        LOGV2_DEBUG(5100011,
+                    2,
+                    "Using index group count",
+                    "query"_attr = redact(cq->toStringShort()),
+                    "planSummary"_attr = Explain::getPlanSummary(root.get()));
+
+        return PlanExecutor::make(std::move(cq),
+                                  std::move(ws),
+                                  std::move(root),
+                                  collection,
+                                  yieldPolicy,
+                                  NamespaceString(),
+                                  std::move(soln));
+    }
+
+    // Although there was no error, no solution could count the groups from an index.
+    return {nullptr};
+}
+
 }  // namespace mongo
@@ -205,6 +205,24 @@ bool turnIxscanIntoDistinctIxscan(QuerySolution* soln,
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDistinct(
     Collection* collection, size_t plannerOptions, ParsedDistinct* parsedDistinct);
 
+/**
+ * Get a PlanExecutor for the query which feeds a $group counting the documents of each value of
+ * 'groupField', such as {$group: {_id: "$a", n: {$sum: 1}}}, where 'countField' is "n". The plan
+ * counts the keys of an index whose key pattern begins with 'groupField' without fetching any
+ * documents, and returns the $group's results as documents of the form {_id: <value>, n: <count>}.
+ *
+ * Returns nullptr if there is no such plan: the index must not be multikey, must compare strings
+ * by the simple collation, as must the query, and the query's predicate must be answered exactly
+ * by a single interval of the index. Sharded collections are not supported, since orphaned
+ * documents cannot be filtered out.
+ */
+StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorGroupCount(
+    Collection* collection,
+    size_t plannerOptions,
+    std::unique_ptr<CanonicalQuery> cq,
+    const std::string& groupField,
+    const std::string& countField);
+
 /*
  * Get a PlanExecutor for a query executing as part of a count command.
  *
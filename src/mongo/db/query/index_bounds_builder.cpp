@@ -31,6 +31,7 @@
 
 #include "mongo/db/query/index_bounds_builder.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -166,6 +167,39 @@ bool isEqualityOrInNull(MatchExpression* me) {
     return false;
 }
 
+// Upper bound on the size of each buffer shared by the point intervals built by
+// appendPointIntervals().
+const int kPointIntervalBufferBytes = 1024 * 1024;
+
+/**
+ * Appends a point interval for each of the sorted, deduplicated 'equalities' to 'oil'. Rather than
+ * giving every interval its own single-field BSONObj, the collation-aware keys are packed into a
+ * few large buffers which the intervals share, so very large $in lists cost one allocation per
+ * buffer instead of one per element.
+ */
+void appendPointIntervals(const std::vector<BSONElement>& equalities,
+                          const CollatorInterface* collator,
+                          OrderedIntervalList* oil) {
+    oil->intervals.reserve(oil->intervals.size() + equalities.size());
+
+    auto it = equalities.begin();
+    while (it != equalities.end()) {
+        BSONObjBuilder bob;
+        for (; it != equalities.end() && bob.len() < kPointIntervalBufferBytes; ++it) {
+            CollationIndexKey::collationAwareIndexKeyAppend(*it, collator, &bob);
+        }
+
+        const BSONObj buffer = bob.obj();
+        for (auto&& key : buffer) {
+            Interval interval;
+            interval._intervalData = buffer;
+            interval.start = interval.end = key;
+            interval.startInclusive = interval.endInclusive = true;
+            oil->intervals.push_back(std::move(interval));
+        }
+    }
+}
+
 }  // namespace
 
 string IndexBoundsBuilder::simpleRegex(const char* regex,
@@ -830,14 +864,22 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
         // Create our various intervals.
 
         IndexBoundsBuilder::BoundsTightness tightness;
-        bool arrayOrNullPresent = false;
-        for (auto&& equality : ime->getEqualities()) {
-            translateEquality(equality, index, isHashed, oilOut, &tightness);
-            // The ordering invariant of oil has been violated by the call to translateEquality.
-            arrayOrNullPresent = arrayOrNullPresent || equality.type() == BSONType::jstNULL ||
-                equality.type() == BSONType::Array;
-            if (tightness != IndexBoundsBuilder::EXACT) {
-                *tightnessOut = tightness;
+        const auto& equalities = ime->getEqualities();
+        const bool arrayOrNullPresent =
+            std::any_of(equalities.begin(), equalities.end(), [](const BSONElement& equality) {
+                return equality.type() == BSONType::jstNULL || equality.type() == BSONType::Array;
+            });
+        if (!isHashed && !arrayOrNullPresent) {
+            // Each equality translates to exactly one tight point interval, in the order the
+            // equalities are already sorted in.
+            appendPointIntervals(equalities, index.collator, oilOut);
+        } else {
+            for (auto&& equality : equalities) {
+                // The ordering invariant of oil may be violated by the call to translateEquality.
+                translateEquality(equality, index, isHashed, oilOut, &tightness);
+                if (tightness != IndexBoundsBuilder::EXACT) {
+                    *tightnessOut = tightness;
+                }
             }
         }
 
@@ -845,6 +845,36 @@ TEST_F(IndexBoundsBuilderTest, TranslateIn) {
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
 }
 
+TEST_F(IndexBoundsBuilderTest, TranslateLargeInBuildsOrderedPointIntervals) {
+    auto testIndex = buildSimpleIndexEntry();
+
+    // Enough long strings that the point intervals span several shared buffers.
+    const int kNumEqualities = 20000;
+    BSONObjBuilder bob;
+    {
+        BSONObjBuilder inBob(bob.subobjStart("a"));
+        BSONArrayBuilder arrBob(inBob.subarrayStart("$in"));
+        for (int i = kNumEqualities - 1; i >= 0; --i) {
+            arrBob.append(str::stream() << std::string(100, 'x') << i);
+        }
+    }
+    BSONObj obj = bob.obj();
+    auto expr = parseMatchExpression(obj);
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.name, "a");
+    ASSERT_EQUALS(oil.intervals.size(), static_cast<size_t>(kNumEqualities));
+    for (size_t i = 0; i < oil.intervals.size(); ++i) {
+        ASSERT_TRUE(oil.intervals[i].isPoint());
+        if (i > 0) {
+            ASSERT_LT(oil.intervals[i - 1].start.woCompare(oil.intervals[i].start, false), 0);
+        }
+    }
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
+}
+
 TEST_F(IndexBoundsBuilderTest, TranslateInArray) {
     auto testIndex = buildSimpleIndexEntry();
     BSONObj obj = fromjson("{a: {$in: [[1], 2]}}");
@@ -0,0 +1,420 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/db/query/interval.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr StringData kMinFieldName = "min"_sd;
+constexpr StringData kBucketsFieldName = "buckets"_sd;
+constexpr StringData kUpperBoundFieldName = "upper"_sd;
+constexpr StringData kEqualCountFieldName = "equal"_sd;
+constexpr StringData kRangeCountFieldName = "range"_sd;
+constexpr StringData kRangeDistinctCountFieldName = "rangeDistinct"_sd;
+
+constexpr StringData kNameFieldName = "name"_sd;
+constexpr StringData kKeyPatternFieldName = "keyPattern"_sd;
+constexpr StringData kNumKeysFieldName = "numKeys"_sd;
+constexpr StringData kNumDistinctKeysFieldName = "numDistinctKeys"_sd;
+constexpr StringData kDescribesCollectionFieldName = "describesCollection"_sd;
+constexpr StringData kHistogramFieldName = "histogram"_sd;
+
+constexpr StringData kIdFieldName = "_id"_sd;
+constexpr StringData kUUIDFieldName = "uuid"_sd;
+constexpr StringData kNumRecordsFieldName = "numRecords"_sd;
+constexpr StringData kAnalyzedAtFieldName = "analyzedAt"_sd;
+constexpr StringData kIndexesFieldName = "indexes"_sd;
+
+// Index keys and interval bounds have empty field names, while persisted values do not.
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.woCompare(rhs, 0);
+}
+
+BSONObj wrapValue(const BSONElement& value) {
+    BSONObjBuilder bob;
+    bob.appendAs(value, "");
+    return bob.obj();
+}
+
+long long extractCount(const BSONObj& obj, StringData fieldName) {
+    long long count;
+    uassertStatusOK(bsonExtractIntegerField(obj, fieldName, &count));
+    uassert(5100003,
+            str::stream() << "'" << fieldName << "' must not be negative in " << obj,
+            count >= 0);
+    return count;
+}
+
+/**
+ * Returns the fraction of the values in the open range ('lower', 'upper') which lie within
+ * ['lo', 'hi']. If 'lowerInclusive' is true, the range also includes 'lower'. Values are assumed
+ * to be spread evenly over numeric ranges, and otherwise a partial overlap is assumed to cover half
+ * of the range.
+ */
+double rangeOverlap(const BSONElement& lower,
+                    bool lowerInclusive,
+                    const BSONElement& upper,
+                    const BSONElement& lo,
+                    const BSONElement& hi) {
+    const int hiVsLower = compareValues(hi, lower);
+    if (hiVsLower < 0 || (hiVsLower == 0 && !lowerInclusive) || compareValues(lo, upper) >= 0) {
+        return 0.0;
+    }
+    if (compareValues(lo, lower) <= 0 && compareValues(hi, upper) >= 0) {
+        return 1.0;
+    }
+
+    const BSONElement& from = compareValues(lo, lower) > 0 ? lo : lower;
+    const BSONElement& to = compareValues(hi, upper) < 0 ? hi : upper;
+    if (lower.isNumber() && upper.isNumber() && from.isNumber() && to.isNumber()) {
+        const double fraction = (to.numberDouble() - from.numberDouble()) /
+            (upper.numberDouble() - lower.numberDouble());
+        if (std::isfinite(fraction)) {
+            return std::max(0.0, std::min(1.0, fraction));
+        }
+    }
+    return 0.5;
+}
+
+}  // namespace
+
+EquiDepthHistogram EquiDepthHistogram::parse(const BSONObj& obj) {
+    EquiDepthHistogram histogram;
+
+    BSONElement bucketsElem;
+    uassertStatusOK(bsonExtractTypedField(obj, kBucketsFieldName, Array, &bucketsElem));
+    for (auto&& bucketElem : bucketsElem.Obj()) {
+        uassert(5100004,
+                str::stream() << "histogram buckets must be objects: " << bucketElem,
+                bucketElem.type() == Object);
+        auto bucketObj = bucketElem.Obj();
+
+        BSONElement upperBound;
+        uassertStatusOK(bsonExtractField(bucketObj, kUpperBoundFieldName, &upperBound));
+
+        Bucket bucket;
+        bucket.upperBoundObj = wrapValue(upperBound);
+        bucket.equalCount = extractCount(bucketObj, kEqualCountFieldName);
+        bucket.rangeCount = extractCount(bucketObj, kRangeCountFieldName);
+        bucket.rangeDistinctCount = extractCount(bucketObj, kRangeDistinctCountFieldName);
+        uassert(5100005,
+                str::stream() << "histogram buckets must be in ascending order: " << obj,
+                histogram._buckets.empty() ||
+                    compareValues(histogram._buckets.back().upperBound(), upperBound) < 0);
+
+        histogram._totalCount += bucket.equalCount + bucket.rangeCount;
+        histogram._buckets.push_back(std::move(bucket));
+    }
+
+    if (!histogram._buckets.empty()) {
+        BSONElement min;
+        uassertStatusOK(bsonExtractField(obj, kMinFieldName, &min));
+        histogram._minObj = wrapValue(min);
+    }
+    return histogram;
+}
+
+void EquiDepthHistogram::serialize(BSONObjBuilder* builder) const {
+    if (!_buckets.empty()) {
+        builder->appendAs(min(), kMinFieldName);
+    }
+    BSONArrayBuilder bucketsBuilder(builder->subarrayStart(kBucketsFieldName));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.appendAs(bucket.upperBound(), kUpperBoundFieldName);
+        bucketBuilder.append(kEqualCountFieldName, bucket.equalCount);
+        bucketBuilder.append(kRangeCountFieldName, bucket.rangeCount);
+        bucketBuilder.append(kRangeDistinctCountFieldName, bucket.rangeDistinctCount);
+    }
+}
+
+double EquiDepthHistogram::estimateEqual(const BSONElement& value) const {
+    if (_buckets.empty() || compareValues(value, min()) < 0) {
+        return 0.0;
+    }
+
+    auto bucket = std::partition_point(_buckets.begin(), _buckets.end(), [&](const Bucket& b) {
+        return compareValues(b.upperBound(), value) < 0;
+    });
+    if (bucket == _buckets.end()) {
+        return 0.0;
+    }
+    if (compareValues(bucket->upperBound(), value) == 0) {
+        return bucket->equalCount;
+    }
+    return bucket->rangeDistinctCount > 0
+        ? static_cast<double>(bucket->rangeCount) / bucket->rangeDistinctCount
+        : 0.0;
+}
+
+double EquiDepthHistogram::estimateInterval(const Interval& interval) const {
+    if (_buckets.empty()) {
+        return 0.0;
+    }
+
+    const bool ascending = compareValues(interval.start, interval.end) <= 0;
+    const BSONElement& lo = ascending ? interval.start : interval.end;
+    const BSONElement& hi = ascending ? interval.end : interval.start;
+    const bool loInclusive = ascending ? interval.startInclusive : interval.endInclusive;
+    const bool hiInclusive = ascending ? interval.endInclusive : interval.startInclusive;
+
+    const int loVsHi = compareValues(lo, hi);
+    if (loVsHi == 0) {
+        return loInclusive && hiInclusive ? estimateEqual(lo) : 0.0;
+    }
+
+    auto contains = [&](const BSONElement& value) {
+        const int loVsValue = compareValues(lo, value);
+        const int valueVsHi = compareValues(value, hi);
+        return (loVsValue < 0 || (loVsValue == 0 && loInclusive)) &&
+            (valueVsHi < 0 || (valueVsHi == 0 && hiInclusive));
+    };
+
+    double estimate = 0.0;
+    BSONElement lower = min();
+    bool lowerInclusive = true;
+    for (auto&& bucket : _buckets) {
+        if (compareValues(lower, hi) > 0) {
+            break;
+        }
+        estimate +=
+            bucket.rangeCount * rangeOverlap(lower, lowerInclusive, bucket.upperBound(), lo, hi);
+        if (contains(bucket.upperBound())) {
+            estimate += bucket.equalCount;
+        }
+        lower = bucket.upperBound();
+        lowerInclusive = false;
+    }
+    return estimate;
+}
+
+long long EquiDepthHistogram::distinctCount() const {
+    long long count = 0;
+    for (auto&& bucket : _buckets) {
+        count += bucket.rangeDistinctCount + 1;
+    }
+    return count;
+}
+
+EquiDepthHistogramBuilder::EquiDepthHistogramBuilder(size_t numBuckets, long long expectedCount)
+    : _numBuckets(std::max<size_t>(numBuckets, 1)),
+      _depth(std::max<long long>(1, expectedCount / static_cast<long long>(_numBuckets))) {}
+
+void EquiDepthHistogramBuilder::add(const BSONElement& value) {
+    if (_runCount > 0 && compareValues(_runValue.firstElement(), value) == 0) {
+        ++_runCount;
+        return;
+    }
+
+    if (_runCount > 0) {
+        dassert(compareValues(_runValue.firstElement(), value) < 0);
+        flushRun(false);
+    } else {
+        _histogram._minObj = wrapValue(value);
+    }
+    _runValue = wrapValue(value);
+    _runCount = 1;
+}
+
+void EquiDepthHistogramBuilder::flushRun(bool endBucket) {
+    _histogram._totalCount += _runCount;
+    if (!endBucket && _rangeCount + _runCount < _depth) {
+        _rangeCount += _runCount;
+        ++_rangeDistinctCount;
+        return;
+    }
+
+    EquiDepthHistogram::Bucket bucket;
+    bucket.upperBoundObj = std::move(_runValue);
+    bucket.equalCount = _runCount;
+    bucket.rangeCount = _rangeCount;
+    bucket.rangeDistinctCount = _rangeDistinctCount;
+    _histogram._buckets.push_back(std::move(bucket));
+
+    _rangeCount = 0;
+    _rangeDistinctCount = 0;
+}
+
+EquiDepthHistogram EquiDepthHistogramBuilder::done() {
+    if (_runCount > 0) {
+        flushRun(true);
+        _runCount = 0;
+    }
+
+    // Merge adjacent pairs of buckets until the histogram is small enough. The keys of the lower
+    // bucket of each pair, including those equal to its bound, join the range of the upper one.
+    auto& buckets = _histogram._buckets;
+    while (buckets.size() > 2 * _numBuckets) {
+        std::vector<EquiDepthHistogram::Bucket> merged;
+        merged.reserve((buckets.size() + 1) / 2);
+        for (size_t i = 0; i < buckets.size(); i += 2) {
+            if (i + 1 == buckets.size()) {
+                merged.push_back(std::move(buckets[i]));
+                break;
+            }
+            auto& lower = buckets[i];
+            auto& upper = buckets[i + 1];
+            upper.rangeCount += lower.rangeCount + lower.equalCount;
+            upper.rangeDistinctCount += lower.rangeDistinctCount + 1;
+            merged.push_back(std::move(upper));
+        }
+        buckets = std::move(merged);
+    }
+
+    return std::move(_histogram);
+}
+
+IndexStatistics IndexStatistics::parse(const BSONObj& obj) {
+    IndexStatistics stats;
+    uassertStatusOK(bsonExtractStringField(obj, kNameFieldName, &stats.indexName));
+
+    BSONElement keyPattern;
+    uassertStatusOK(bsonExtractTypedField(obj, kKeyPatternFieldName, Object, &keyPattern));
+    stats.keyPattern = keyPattern.Obj().getOwned();
+
+    stats.numKeys = extractCount(obj, kNumKeysFieldName);
+    stats.numDistinctKeys = extractCount(obj, kNumDistinctKeysFieldName);
+    uassertStatusOK(
+        bsonExtractBooleanField(obj, kDescribesCollectionFieldName, &stats.describesCollection));
+
+    BSONElement histogram;
+    uassertStatusOK(bsonExtractTypedField(obj, kHistogramFieldName, Object, &histogram));
+    stats.histogram = EquiDepthHistogram::parse(histogram.Obj());
+    return stats;
+}
+
+void IndexStatistics::serialize(BSONObjBuilder* builder) const {
+    builder->append(kNameFieldName, indexName);
+    builder->append(kKeyPatternFieldName, keyPattern);
+    builder->append(kNumKeysFieldName, numKeys);
+    builder->append(kNumDistinctKeysFieldName, numDistinctKeys);
+    builder->append(kDescribesCollectionFieldName, describesCollection);
+    BSONObjBuilder histogramBuilder(builder->subobjStart(kHistogramFieldName));
+    histogram.serialize(&histogramBuilder);
+}
+
+IndexStatisticsBuilder::IndexStatisticsBuilder(std::string indexName,
+                                               BSONObj keyPattern,
+                                               bool describesCollection,
+                                               size_t numBuckets,
+                                               long long expectedNumKeys)
+    : _histogramBuilder(numBuckets, expectedNumKeys) {
+    _stats.indexName = std::move(indexName);
+    _stats.keyPattern = keyPattern.getOwned();
+    _stats.describesCollection = describesCollection;
+}
+
+void IndexStatisticsBuilder::addKey(const BSONObj& key) {
+    ++_stats.numKeys;
+    _histogramBuilder.add(key.firstElement());
+
+    // Equal keys are adjacent in an index, whichever way it is scanned.
+    if (_lastKey.isEmpty() || _lastKey.woCompare(key, BSONObj(), false) != 0) {
+        ++_stats.numDistinctKeys;
+        _lastKey = key.getOwned();
+    }
+}
+
+IndexStatistics IndexStatisticsBuilder::done() {
+    _stats.histogram = _histogramBuilder.done();
+    return std::move(_stats);
+}
+
+CollectionIndexStatistics::CollectionIndexStatistics(UUID uuid,
+                                                     long long numRecords,
+                                                     Date_t analyzedAt,
+                                                     std::vector<IndexStatistics> indexes)
+    : _uuid(std::move(uuid)),
+      _numRecords(numRecords),
+      _analyzedAt(analyzedAt),
+      _indexes(std::move(indexes)) {}
+
+CollectionIndexStatistics CollectionIndexStatistics::parse(const BSONObj& obj) {
+    auto uuid = uassertStatusOK(UUID::parse(obj[kUUIDFieldName]));
+    auto numRecords = extractCount(obj, kNumRecordsFieldName);
+
+    BSONElement analyzedAt;
+    uassertStatusOK(bsonExtractTypedField(obj, kAnalyzedAtFieldName, Date, &analyzedAt));
+
+    BSONElement indexesElem;
+    uassertStatusOK(bsonExtractTypedField(obj, kIndexesFieldName, Array, &indexesElem));
+    std::vector<IndexStatistics> indexes;
+    for (auto&& indexElem : indexesElem.Obj()) {
+        uassert(5100006,
+                str::stream() << "index statistics must be objects: " << indexElem,
+                indexElem.type() == Object);
+        indexes.push_back(IndexStatistics::parse(indexElem.Obj()));
+    }
+
+    return {std::move(uuid), numRecords, analyzedAt.date(), std::move(indexes)};
+}
+
+BSONObj CollectionIndexStatistics::toBSON(StringData collectionName) const {
+    BSONObjBuilder builder;
+    builder.append(kIdFieldName, collectionName);
+    _uuid.appendToBuilder(&builder, kUUIDFieldName);
+    builder.append(kNumRecordsFieldName, _numRecords);
+    builder.append(kAnalyzedAtFieldName, _analyzedAt);
+    BSONArrayBuilder indexesBuilder(builder.subarrayStart(kIndexesFieldName));
+    for (auto&& index : _indexes) {
+        BSONObjBuilder indexBuilder(indexesBuilder.subobjStart());
+        index.serialize(&indexBuilder);
+    }
+    indexesBuilder.done();
+    return builder.obj();
+}
+
+const IndexStatistics* CollectionIndexStatistics::getIndex(StringData indexName) const {
+    auto it = std::find_if(_indexes.begin(), _indexes.end(), [&](const IndexStatistics& index) {
+        return index.indexName == indexName;
+    });
+    return it == _indexes.end() ? nullptr : &*it;
+}
+
+const EquiDepthHistogram* CollectionIndexStatistics::getHistogramForPath(StringData path) const {
+    for (auto&& index : _indexes) {
+        if (index.describesCollection && !index.histogram.empty() &&
+            index.keyPattern.firstElementFieldNameStringData() == path) {
+            return &index.histogram;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace mongo
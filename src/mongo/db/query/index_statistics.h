@@ -0,0 +1,240 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+struct Interval;
+
+/**
+ * An equi-depth histogram over the values of a single field, built from the sorted keys of an
+ * index whose key pattern begins with that field. Each bucket holds roughly the same number of keys
+ * and is described by its inclusive upper bound: 'equalCount' keys are equal to the bound, and
+ * 'rangeCount' keys with 'rangeDistinctCount' distinct values lie strictly between the previous
+ * bucket's bound and this one. The range of the first bucket starts at, and includes, the smallest
+ * value in the histogram.
+ */
+class EquiDepthHistogram {
+public:
+    struct Bucket {
+        BSONElement upperBound() const {
+            return upperBoundObj.firstElement();
+        }
+
+        // A single-element object holding the bound.
+        BSONObj upperBoundObj;
+        long long equalCount = 0;
+        long long rangeCount = 0;
+        long long rangeDistinctCount = 0;
+    };
+
+    /**
+     * Parses the format produced by serialize(). Throws if 'obj' is malformed.
+     */
+    static EquiDepthHistogram parse(const BSONObj& obj);
+
+    void serialize(BSONObjBuilder* builder) const;
+
+    /**
+     * Estimates the number of values equal to 'value'.
+     */
+    double estimateEqual(const BSONElement& value) const;
+
+    /**
+     * Estimates the number of values within 'interval', which may be in either direction.
+     */
+    double estimateInterval(const Interval& interval) const;
+
+    long long totalCount() const {
+        return _totalCount;
+    }
+
+    long long distinctCount() const;
+
+    bool empty() const {
+        return _buckets.empty();
+    }
+
+    const std::vector<Bucket>& buckets() const {
+        return _buckets;
+    }
+
+private:
+    friend class EquiDepthHistogramBuilder;
+
+    BSONElement min() const {
+        return _minObj.firstElement();
+    }
+
+    BSONObj _minObj;
+    std::vector<Bucket> _buckets;
+    long long _totalCount = 0;
+};
+
+/**
+ * Builds an EquiDepthHistogram from values supplied in ascending order.
+ */
+class EquiDepthHistogramBuilder {
+public:
+    /**
+     * The bucket depth is chosen so that 'expectedCount' values fill 'numBuckets' buckets. If many
+     * more values are added, adjacent buckets are merged so that the histogram ends up with no more
+     * than twice 'numBuckets' buckets.
+     */
+    EquiDepthHistogramBuilder(size_t numBuckets, long long expectedCount);
+
+    void add(const BSONElement& value);
+
+    EquiDepthHistogram done();
+
+private:
+    // Accounts for the run of values equal to '_runValue', ending the current bucket with it if
+    // the bucket is full or 'endBucket' is true.
+    void flushRun(bool endBucket);
+
+    const size_t _numBuckets;
+    const long long _depth;
+
+    EquiDepthHistogram _histogram;
+
+    BSONObj _runValue;
+    long long _runCount = 0;
+    long long _rangeCount = 0;
+    long long _rangeDistinctCount = 0;
+};
+
+/**
+ * Statistics about the keys of one index, as collected by the 'analyze' command.
+ */
+struct IndexStatistics {
+    static IndexStatistics parse(const BSONObj& obj);
+    void serialize(BSONObjBuilder* builder) const;
+
+    std::string indexName;
+    BSONObj keyPattern;
+    long long numKeys = 0;
+
+    // The number of distinct keys over all fields of the key pattern.
+    long long numDistinctKeys = 0;
+
+    // True if the index has a key for every document and compares strings by the simple collation,
+    // so that its histogram also describes the field's values in the collection.
+    bool describesCollection = false;
+
+    // Describes the first field of the key pattern.
+    EquiDepthHistogram histogram;
+};
+
+/**
+ * Computes the IndexStatistics of an index from its keys, supplied in ascending order of the first
+ * field of the key pattern.
+ */
+class IndexStatisticsBuilder {
+public:
+    IndexStatisticsBuilder(std::string indexName,
+                           BSONObj keyPattern,
+                           bool describesCollection,
+                           size_t numBuckets,
+                           long long expectedNumKeys);
+
+    /**
+     * Adds a key in index key format, with empty field names.
+     */
+    void addKey(const BSONObj& key);
+
+    IndexStatistics done();
+
+private:
+    IndexStatistics _stats;
+    EquiDepthHistogramBuilder _histogramBuilder;
+    BSONObj _lastKey;
+};
+
+/**
+ * The statistics of all analyzed indexes of a collection. Persisted as a single document in the
+ * 'system.statistics' collection of the collection's database, keyed by collection name.
+ */
+class CollectionIndexStatistics {
+public:
+    CollectionIndexStatistics(UUID uuid,
+                              long long numRecords,
+                              Date_t analyzedAt,
+                              std::vector<IndexStatistics> indexes);
+
+    static CollectionIndexStatistics parse(const BSONObj& obj);
+
+    /**
+     * Returns the document persisted for the collection named 'collectionName'.
+     */
+    BSONObj toBSON(StringData collectionName) const;
+
+    /**
+     * Returns the statistics for the index named 'indexName', or nullptr if it was not analyzed.
+     */
+    const IndexStatistics* getIndex(StringData indexName) const;
+
+    /**
+     * Returns a histogram describing the values of 'path' across the collection, or nullptr if no
+     * analyzed index provides one.
+     */
+    const EquiDepthHistogram* getHistogramForPath(StringData path) const;
+
+    const UUID& uuid() const {
+        return _uuid;
+    }
+
+    long long numRecords() const {
+        return _numRecords;
+    }
+
+    Date_t analyzedAt() const {
+        return _analyzedAt;
+    }
+
+    const std::vector<IndexStatistics>& indexes() const {
+        return _indexes;
+    }
+
+private:
+    UUID _uuid;
+    long long _numRecords;
+    Date_t _analyzedAt;
+    std::vector<IndexStatistics> _indexes;
+};
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics_cache.h"
+
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getIndexStatisticsCache = ServiceContext::declareDecoration<IndexStatisticsCache>();
+
+}  // namespace
+
+// static
+IndexStatisticsCache& IndexStatisticsCache::get(ServiceContext* service) {
+    return getIndexStatisticsCache(service);
+}
+
+boost::optional<IndexStatisticsCache::StatisticsPtr> IndexStatisticsCache::lookup(
+    const NamespaceString& nss) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(nss);
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+uint64_t IndexStatisticsCache::getGeneration() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _generation;
+}
+
+void IndexStatisticsCache::insertLoaded(const NamespaceString& nss,
+                                        StatisticsPtr stats,
+                                        uint64_t generation) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (generation == _generation) {
+        _entries.emplace(nss, std::move(stats));
+    }
+}
+
+void IndexStatisticsCache::set(const NamespaceString& nss, StatisticsPtr stats) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries[nss] = std::move(stats);
+}
+
+void IndexStatisticsCache::invalidateDatabase(StringData dbName) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->first.db() == dbName) {
+            _entries.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    ++_generation;
+}
+
+void IndexStatisticsCache::invalidateAll() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    ++_generation;
+}
+
+void IndexStatisticsCache::onWrite(OperationContext* opCtx,
+                                   const NamespaceString& statsNss,
+                                   const BSONObj& doc) {
+    auto id = doc["_id"];
+    if (id.type() != BSONType::String) {
+        // The document does not describe any collection, so the planner never reads it.
+        return;
+    }
+
+    const NamespaceString nss(statsNss.db(), id.valueStringData());
+    StatisticsPtr stats;
+    try {
+        stats = std::make_shared<const CollectionIndexStatistics>(
+            CollectionIndexStatistics::parse(doc));
+    } catch (const DBException& ex) {
+        // Plan without statistics rather than fail the write. The next 'analyze' replaces the
+        // document.
+        LOGV2_WARNING(5100015,
+                      "Ignoring unreadable index statistics",
+                      "namespace"_attr = nss,
+                      "error"_attr = redact(ex.toStatus()));
+    }
+
+    opCtx->recoveryUnit()->onCommit(
+        [this, nss, stats = std::move(stats)](boost::optional<Timestamp>) { set(nss, stats); });
+}
+
+void IndexStatisticsCache::onDelete(OperationContext* opCtx,
+                                    const NamespaceString& statsNss,
+                                    const BSONElement& id) {
+    if (id.type() != BSONType::String) {
+        return;
+    }
+
+    const NamespaceString nss(statsNss.db(), id.valueStringData());
+    opCtx->recoveryUnit()->onCommit(
+        [this, nss](boost::optional<Timestamp>) { set(nss, nullptr); });
+}
+
+void IndexStatisticsCache::onDrop(OperationContext* opCtx, StringData dbName) {
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        invalidateDatabase(dbName);
+        return;
+    }
+
+    opCtx->recoveryUnit()->onCommit(
+        [this, db = dbName.toString()](boost::optional<Timestamp>) { invalidateDatabase(db); });
+}
+
+}  // namespace mongo
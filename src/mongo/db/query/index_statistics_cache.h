@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Caches the index statistics held in the 'system.statistics' collections of this node, by the
+ * namespace of the collection they describe. The OpObserver keeps the cache in step with every
+ * committed write to those collections, whether made by the 'analyze' command, by a client or by
+ * replication, so an entry never needs to be loaded more than once. Statistics which the cache
+ * does not know of are loaded from disk on first use; see index_statistics_store.h.
+ */
+class IndexStatisticsCache {
+public:
+    using StatisticsPtr = std::shared_ptr<const CollectionIndexStatistics>;
+
+    static IndexStatisticsCache& get(ServiceContext* service);
+
+    /**
+     * Returns the cached statistics of the collection 'nss', which are nullptr if it has none, or
+     * boost::none if they are unknown and must be loaded.
+     */
+    boost::optional<StatisticsPtr> lookup(const NamespaceString& nss) const;
+
+    /**
+     * Returns the generation of the cache, which changes whenever entries are dropped. Must be read
+     * before loading the statistics passed to insertLoaded().
+     */
+    uint64_t getGeneration() const;
+
+    /**
+     * Caches 'stats', loaded from disk, as the statistics of 'nss', unless the cache learned of
+     * them from a write or was invalidated since 'generation' was read.
+     */
+    void insertLoaded(const NamespaceString& nss, StatisticsPtr stats, uint64_t generation);
+
+    /**
+     * Caches 'stats' as the statistics of 'nss', replacing any entry.
+     */
+    void set(const NamespaceString& nss, StatisticsPtr stats);
+
+    /**
+     * Drops the entries of the collections in 'dbName', or of every collection.
+     */
+    void invalidateDatabase(StringData dbName);
+    void invalidateAll();
+
+    /**
+     * Called by the OpObserver when 'doc' is inserted into, or replaces a document of, the
+     * statistics collection 'statsNss'. Updates the cache once the write commits.
+     */
+    void onWrite(OperationContext* opCtx, const NamespaceString& statsNss, const BSONObj& doc);
+
+    /**
+     * Called by the OpObserver when the document with _id 'id' is deleted from the statistics
+     * collection 'statsNss'. Updates the cache once the delete commits.
+     */
+    void onDelete(OperationContext* opCtx, const NamespaceString& statsNss, const BSONElement& id);
+
+    /**
+     * Called by the OpObserver when the statistics collection of 'dbName' is dropped or renamed,
+     * or the database itself is dropped. Invalidates the cache once the operation commits.
+     */
+    void onDrop(OperationContext* opCtx, StringData dbName);
+
+private:
+    // Protects all of the below.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("IndexStatisticsCache::_mutex");
+
+    stdx::unordered_map<NamespaceString, StatisticsPtr> _entries;
+    uint64_t _generation = 0;
+};
+
+}  // namespace mongo
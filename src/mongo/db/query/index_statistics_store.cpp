@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics_store.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/query/index_statistics_cache.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace index_statistics_store {
+
+namespace {
+
+boost::optional<BSONObj> findStatisticsDocument(OperationContext* opCtx,
+                                                const NamespaceString& nss) {
+    // The statistics collection is in the same database as 'nss', which the caller has locked
+    // already, so only the collection itself needs to be locked.
+    const auto statsNss = getStatisticsNamespace(nss.db());
+    dassert(opCtx->lockState()->isDbLockedForMode(nss.db(), MODE_IS));
+    Lock::CollectionLock statsLock(opCtx, statsNss, MODE_IS);
+    auto collection = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, statsNss);
+    if (!collection) {
+        return boost::none;
+    }
+
+    auto indexCatalog = collection->getIndexCatalog();
+    auto idIndex = indexCatalog->findIdIndex(opCtx);
+    if (!idIndex) {
+        return boost::none;
+    }
+
+    auto recordId = indexCatalog->getEntry(idIndex)->accessMethod()->findSingle(
+        opCtx, BSON("_id" << nss.coll()));
+    Snapshotted<BSONObj> doc;
+    if (recordId.isNull() || !collection->findDoc(opCtx, recordId, &doc)) {
+        return boost::none;
+    }
+    return doc.value().getOwned();
+}
+
+/**
+ * Loads the statistics of the collection 'nss' from disk into the cache of statistics.
+ */
+IndexStatisticsCache::StatisticsPtr load(OperationContext* opCtx, const NamespaceString& nss) {
+    auto& cache = IndexStatisticsCache::get(opCtx->getServiceContext());
+    const auto generation = cache.getGeneration();
+
+    IndexStatisticsCache::StatisticsPtr stats;
+    try {
+        if (auto doc = findStatisticsDocument(opCtx, nss)) {
+            stats = std::make_shared<const CollectionIndexStatistics>(
+                CollectionIndexStatistics::parse(*doc));
+        }
+    } catch (const DBException& ex) {
+        // Plan without statistics rather than fail the query. The next 'analyze' replaces the
+        // document.
+        LOGV2_WARNING(5100007,
+                      "Ignoring unreadable index statistics",
+                      "namespace"_attr = nss,
+                      "error"_attr = redact(ex.toStatus()));
+    }
+
+    cache.insertLoaded(nss, stats, generation);
+    return stats;
+}
+
+}  // namespace
+
+NamespaceString getStatisticsNamespace(StringData dbName) {
+    return NamespaceString(dbName, NamespaceString::kSystemDotStatisticsCollectionName);
+}
+
+std::shared_ptr<const CollectionIndexStatistics> get(OperationContext* opCtx,
+                                                     Collection* collection) {
+    auto cached = IndexStatisticsCache::get(opCtx->getServiceContext()).lookup(collection->ns());
+    auto stats = cached ? *cached : load(opCtx, collection->ns());
+
+    // Statistics of an earlier collection with the same name do not describe this one.
+    if (stats && stats->uuid() != collection->uuid()) {
+        return nullptr;
+    }
+    return stats;
+}
+
+void save(OperationContext* opCtx,
+          const NamespaceString& nss,
+          const CollectionIndexStatistics& stats) {
+    DBDirectClient client(opCtx);
+    auto response = client.runCommand([&] {
+        write_ops::Update updateOp(getStatisticsNamespace(nss.db()));
+        write_ops::UpdateOpEntry entry(BSON("_id" << nss.coll()),
+                                       write_ops::UpdateModification(stats.toBSON(nss.coll())));
+        entry.setUpsert(true);
+        updateOp.setUpdates({entry});
+        return updateOp.serialize({});
+    }());
+    uassertStatusOK(getStatusFromWriteCommandReply(response->getCommandReply()));
+}
+
+}  // namespace index_statistics_store
+}  // namespace mongo
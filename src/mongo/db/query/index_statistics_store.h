@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/index_statistics.h"
+
+namespace mongo {
+
+class Collection;
+class OperationContext;
+
+/**
+ * Persists the statistics collected by the 'analyze' command in the 'system.statistics' collection
+ * of each database, and reads them through the IndexStatisticsCache.
+ */
+namespace index_statistics_store {
+
+/**
+ * Returns the namespace which holds the statistics of the collections in 'dbName'.
+ */
+NamespaceString getStatisticsNamespace(StringData dbName);
+
+/**
+ * Returns the index statistics of 'collection', loading them on first use. Returns nullptr if the
+ * collection has not been analyzed, or its statistics describe a dropped collection of the same
+ * name. The caller must hold a lock on 'collection', and therefore on its database.
+ */
+std::shared_ptr<const CollectionIndexStatistics> get(OperationContext* opCtx,
+                                                     Collection* collection);
+
+/**
+ * Persists 'stats' as the statistics of the collection 'nss'. The caller must not hold any locks.
+ */
+void save(OperationContext* opCtx,
+          const NamespaceString& nss,
+          const CollectionIndexStatistics& stats);
+
+}  // namespace index_statistics_store
+}  // namespace mongo
@@ -0,0 +1,241 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/db/json.h"
+#include "mongo/db/query/index_statistics_cache.h"
+#include "mongo/db/query/interval.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+EquiDepthHistogram buildHistogram(const std::vector<int>& sortedValues, size_t numBuckets) {
+    EquiDepthHistogramBuilder builder(numBuckets, sortedValues.size());
+    for (auto value : sortedValues) {
+        builder.add(BSON("" << value).firstElement());
+    }
+    return builder.done();
+}
+
+std::vector<int> range(int begin, int end) {
+    std::vector<int> values;
+    for (int i = begin; i < end; ++i) {
+        values.push_back(i);
+    }
+    return values;
+}
+
+Interval makeInterval(BSONObj bounds, bool startInclusive, bool endInclusive) {
+    return Interval(bounds, startInclusive, endInclusive);
+}
+
+TEST(EquiDepthHistogramTest, BucketsHoldEqualNumbersOfValues) {
+    auto histogram = buildHistogram(range(0, 1000), 10);
+    ASSERT_EQ(histogram.buckets().size(), 10U);
+    for (auto&& bucket : histogram.buckets()) {
+        ASSERT_EQ(bucket.rangeCount + bucket.equalCount, 100);
+    }
+    ASSERT_EQ(histogram.totalCount(), 1000);
+    ASSERT_EQ(histogram.distinctCount(), 1000);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesEqualityFromBucketDensity) {
+    auto values = std::vector<int>(900, 1);
+    auto rest = range(2, 102);
+    values.insert(values.end(), rest.begin(), rest.end());
+    auto histogram = buildHistogram(values, 10);
+
+    ASSERT_EQ(histogram.estimateEqual(BSON("" << 1).firstElement()), 900.0);
+    ASSERT_APPROX_EQUAL(histogram.estimateEqual(BSON("" << 50).firstElement()), 1.0, 0.01);
+    ASSERT_EQ(histogram.estimateEqual(BSON("" << 0).firstElement()), 0.0);
+    ASSERT_EQ(histogram.estimateEqual(BSON("" << 500).firstElement()), 0.0);
+    ASSERT_EQ(histogram.estimateEqual(BSON(""
+                                           << "1")
+                                          .firstElement()),
+              0.0);
+}
+
+TEST(EquiDepthHistogramTest, EstimatesRangesInEitherDirection) {
+    auto histogram = buildHistogram(range(0, 1000), 10);
+
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateInterval(makeInterval(BSON("" << 100 << "" << 300), true, false)),
+        200.0,
+        5.0);
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateInterval(makeInterval(BSON("" << 300 << "" << 100), false, true)),
+        200.0,
+        5.0);
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateInterval(makeInterval(BSON("" << 250 << "" << 260), true, true)),
+        11.0,
+        5.0);
+    ASSERT_EQ(
+        histogram.estimateInterval(makeInterval(BSON("" << MINKEY << "" << MAXKEY), true, true)),
+        1000.0);
+    ASSERT_EQ(
+        histogram.estimateInterval(makeInterval(BSON("" << 2000 << "" << 3000), true, true)), 0.0);
+}
+
+TEST(EquiDepthHistogramTest, MergesBucketsWhenInputExceedsExpectedCount) {
+    EquiDepthHistogramBuilder builder(4, 10);
+    for (int i = 0; i < 1000; ++i) {
+        builder.add(BSON("" << i).firstElement());
+    }
+    auto histogram = builder.done();
+
+    ASSERT_LTE(histogram.buckets().size(), 8U);
+    ASSERT_EQ(histogram.totalCount(), 1000);
+    ASSERT_EQ(histogram.distinctCount(), 1000);
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateInterval(makeInterval(BSON("" << 0 << "" << 500), true, false)),
+        500.0,
+        10.0);
+}
+
+TEST(EquiDepthHistogramTest, SerializationRoundTrips) {
+    auto histogram = buildHistogram(range(0, 100), 7);
+    BSONObjBuilder bob;
+    histogram.serialize(&bob);
+    auto serialized = bob.obj();
+
+    auto parsed = EquiDepthHistogram::parse(serialized);
+    BSONObjBuilder reserialized;
+    parsed.serialize(&reserialized);
+    ASSERT_BSONOBJ_EQ(serialized, reserialized.obj());
+    ASSERT_EQ(parsed.totalCount(), 100);
+}
+
+TEST(EquiDepthHistogramTest, ParseRejectsBucketsOutOfOrder) {
+    auto obj = fromjson(
+        "{min: 0, buckets: [{upper: 5, equal: 1, range: 1, rangeDistinct: 1},"
+        "{upper: 3, equal: 1, range: 0, rangeDistinct: 0}]}");
+    ASSERT_THROWS_CODE(EquiDepthHistogram::parse(obj), DBException, 5100005);
+}
+
+TEST(IndexStatisticsBuilderTest, CountsDistinctCompoundKeys) {
+    IndexStatisticsBuilder builder("a_1_b_1", BSON("a" << 1 << "b" << 1), true, 10, 6);
+    builder.addKey(BSON("" << 1 << "" << 1));
+    builder.addKey(BSON("" << 1 << "" << 1));
+    builder.addKey(BSON("" << 1 << "" << 2));
+    builder.addKey(BSON("" << 2 << "" << 1));
+    builder.addKey(BSON("" << 2 << "" << 1));
+    builder.addKey(BSON("" << 3 << "" << 1));
+    auto stats = builder.done();
+
+    ASSERT_EQ(stats.numKeys, 6);
+    ASSERT_EQ(stats.numDistinctKeys, 4);
+    ASSERT_EQ(stats.histogram.distinctCount(), 3);
+    ASSERT_EQ(stats.histogram.estimateEqual(BSON("" << 1).firstElement()), 3.0);
+}
+
+TEST(CollectionIndexStatisticsTest, SerializationRoundTrips) {
+    IndexStatisticsBuilder builder("a_1", BSON("a" << 1), true, 4, 20);
+    for (int i = 0; i < 20; ++i) {
+        builder.addKey(BSON("" << i / 2));
+    }
+    std::vector<IndexStatistics> indexes;
+    indexes.push_back(builder.done());
+    CollectionIndexStatistics stats(UUID::gen(), 20, Date_t::now(), std::move(indexes));
+
+    auto serialized = stats.toBSON("coll");
+    ASSERT_EQ(serialized["_id"].str(), "coll");
+
+    auto parsed = CollectionIndexStatistics::parse(serialized);
+    ASSERT_EQ(parsed.uuid(), stats.uuid());
+    ASSERT_EQ(parsed.numRecords(), 20);
+    ASSERT_BSONOBJ_EQ(parsed.toBSON("coll"), serialized);
+    ASSERT(parsed.getIndex("a_1"));
+    ASSERT_EQ(parsed.getIndex("a_1")->numDistinctKeys, 10);
+    ASSERT_FALSE(parsed.getIndex("b_1"));
+}
+
+TEST(CollectionIndexStatisticsTest, OnlyIndexesDescribingTheCollectionProvideHistograms) {
+    std::vector<IndexStatistics> indexes;
+    for (auto&& [name, keyPattern, describesCollection] :
+         {std::make_tuple("a_1_sparse", BSON("a" << 1), false),
+          std::make_tuple("b_1_c_1", BSON("b" << 1 << "c" << 1), true)}) {
+        IndexStatisticsBuilder builder(name, keyPattern, describesCollection, 4, 1);
+        builder.addKey(BSON("" << 1 << "" << 1));
+        indexes.push_back(builder.done());
+    }
+    CollectionIndexStatistics stats(UUID::gen(), 1, Date_t::now(), std::move(indexes));
+
+    ASSERT_FALSE(stats.getHistogramForPath("a"));
+    ASSERT(stats.getHistogramForPath("b"));
+    ASSERT_FALSE(stats.getHistogramForPath("c"));
+}
+
+TEST(IndexStatisticsCacheTest, LoadedStatisticsDoNotReplaceThoseLearnedFromAWrite) {
+    IndexStatisticsCache cache;
+    const NamespaceString nss("test.coll");
+    auto written = std::make_shared<const CollectionIndexStatistics>(
+        UUID::gen(), 1, Date_t::now(), std::vector<IndexStatistics>{});
+    ASSERT_FALSE(cache.lookup(nss));
+
+    // A load which started before the write read the statistics from an older snapshot.
+    const auto generation = cache.getGeneration();
+    cache.set(nss, written);
+    cache.insertLoaded(nss, nullptr, generation);
+    ASSERT_EQ(*cache.lookup(nss), written);
+
+    cache.set(nss, nullptr);
+    ASSERT(cache.lookup(nss));
+    ASSERT_FALSE(*cache.lookup(nss));
+}
+
+TEST(IndexStatisticsCacheTest, InvalidationDiscardsLoadsWhichStartedBeforeIt) {
+    IndexStatisticsCache cache;
+    const NamespaceString nss("test.coll");
+    const NamespaceString otherNss("other.coll");
+    cache.set(nss, nullptr);
+    cache.set(otherNss, nullptr);
+
+    const auto generation = cache.getGeneration();
+    cache.invalidateDatabase("test");
+    ASSERT_FALSE(cache.lookup(nss));
+    ASSERT(cache.lookup(otherNss));
+
+    cache.insertLoaded(nss, nullptr, generation);
+    ASSERT_FALSE(cache.lookup(nss));
+    cache.insertLoaded(nss, nullptr, cache.getGeneration());
+    ASSERT(cache.lookup(nss));
+
+    cache.invalidateAll();
+    ASSERT_FALSE(cache.lookup(nss));
+    ASSERT_FALSE(cache.lookup(otherNss));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -141,16 +141,13 @@ public:
             return Status(ErrorCodes::NoSuchKey, "no such key in LRU key-value store");
         }
         KVListIt found = i->second;
-        V* foundEntry = found->second;
 
         // Promote the kv-store entry to the front of the list.
-        // It is now the most recently used.
-        _kvMap.erase(i);
-        _kvList.erase(found);
-        _kvList.push_front(std::make_pair(key, foundEntry));
-        _kvMap[key] = _kvList.begin();
+        // It is now the most recently used. Moving the list node
+        // leaves the iterator held by '_kvMap' valid.
+        _kvList.splice(_kvList.begin(), _kvList, found);
 
-        *entryOut = foundEntry;
+        *entryOut = found->second;
         return Status::OK();
     }
 
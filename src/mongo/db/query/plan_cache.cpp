@@ -168,19 +168,26 @@ bool PlanCache::shouldCacheQuery(const CanonicalQuery& query) {
 // CachedSolution
 //
 
-CachedSolution::CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& entry)
-    : plannerData(entry.plannerData.size()),
+CachedSolution::CachedSolution(
+    const PlanCacheKey& key,
+    const std::vector<std::shared_ptr<const SolutionCacheData>>& plannerData,
+    const BSONObj& query,
+    const BSONObj& sort,
+    const BSONObj& projection,
+    const BSONObj& collation,
+    size_t decisionWorks)
+    : plannerData(plannerData.size()),
       key(key),
-      query(entry.query.getOwned()),
-      sort(entry.sort.getOwned()),
-      projection(entry.projection.getOwned()),
-      collation(entry.collation.getOwned()),
-      decisionWorks(entry.works) {
+      query(query.getOwned()),
+      sort(sort.getOwned()),
+      projection(projection.getOwned()),
+      collation(collation.getOwned()),
+      decisionWorks(decisionWorks) {
     // CachedSolution should not having any references into
     // cache entry. All relevant data should be cloned/copied.
-    for (size_t i = 0; i < entry.plannerData.size(); ++i) {
-        verify(entry.plannerData[i]);
-        plannerData[i] = entry.plannerData[i]->clone();
+    for (size_t i = 0; i < plannerData.size(); ++i) {
+        verify(plannerData[i]);
+        this->plannerData[i] = plannerData[i]->clone();
     }
 }
 
@@ -256,7 +263,8 @@ PlanCacheEntry::PlanCacheEntry(std::vector<std::unique_ptr<const SolutionCacheDa
                                std::unique_ptr<const plan_ranker::PlanRankingDecision> decision,
                                const bool isActive,
                                const size_t works)
-    : plannerData(std::move(plannerData)),
+    : plannerData(std::make_move_iterator(plannerData.begin()),
+                  std::make_move_iterator(plannerData.end())),
       query(query),
       sort(sort),
       projection(projection),
@@ -411,6 +419,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_SCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -423,9 +435,20 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : PlanCache(internalQueryCacheSize.load()) {}
+PlanCache::PlanCache()
+    : PlanCache(internalQueryCacheSize.load(), internalQueryPlanCacheNumShards.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size) : PlanCache(size, 1) {}
+
+PlanCache::PlanCache(size_t size, size_t numShards) {
+    invariant(numShards > 0);
+    // Round up so that the shards together never hold fewer entries than requested.
+    const size_t shardSize = (size + numShards - 1) / numShards;
+    _shards.reserve(numShards);
+    for (size_t i = 0; i < numShards; ++i) {
+        _shards.push_back(std::make_unique<Shard>(shardSize));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
@@ -560,6 +583,15 @@ Status PlanCache::set(const CanonicalQuery& query,
                       std::unique_ptr<plan_ranker::PlanRankingDecision> why,
                       Date_t now,
                       boost::optional<double> worksGrowthCoefficient) {
+    return set(computeKey(query), query, solns, std::move(why), now, worksGrowthCoefficient);
+}
+
+Status PlanCache::set(const PlanCacheKey& key,
+                      const CanonicalQuery& query,
+                      const std::vector<QuerySolution*>& solns,
+                      std::unique_ptr<plan_ranker::PlanRankingDecision> why,
+                      Date_t now,
+                      boost::optional<double> worksGrowthCoefficient) {
     invariant(why);
 
     if (solns.empty()) {
@@ -591,8 +623,8 @@ Status PlanCache::set(const CanonicalQuery& query,
                                  }},
 
         why->stats);
-    const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& shard = getShard(key);
+    stdx::lock_guard<Latch> cacheLock(shard.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
@@ -603,7 +635,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = shard.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -630,7 +662,7 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    std::unique_ptr<PlanCacheEntry> evictedEntry = shard.cache.add(key, newEntry.release());
 
     if (nullptr != evictedEntry.get()) {
         LOGV2_DEBUG(20942,
@@ -652,9 +684,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& shard = getShard(key);
+    stdx::lock_guard<Latch> cacheLock(shard.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = shard.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -669,44 +702,78 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
-    if (!cacheStatus.isOK()) {
-        invariant(cacheStatus == ErrorCodes::NoSuchKey);
-        return {CacheEntryState::kNotPresent, nullptr};
+    auto& shard = getShard(key);
+
+    // Only references to the entry's data are taken under the mutex. The deep copy of its planner
+    // data is made once the mutex is released, so that concurrent lookups of the same entry only
+    // serialize on the lookup itself.
+    std::vector<std::shared_ptr<const SolutionCacheData>> plannerData;
+    BSONObj query;
+    BSONObj sort;
+    BSONObj projection;
+    BSONObj collation;
+    size_t works;
+    bool isActive;
+    {
+        stdx::lock_guard<Latch> cacheLock(shard.mutex);
+        PlanCacheEntry* entry = nullptr;
+        Status cacheStatus = shard.cache.get(key, &entry);
+        if (!cacheStatus.isOK()) {
+            invariant(cacheStatus == ErrorCodes::NoSuchKey);
+            shard.misses.fetchAndAdd(1);
+            return {CacheEntryState::kNotPresent, nullptr};
+        }
+        invariant(entry);
+
+        plannerData = entry->plannerData;
+        query = entry->query;
+        sort = entry->sort;
+        projection = entry->projection;
+        collation = entry->collation;
+        works = entry->works;
+        isActive = entry->isActive;
     }
-    invariant(entry);
 
-    auto state =
-        entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
-    return {state, std::make_unique<CachedSolution>(key, *entry)};
+    (isActive ? shard.hits : shard.misses).fetchAndAdd(1);
+    return {isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive,
+            std::make_unique<CachedSolution>(
+                key, plannerData, query, sort, projection, collation, works)};
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    const auto key = computeKey(canonicalQuery);
+    auto& shard = getShard(key);
+    stdx::lock_guard<Latch> cacheLock(shard.mutex);
+    return shard.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> cacheLock(shard->mutex);
+        shard->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
+    return computeKey(cq, _indexabilityState);
+}
+
+PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq,
+                                   const PlanCacheIndexabilityState& indexabilityState) {
     const auto shapeString = cq.encodeKey();
 
     StringBuilder indexabilityKeyBuilder;
-    encodeIndexability(cq.root(), _indexabilityState, &indexabilityKeyBuilder);
+    encodeIndexability(cq.root(), indexabilityState, &indexabilityKeyBuilder);
     return PlanCacheKey(std::move(shapeString), indexabilityKeyBuilder.str());
 }
 
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
+    auto& shard = getShard(key);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    stdx::lock_guard<Latch> cacheLock(shard.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = shard.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -716,41 +783,78 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> cacheLock(shard->mutex);
+        for (auto&& cacheEntry : shard->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t total = 0;
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> cacheLock(shard->mutex);
+        total += shard->cache.size();
+    }
+    return total;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
     _indexabilityState.updateDiscriminators(indexCores);
 }
 
+std::vector<PlanCache::ShardStats> PlanCache::getShardStats() const {
+    std::vector<ShardStats> stats;
+    stats.reserve(_shards.size());
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        stdx::lock_guard<Latch> cacheLock(_shards[i]->mutex);
+        stats.push_back(_shards[i]->getStats(i));
+    }
+    return stats;
+}
+
 std::vector<BSONObj> PlanCache::getMatchingStats(
-    const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
+    const std::function<BSONObj(const PlanCacheEntry&, const ShardStats&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        const auto& shard = *_shards[i];
+        stdx::lock_guard<Latch> cacheLock(shard.mutex);
+        const auto shardStats = shard.getStats(i);
+
+        for (auto&& cacheEntry : shard.cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry, shardStats);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
     return results;
 }
 
+PlanCache::ShardStats PlanCache::Shard::getStats(size_t shardId) const {
+    ShardStats stats;
+    stats.shardId = shardId;
+    stats.hits = hits.load();
+    stats.misses = misses.load();
+    stats.numEntries = cache.size();
+    return stats;
+}
+
+PlanCache::Shard& PlanCache::getShard(const PlanCacheKey& key) const {
+    if (_shards.size() == 1) {
+        return *_shards.front();
+    }
+    return *_shards[PlanCacheKeyHasher{}(key) % _shards.size()];
+}
+
 }  // namespace mongo
@@ -250,6 +250,10 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // The plan skip scans the index stored in 'tree'
+        // on the query's predicates over its second field.
+        SKIP_SCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -275,7 +279,17 @@ private:
     CachedSolution& operator=(const CachedSolution&) = delete;
 
 public:
-    CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& entry);
+    /**
+     * Deep copies 'plannerData', which is shared with the plan cache entry the solution is taken
+     * from, along with the rest of the entry's data.
+     */
+    CachedSolution(const PlanCacheKey& key,
+                   const std::vector<std::shared_ptr<const SolutionCacheData>>& plannerData,
+                   const BSONObj& query,
+                   const BSONObj& sort,
+                   const BSONObj& projection,
+                   const BSONObj& collation,
+                   size_t decisionWorks);
     ~CachedSolution();
 
     // Owned here.
@@ -336,9 +350,10 @@ public:
     //
 
     // Data provided to the planner to allow it to recreate the solutions this entry
-    // represents. Each SolutionCacheData is fully owned here, so in order to return
-    // it from the cache a deep copy is made and returned inside CachedSolution.
-    const std::vector<std::unique_ptr<const SolutionCacheData>> plannerData;
+    // represents. Each SolutionCacheData is immutable, and is shared with lookups of the entry so
+    // that they can make the deep copy returned inside CachedSolution without holding the cache's
+    // mutex.
+    const std::vector<std::shared_ptr<const SolutionCacheData>> plannerData;
 
     // TODO: Do we really want to just hold a copy of the CanonicalQuery?  For now we just
     // extract the data we need.
@@ -445,6 +460,17 @@ public:
         std::unique_ptr<CachedSolution> cachedSolution;
     };
 
+    /**
+     * A point-in-time snapshot of the counters kept by one shard of the cache. A lookup through
+     * get() counts as a hit when it finds an active entry, and as a miss otherwise.
+     */
+    struct ShardStats {
+        size_t shardId = 0;
+        long long hits = 0;
+        long long misses = 0;
+        size_t numEntries = 0;
+    };
+
     /**
      * We don't want to cache every possible query. This function
      * encapsulates the criteria for what makes a canonical query
@@ -459,6 +485,13 @@ public:
 
     PlanCache(size_t size);
 
+    /**
+     * Splits the cache into 'numShards' independently locked LRU partitions which together hold
+     * at most roughly 'size' entries. Each key always maps to the same shard, so operations on
+     * different query shapes only contend when their keys hash to the same shard.
+     */
+    PlanCache(size_t size, size_t numShards);
+
     ~PlanCache();
 
     /**
@@ -481,6 +514,17 @@ public:
                Date_t now,
                boost::optional<double> worksGrowthCoefficient = boost::none);
 
+    /**
+     * Same as above, but records the solutions under 'key' rather than the key computed from
+     * 'query'. Used by caches whose keys carry more than the query shape.
+     */
+    Status set(const PlanCacheKey& key,
+               const CanonicalQuery& query,
+               const std::vector<QuerySolution*>& solns,
+               std::unique_ptr<plan_ranker::PlanRankingDecision> why,
+               Date_t now,
+               boost::optional<double> worksGrowthCoefficient = boost::none);
+
     /**
      * Set a cache entry back to the 'inactive' state. Rather than completely evicting an entry
      * when the associated plan starts to perform poorly, we deactivate it, so that plans which
@@ -534,6 +578,13 @@ public:
      */
     PlanCacheKey computeKey(const CanonicalQuery&) const;
 
+    /**
+     * Computes the cache key of the given canonical query over the indexes described by
+     * 'indexabilityState', rather than over those of the collection this cache belongs to.
+     */
+    static PlanCacheKey computeKey(const CanonicalQuery& cq,
+                                   const PlanCacheIndexabilityState& indexabilityState);
+
     /**
      * Returns a copy of a cache entry, looked up by CanonicalQuery.
      *
@@ -561,12 +612,25 @@ public:
      */
     void notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores);
 
+    /**
+     * Returns the number of independently locked shards the cache is split into.
+     */
+    size_t numShards() const {
+        return _shards.size();
+    }
+
+    /**
+     * Returns the hit and miss counters of every shard, ordered by shard id.
+     */
+    std::vector<ShardStats> getShardStats() const;
+
     /**
      * Iterates over the plan cache. For each entry, serializes the PlanCacheEntry according to
-     * 'serializationFunc'. Returns a vector of all serialized entries which match 'filterFunc'.
+     * 'serializationFunc', which is also handed the counters of the shard holding the entry.
+     * Returns a vector of all serialized entries which match 'filterFunc'.
      */
     std::vector<BSONObj> getMatchingStats(
-        const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
+        const std::function<BSONObj(const PlanCacheEntry&, const ShardStats&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
 private:
@@ -582,10 +646,31 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    /**
+     * One partition of the cache. Each shard runs its own LRU eviction over the keys which hash to
+     * it, so the cache as a whole only approximates a global LRU policy.
+     */
+    struct Shard {
+        explicit Shard(size_t maxSize) : cache(maxSize) {}
+
+        // Callers must hold 'mutex'.
+        ShardStats getStats(size_t shardId) const;
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // Protects 'cache'. Lookups also take this mutex since they update the LRU order, but hold
+        // it only to find the entry and take references to its immutable data.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Shard::mutex");
+
+        // Lookup outcomes of get(). They are atomic so that they may be updated and read without
+        // holding 'mutex'.
+        mutable AtomicWord<long long> hits{0};
+        mutable AtomicWord<long long> misses{0};
+    };
+
+    Shard& getShard(const PlanCacheKey& key) const;
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Shard>> _shards;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.collection");
+const int kMaxPerfThreads = 16;
+const int kNumShapes = kMaxPerfThreads;
+
+std::unique_ptr<CanonicalQuery> canonicalize(OperationContext* opCtx, BSONObj filter) {
+    auto qr = std::make_unique<QueryRequest>(kNss);
+    qr->setFilter(filter);
+    return unittest::assertGet(
+        CanonicalQuery::canonicalize(opCtx,
+                                     std::move(qr),
+                                     nullptr,
+                                     ExtensionsCallbackNoop(),
+                                     MatchExpressionParser::kAllowAllSpecialFeatures));
+}
+
+std::unique_ptr<plan_ranker::PlanRankingDecision> createDecision() {
+    auto why = std::make_unique<plan_ranker::PlanRankingDecision>();
+    std::vector<std::unique_ptr<PlanStageStats>> stats;
+    auto stat = std::make_unique<PlanStageStats>(CommonStats("IXSCAN"), STAGE_IXSCAN);
+    stat->specific.reset(new IndexScanStats());
+    stats.push_back(std::move(stat));
+    why->scores.push_back(0U);
+    why->candidateOrder.push_back(0);
+    why->getStats<PlanStageStats>() = std::move(stats);
+    return why;
+}
+
+/**
+ * A plan cache holding an active entry for each of 'kNumShapes' query shapes, each with a plan
+ * over a compound index.
+ */
+class PlanCacheBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        if (state.thread_index != 0) {
+            return;
+        }
+
+        _serviceContext = std::make_unique<QueryTestServiceContext>();
+        auto opCtx = _serviceContext->makeOperationContext();
+        _cache = std::make_unique<PlanCache>(5000, kNumShapes);
+
+        IndexEntry index(BSON("a" << 1 << "b" << 1 << "c" << 1),
+                         IndexType::INDEX_BTREE,
+                         false,
+                         {},
+                         {},
+                         false,
+                         false,
+                         IndexEntry::Identifier{"a_1_b_1_c_1"},
+                         nullptr,
+                         BSONObj(),
+                         nullptr,
+                         nullptr);
+        for (int i = 0; i < kNumShapes; ++i) {
+            // Each shape filters on a field of its own as well as on the indexed fields.
+            BSONObjBuilder filter;
+            filter.append("a", 1);
+            filter.append("b", 1);
+            filter.append("c", 1);
+            filter.append("f" + std::to_string(i), 1);
+            auto query = canonicalize(opCtx.get(), filter.obj());
+
+            QuerySolution solution;
+            solution.cacheData = std::make_unique<SolutionCacheData>();
+            solution.cacheData->tree = std::make_unique<PlanCacheIndexTree>();
+            solution.cacheData->tree->setIndexEntry(index);
+
+            // The first entry for a shape is inactive. Recording it again activates it.
+            for (int j = 0; j < 2; ++j) {
+                uassertStatusOK(_cache->set(*query, {&solution}, createDecision(), Date_t{}));
+            }
+            _keys.push_back(_cache->computeKey(*query));
+        }
+    }
+
+    void TearDown(benchmark::State& state) override {
+        if (state.thread_index != 0) {
+            return;
+        }
+
+        _keys.clear();
+        _cache.reset();
+        _serviceContext.reset();
+    }
+
+protected:
+    std::unique_ptr<QueryTestServiceContext> _serviceContext;
+    std::unique_ptr<PlanCache> _cache;
+    std::vector<PlanCacheKey> _keys;
+};
+
+// Every thread looks up the same entry.
+BENCHMARK_DEFINE_F(PlanCacheBenchmark, BM_GetSameShape)(benchmark::State& state) {
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(_cache->getCacheEntryIfActive(_keys[0]));
+    }
+}
+
+// Every thread looks up an entry of its own, which usually lives in a shard of its own.
+BENCHMARK_DEFINE_F(PlanCacheBenchmark, BM_GetDistinctShapes)(benchmark::State& state) {
+    const auto& key = _keys[state.thread_index % kNumShapes];
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(_cache->getCacheEntryIfActive(key));
+    }
+}
+
+BENCHMARK_REGISTER_F(PlanCacheBenchmark, BM_GetSameShape)->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(PlanCacheBenchmark, BM_GetDistinctShapes)->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
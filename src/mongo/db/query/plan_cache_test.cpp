@@ -849,7 +849,7 @@ TEST(PlanCacheTest, GetMatchingStatsMatchesAndSerializesCorrectly) {
     ASSERT_EQ(2U, planCache.size());
 
     // Define a serialization function which just serializes the number of works.
-    const auto serializer = [](const PlanCacheEntry& entry) {
+    const auto serializer = [](const PlanCacheEntry& entry, const PlanCache::ShardStats&) {
         return BSON("works" << static_cast<int>(entry.works));
     };
 
@@ -865,6 +865,83 @@ TEST(PlanCacheTest, GetMatchingStatsMatchesAndSerializesCorrectly) {
     ASSERT_BSONOBJ_EQ(BSON("works" << 5), getStatsResult[0]);
 }
 
+TEST(PlanCacheTest, ShardedCacheSpreadsEntriesAcrossShards) {
+    const size_t kNumShards = 4;
+    PlanCache planCache(5000, kNumShards);
+    ASSERT_EQ(kNumShards, planCache.numShards());
+
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (auto&& query : {"{a: 1}", "{b: 1}", "{c: 1}", "{d: 1}", "{e: 1}", "{f: 1}", "{g: 1}"}) {
+        queries.push_back(canonicalize(query));
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+    ASSERT_EQ(queries.size(), planCache.size());
+    ASSERT_EQ(queries.size(), planCache.getAllEntries().size());
+
+    // Every shape is found again, whichever shard it landed in.
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+
+    size_t totalEntries = 0;
+    auto shardStats = planCache.getShardStats();
+    ASSERT_EQ(kNumShards, shardStats.size());
+    for (size_t i = 0; i < shardStats.size(); ++i) {
+        ASSERT_EQ(i, shardStats[i].shardId);
+        totalEntries += shardStats[i].numEntries;
+    }
+    ASSERT_EQ(queries.size(), totalEntries);
+
+    ASSERT_OK(planCache.remove(*queries.front()));
+    ASSERT_EQ(planCache.get(*queries.front()).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(queries.size() - 1, planCache.size());
+
+    planCache.clear();
+    ASSERT_EQ(0U, planCache.size());
+}
+
+TEST(PlanCacheTest, ShardStatsCountHitsAndMisses) {
+    PlanCache planCache(5000, 2);
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+
+    const auto sumStats = [&]() {
+        PlanCache::ShardStats total;
+        for (auto&& stats : planCache.getShardStats()) {
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+        }
+        return total;
+    };
+
+    // A lookup which finds nothing is a miss.
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(0, sumStats().hits);
+    ASSERT_EQ(1, sumStats().misses);
+
+    // An inactive entry cannot be used for planning, so finding it is a miss as well.
+    addCacheEntryForShape(*cq, &planCache);
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(0, sumStats().hits);
+    ASSERT_EQ(2, sumStats().misses);
+
+    // Adding the entry a second time activates it.
+    addCacheEntryForShape(*cq, &planCache);
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentActive);
+    ASSERT_EQ(1, sumStats().hits);
+    ASSERT_EQ(2, sumStats().misses);
+
+    // The counters are reported alongside each entry by getMatchingStats().
+    const auto serializer = [](const PlanCacheEntry&, const PlanCache::ShardStats& stats) {
+        return BSON("hits" << stats.hits << "misses" << stats.misses << "numEntries"
+                           << static_cast<long long>(stats.numEntries));
+    };
+    auto getStatsResult =
+        planCache.getMatchingStats(serializer, [](const BSONObj&) { return true; });
+    ASSERT_EQ(1U, getStatsResult.size());
+    ASSERT_BSONOBJ_EQ(BSON("hits" << 1LL << "misses" << 2LL << "numEntries" << 1LL),
+                      getStatsResult[0]);
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
@@ -1139,7 +1216,13 @@ protected:
         uint32_t planCacheKey = queryHash;
         auto entry = PlanCacheEntry::create(
             solutions, createDecision(1U), *scopedCq, queryHash, planCacheKey, Date_t(), false, 0);
-        CachedSolution cachedSoln(ck, *entry);
+        CachedSolution cachedSoln(ck,
+                                  entry->plannerData,
+                                  entry->query,
+                                  entry->sort,
+                                  entry->projection,
+                                  entry->collation,
+                                  entry->works);
 
         auto statusWithQs = QueryPlanner::planFromCache(*scopedCq, params, cachedSoln);
         ASSERT_OK(statusWithQs.getStatus());
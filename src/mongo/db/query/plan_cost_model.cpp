@@ -0,0 +1,450 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/interval.h"
+
+namespace mongo {
+namespace plan_cost_model {
+
+namespace {
+
+// The relative costs of the units of work done by a plan. Fetching a document costs more than
+// reading one in a collection scan because the reads are not sequential.
+constexpr double kIndexKeyCost = 0.5;
+constexpr double kCollectionScanDocumentCost = 1.0;
+constexpr double kFetchDocumentCost = 2.0;
+constexpr double kSortComparisonCost = 0.1;
+
+// Selectivities assumed for predicates on fields which have no histogram.
+constexpr double kDefaultEqualitySelectivity = 0.1;
+constexpr double kDefaultSelectivity = 1.0 / 3.0;
+
+struct Estimate {
+    // Work done before the first result is produced, for example by a blocking sort.
+    double startupCost = 0;
+
+    // Work done while producing the results.
+    double runCost = 0;
+
+    double numResults = 0;
+};
+
+struct EstimationContext {
+    const CollectionIndexStatistics& stats;
+    const CollatorInterface* collator;
+    double numRecords;
+
+    // Scales counts taken from the statistics to the current size of the collection.
+    double growth;
+};
+
+bool isCollationSensitive(const BSONElement& value) {
+    return value.type() == String || value.type() == Object || value.type() == Array;
+}
+
+double comparisonSelectivity(const ComparisonMatchExpressionBase& expr,
+                             const CollectionIndexStatistics& stats,
+                             const CollatorInterface* collator) {
+    const bool isEquality = expr.matchType() == MatchExpression::EQ;
+    const auto& value = expr.getData();
+    const auto* histogram = stats.getHistogramForPath(expr.path());
+    if (!histogram || histogram->totalCount() == 0 || (collator && isCollationSensitive(value))) {
+        return isEquality ? kDefaultEqualitySelectivity : kDefaultSelectivity;
+    }
+
+    const double total = histogram->totalCount();
+    if (isEquality) {
+        return histogram->estimateEqual(value) / total;
+    }
+
+    // Comparisons only match values of the same canonical type, so bound the other end of the
+    // interval by the smallest or largest value of that type.
+    BSONObjBuilder bob;
+    bool startInclusive = true;
+    bool endInclusive = true;
+    switch (expr.matchType()) {
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+            bob.appendMinForType("", value.type());
+            bob.appendAs(value, "");
+            endInclusive = expr.matchType() == MatchExpression::LTE;
+            break;
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            bob.appendAs(value, "");
+            bob.appendMaxForType("", value.type());
+            startInclusive = expr.matchType() == MatchExpression::GTE;
+            break;
+        default:
+            return kDefaultSelectivity;
+    }
+    return histogram->estimateInterval(Interval(bob.obj(), startInclusive, endInclusive)) / total;
+}
+
+double inSelectivity(const InMatchExpression& expr,
+                     const CollectionIndexStatistics& stats,
+                     const CollatorInterface* collator) {
+    const auto* histogram = stats.getHistogramForPath(expr.path());
+    double selectivity = expr.getRegexes().size() * kDefaultSelectivity;
+    for (auto&& equality : expr.getEqualities()) {
+        if (!histogram || histogram->totalCount() == 0 ||
+            (collator && isCollationSensitive(equality))) {
+            selectivity += kDefaultEqualitySelectivity;
+        } else {
+            selectivity += histogram->estimateEqual(equality) / histogram->totalCount();
+        }
+    }
+    return std::min(1.0, selectivity);
+}
+
+/**
+ * Estimates the number of keys within 'oil', as a fraction of all the values described by
+ * 'histogram'.
+ */
+double intervalListSelectivity(const OrderedIntervalList& oil,
+                               const EquiDepthHistogram& histogram) {
+    double count = 0;
+    for (auto&& interval : oil.intervals) {
+        count += histogram.estimateInterval(interval);
+    }
+    return std::min(1.0, count / histogram.totalCount());
+}
+
+bool allPoints(const OrderedIntervalList& oil) {
+    return std::all_of(oil.intervals.begin(), oil.intervals.end(), [](const Interval& interval) {
+        return interval.isPoint();
+    });
+}
+
+bool isUnconstrained(const OrderedIntervalList& oil) {
+    return oil.intervals.size() == 1 &&
+        (oil.intervals[0].isMinToMax() || oil.intervals[0].isMaxToMin());
+}
+
+/**
+ * Estimates the number of keys examined by 'node'. The histogram of the index describes the first
+ * field of its key pattern. Bounds on later fields only narrow the scan while every earlier field
+ * is bounded to points, and they are costed from the histograms of other indexes, assuming that
+ * fields are independent.
+ */
+boost::optional<double> estimateKeysExamined(const IndexScanNode& node,
+                                             const EstimationContext& ctx) {
+    const auto* indexStats = ctx.stats.getIndex(node.index.identifier.catalogName);
+    if (!indexStats ||
+        !SimpleBSONObjComparator::kInstance.evaluate(indexStats->keyPattern ==
+                                                     node.index.keyPattern)) {
+        return boost::none;
+    }
+
+    const auto& histogram = indexStats->histogram;
+    if (histogram.empty()) {
+        return 0.0;
+    }
+
+    const auto& bounds = node.bounds;
+    if (bounds.isSimpleRange) {
+        BSONObjBuilder bob;
+        bob.appendAs(bounds.startKey.firstElement(), "");
+        bob.appendAs(bounds.endKey.firstElement(), "");
+        Interval interval(bob.obj(),
+                          IndexBounds::isStartIncludedInBound(bounds.boundInclusion),
+                          IndexBounds::isEndIncludedInBound(bounds.boundInclusion));
+        return histogram.estimateInterval(interval) * ctx.growth;
+    }
+
+    if (bounds.fields.empty()) {
+        return boost::none;
+    }
+
+    // Bounds which leave the first field unconstrained but restrict the second make the scan seek
+    // past the keys outside them, once for every distinct value of the first field.
+    if (bounds.fields.size() > 1 && isUnconstrained(bounds.fields[0]) &&
+        !isUnconstrained(bounds.fields[1])) {
+        const auto& oil = bounds.fields[1];
+        double selectivity = kDefaultSelectivity;
+        if (auto fieldHistogram = ctx.stats.getHistogramForPath(oil.name);
+            fieldHistogram && fieldHistogram->totalCount() > 0) {
+            selectivity = intervalListSelectivity(oil, *fieldHistogram);
+        } else if (allPoints(oil)) {
+            selectivity = kDefaultEqualitySelectivity;
+        }
+        return (histogram.totalCount() * selectivity + histogram.distinctCount()) * ctx.growth;
+    }
+
+    double keys = 0;
+    for (auto&& interval : bounds.fields[0].intervals) {
+        keys += histogram.estimateInterval(interval);
+    }
+
+    bool pointsSoFar = allPoints(bounds.fields[0]);
+    double numPoints = bounds.fields[0].intervals.size();
+    size_t field = 1;
+    for (; field < bounds.fields.size() && pointsSoFar; ++field) {
+        const auto& oil = bounds.fields[field];
+        if (isUnconstrained(oil)) {
+            break;
+        }
+        pointsSoFar = allPoints(oil);
+        numPoints *= oil.intervals.size();
+
+        if (auto fieldHistogram = ctx.stats.getHistogramForPath(oil.name);
+            fieldHistogram && fieldHistogram->totalCount() > 0) {
+            keys *= intervalListSelectivity(oil, *fieldHistogram);
+        } else {
+            keys *= pointsSoFar ? kDefaultEqualitySelectivity : kDefaultSelectivity;
+        }
+    }
+
+    // A scan for whole keys finds, on average, the number of copies of each distinct key.
+    if (pointsSoFar && field == bounds.fields.size() && indexStats->numDistinctKeys > 0) {
+        keys = std::min(keys, numPoints * indexStats->numKeys / indexStats->numDistinctKeys);
+    }
+    return keys * ctx.growth;
+}
+
+boost::optional<Estimate> estimate(const QuerySolutionNode* node, const EstimationContext& ctx) {
+    auto filterSelectivity = [&] {
+        return estimateSelectivity(node->filter.get(), ctx.stats, ctx.collator);
+    };
+
+    auto estimateChildren = [&]() -> boost::optional<std::vector<Estimate>> {
+        std::vector<Estimate> estimates;
+        for (auto&& child : node->children) {
+            auto childEstimate = estimate(child, ctx);
+            if (!childEstimate) {
+                return boost::none;
+            }
+            estimates.push_back(*childEstimate);
+        }
+        return estimates;
+    };
+
+    switch (node->getType()) {
+        case STAGE_COLLSCAN: {
+            Estimate result;
+            result.runCost = std::max(ctx.numRecords, 1.0) * kCollectionScanDocumentCost;
+            result.numResults = ctx.numRecords * filterSelectivity();
+            return result;
+        }
+        case STAGE_IXSCAN: {
+            auto keys = estimateKeysExamined(static_cast<const IndexScanNode&>(*node), ctx);
+            if (!keys) {
+                return boost::none;
+            }
+            // Every scan examines at least one key and is assumed to produce at least one result,
+            // even if the statistics suggest that it is empty: values outside of the histogram may
+            // have been written since it was built.
+            Estimate result;
+            result.runCost = std::max(*keys, 1.0) * kIndexKeyCost;
+            result.numResults = std::max(*keys * filterSelectivity(), 1.0);
+            return result;
+        }
+        case STAGE_FETCH: {
+            auto result = estimate(node->children[0], ctx);
+            if (result) {
+                result->runCost += result->numResults * kFetchDocumentCost;
+                result->numResults *= filterSelectivity();
+            }
+            return result;
+        }
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_SIMPLE: {
+            auto result = estimate(node->children[0], ctx);
+            if (result) {
+                // The sort consumes its whole input before producing any results.
+                const double n = result->numResults;
+                result->startupCost +=
+                    result->runCost + n * std::log2(std::max(n, 2.0)) * kSortComparisonCost;
+                result->runCost = 0;
+
+                const auto limit = static_cast<const SortNode*>(node)->limit;
+                if (limit > 0) {
+                    result->numResults = std::min(n, static_cast<double>(limit));
+                }
+            }
+            return result;
+        }
+        case STAGE_LIMIT: {
+            auto result = estimate(node->children[0], ctx);
+            const double limit = static_cast<const LimitNode*>(node)->limit;
+            if (result && result->numResults > limit) {
+                // Only the work needed to produce the first 'limit' results is done.
+                result->runCost *= limit / result->numResults;
+                result->numResults = limit;
+            }
+            return result;
+        }
+        case STAGE_OR:
+        case STAGE_SORT_MERGE:
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            auto children = estimateChildren();
+            if (!children) {
+                return boost::none;
+            }
+
+            const bool isUnion = node->getType() == STAGE_OR || node->getType() == STAGE_SORT_MERGE;
+            Estimate result;
+            result.numResults = isUnion ? 0 : ctx.numRecords;
+            for (auto&& child : *children) {
+                result.startupCost += child.startupCost;
+                result.runCost += child.runCost;
+                if (isUnion) {
+                    result.numResults += child.numResults;
+                } else if (ctx.numRecords > 0) {
+                    result.numResults *= std::min(1.0, child.numResults / ctx.numRecords);
+                }
+            }
+            result.numResults = std::min(result.numResults, ctx.numRecords) * filterSelectivity();
+
+            // A hash intersection reads all of its inputs before producing results.
+            if (node->getType() == STAGE_AND_HASH) {
+                result.startupCost += result.runCost;
+                result.runCost = 0;
+            }
+            return result;
+        }
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_SORT_KEY_GENERATOR:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_RETURN_KEY:
+        case STAGE_ENSURE_SORTED:
+        case STAGE_SKIP:
+            return estimate(node->children[0], ctx);
+        default:
+            return boost::none;
+    }
+}
+
+}  // namespace
+
+double estimateSelectivity(const MatchExpression* expr,
+                           const CollectionIndexStatistics& stats,
+                           const CollatorInterface* collator) {
+    if (!expr) {
+        return 1.0;
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND: {
+            double selectivity = 1.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                selectivity *= estimateSelectivity(expr->getChild(i), stats, collator);
+            }
+            return selectivity;
+        }
+        case MatchExpression::OR:
+        case MatchExpression::NOR: {
+            double noneMatch = 1.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                noneMatch *= 1.0 - estimateSelectivity(expr->getChild(i), stats, collator);
+            }
+            return expr->matchType() == MatchExpression::OR ? 1.0 - noneMatch : noneMatch;
+        }
+        case MatchExpression::NOT:
+            return 1.0 - estimateSelectivity(expr->getChild(0), stats, collator);
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return comparisonSelectivity(
+                static_cast<const ComparisonMatchExpressionBase&>(*expr), stats, collator);
+        case MatchExpression::MATCH_IN:
+            return inSelectivity(static_cast<const InMatchExpression&>(*expr), stats, collator);
+        default:
+            return kDefaultSelectivity;
+    }
+}
+
+boost::optional<double> estimateCost(const QuerySolution& solution,
+                                     const CollectionIndexStatistics& stats,
+                                     long long numRecords,
+                                     const CollatorInterface* collator) {
+    const double growth =
+        stats.numRecords() > 0 ? static_cast<double>(numRecords) / stats.numRecords() : 1.0;
+    EstimationContext ctx{stats, collator, static_cast<double>(numRecords), growth};
+
+    auto result = estimate(solution.root.get(), ctx);
+    if (!result) {
+        return boost::none;
+    }
+    return result->startupCost + result->runCost;
+}
+
+size_t pruneCandidates(const CollectionIndexStatistics& stats,
+                       long long numRecords,
+                       const CollatorInterface* collator,
+                       double pruningRatio,
+                       std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    std::vector<double> costs;
+    for (auto&& solution : *solutions) {
+        auto cost = estimateCost(*solution, stats, numRecords, collator);
+        if (!cost) {
+            return 0;
+        }
+        costs.push_back(*cost);
+    }
+    if (costs.empty()) {
+        return 0;
+    }
+
+    // A plan estimated to do no work at all gives no meaningful scale to compare the others to.
+    const double minCost = *std::min_element(costs.begin(), costs.end());
+    if (minCost <= 0) {
+        return 0;
+    }
+
+    const double maxCost = minCost * pruningRatio;
+    std::vector<std::unique_ptr<QuerySolution>> kept;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        if (costs[i] <= maxCost) {
+            kept.push_back(std::move((*solutions)[i]));
+        }
+    }
+
+    const size_t numPruned = solutions->size() - kept.size();
+    *solutions = std::move(kept);
+    return numPruned;
+}
+
+}  // namespace plan_cost_model
+}  // namespace mongo
@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+class CollatorInterface;
+class MatchExpression;
+
+/**
+ * Estimates the cost of candidate plans from the index statistics collected by the 'analyze'
+ * command, so that plans which are clearly worse than another candidate need not be run during
+ * multi-planning.
+ */
+namespace plan_cost_model {
+
+/**
+ * Estimates the fraction of the documents in the collection which match 'expr'. Predicates on
+ * fields without a histogram are given a default selectivity.
+ */
+double estimateSelectivity(const MatchExpression* expr,
+                           const CollectionIndexStatistics& stats,
+                           const CollatorInterface* collator);
+
+/**
+ * Estimates the cost, in abstract units of work, of executing 'solution' against the collection
+ * described by 'stats', which currently holds 'numRecords' documents. Returns boost::none if the
+ * solution contains a stage which cannot be costed, or scans an index with no statistics.
+ */
+boost::optional<double> estimateCost(const QuerySolution& solution,
+                                     const CollectionIndexStatistics& stats,
+                                     long long numRecords,
+                                     const CollatorInterface* collator);
+
+/**
+ * Discards the candidates in 'solutions' whose estimated cost is more than 'pruningRatio' times
+ * that of the cheapest candidate. Leaves 'solutions' unchanged unless every candidate can be
+ * costed and the cheapest has a positive cost. Returns the number of candidates discarded.
+ */
+size_t pruneCandidates(const CollectionIndexStatistics& stats,
+                       long long numRecords,
+                       const CollatorInterface* collator,
+                       double pruningRatio,
+                       std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
+}  // namespace plan_cost_model
+}  // namespace mongo
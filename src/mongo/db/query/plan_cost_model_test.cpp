@@ -0,0 +1,201 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_model.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const long long kNumRecords = 10000;
+
+class PlanCostModelTest : public QueryPlannerTest {
+protected:
+    void addNamedIndex(BSONObj keyPattern, std::string name) {
+        addIndex(IndexEntry(keyPattern,
+                            IndexType::INDEX_BTREE,
+                            false,
+                            {},
+                            {},
+                            false,
+                            false,
+                            IndexEntry::Identifier{std::move(name)},
+                            nullptr,
+                            {},
+                            nullptr,
+                            nullptr));
+    }
+
+    /**
+     * Returns statistics for an index on a single field, whose value in the i'th document is
+     * 'valueOf(i)'.
+     */
+    template <typename ValueFn>
+    static IndexStatistics makeIndexStatistics(std::string name,
+                                               BSONObj keyPattern,
+                                               ValueFn valueOf) {
+        std::vector<int> values;
+        for (long long i = 0; i < kNumRecords; ++i) {
+            values.push_back(valueOf(i));
+        }
+        std::sort(values.begin(), values.end());
+
+        IndexStatisticsBuilder builder(std::move(name), keyPattern, true, 100, kNumRecords);
+        for (auto value : values) {
+            builder.addKey(BSON("" << value));
+        }
+        return builder.done();
+    }
+
+    CollectionIndexStatistics makeStatistics() {
+        std::vector<IndexStatistics> indexes;
+        indexes.push_back(
+            makeIndexStatistics("a_1", BSON("a" << 1), [](auto i) { return i % 1000; }));
+        indexes.push_back(
+            makeIndexStatistics("b_1", BSON("b" << 1), [](auto i) { return 7 + i % 2; }));
+        return {UUID::gen(), kNumRecords, Date_t::now(), std::move(indexes)};
+    }
+};
+
+TEST_F(PlanCostModelTest, PrunesPlansScanningUnselectiveIndexes) {
+    addNamedIndex(BSON("a" << 1), "a_1");
+    addNamedIndex(BSON("b" << 1), "b_1");
+    runQuery(fromjson("{a: 5, b: 7}"));
+    ASSERT_GT(getNumSolutions(), 2U);
+
+    const auto numCandidates = getNumSolutions();
+    auto numPruned =
+        plan_cost_model::pruneCandidates(makeStatistics(), kNumRecords, nullptr, 10.0, &solns);
+    ASSERT_EQ(numPruned, numCandidates - 1);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 7}, node: {ixscan: {filter: null, pattern: {a: 1}}}}}");
+}
+
+TEST_F(PlanCostModelTest, KeepsPlansOfSimilarCost) {
+    addNamedIndex(BSON("a" << 1), "a_1");
+    addNamedIndex(BSON("b" << 1), "b_1");
+    runQuery(fromjson("{a: {$lt: 500}, b: 7}"));
+
+    const auto numCandidates = getNumSolutions();
+    auto numPruned =
+        plan_cost_model::pruneCandidates(makeStatistics(), kNumRecords, nullptr, 10.0, &solns);
+    ASSERT_LT(numPruned, numCandidates - 1);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 7}, node: {ixscan: {filter: null, pattern: {a: 1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a: {$lt: 500}}, node: {ixscan: {filter: null, pattern: {b: 1}}}}}");
+}
+
+TEST_F(PlanCostModelTest, DoesNotPruneWhenAnIndexHasNoStatistics) {
+    addNamedIndex(BSON("a" << 1), "a_1");
+    addNamedIndex(BSON("c" << 1), "c_1");
+    runQuery(fromjson("{a: 5, c: 7}"));
+
+    const auto numCandidates = getNumSolutions();
+    auto numPruned =
+        plan_cost_model::pruneCandidates(makeStatistics(), kNumRecords, nullptr, 10.0, &solns);
+    ASSERT_EQ(numPruned, 0U);
+    ASSERT_EQ(getNumSolutions(), numCandidates);
+}
+
+TEST_F(PlanCostModelTest, DoesNotTrustEmptyEstimatesForValuesOutsideTheHistogram) {
+    addNamedIndex(BSON("a" << 1), "a_1");
+    addNamedIndex(BSON("c" << 1), "c_1");
+    runQuery(fromjson("{a: 5000, c: 5}"));
+
+    // The histogram of 'a' ends at 999, so the scan of a_1 is estimated to find nothing. It must
+    // still be assumed to fetch a document, or the scan of the unique c_1 would look far costlier.
+    std::vector<IndexStatistics> indexes;
+    indexes.push_back(
+        makeIndexStatistics("a_1", BSON("a" << 1), [](auto i) { return i % 1000; }));
+    indexes.push_back(makeIndexStatistics("c_1", BSON("c" << 1), [](auto i) { return i; }));
+    CollectionIndexStatistics stats{UUID::gen(), kNumRecords, Date_t::now(), std::move(indexes)};
+
+    plan_cost_model::pruneCandidates(stats, kNumRecords, nullptr, 3.0, &solns);
+    assertSolutionExists(
+        "{fetch: {filter: {c: 5}, node: {ixscan: {filter: null, pattern: {a: 1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a: 5000}, node: {ixscan: {filter: null, pattern: {c: 1}}}}}");
+}
+
+TEST_F(PlanCostModelTest, PrefersSkipScanOverFewLeadingValues) {
+    addNamedIndex(BSON("b" << 1 << "a" << 1), "b_1_a_1");
+    params.skipScanIndexes.insert("b_1_a_1");
+    runQuery(fromjson("{a: 5}"));
+    assertNumSolutions(2U);
+
+    std::vector<BSONObj> keys;
+    for (long long i = 0; i < kNumRecords; ++i) {
+        keys.push_back(BSON("" << 7 + i % 2 << "" << i % 1000));
+    }
+    std::sort(keys.begin(), keys.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.woCompare(rhs) < 0;
+    });
+    IndexStatisticsBuilder builder("b_1_a_1", BSON("b" << 1 << "a" << 1), true, 100, kNumRecords);
+    for (auto&& key : keys) {
+        builder.addKey(key);
+    }
+
+    std::vector<IndexStatistics> indexes;
+    indexes.push_back(
+        makeIndexStatistics("a_1", BSON("a" << 1), [](auto i) { return i % 1000; }));
+    indexes.push_back(builder.done());
+    CollectionIndexStatistics stats(UUID::gen(), kNumRecords, Date_t::now(), std::move(indexes));
+
+    auto numPruned = plan_cost_model::pruneCandidates(stats, kNumRecords, nullptr, 10.0, &solns);
+    ASSERT_EQ(numPruned, 1U);
+    assertSolutionExists(
+        "{fetch: {filter: {a: 5}, node: {ixscan: {filter: null, pattern: {b: 1, a: 1}}}}}");
+}
+
+TEST_F(PlanCostModelTest, EstimatesSelectivityFromHistograms) {
+    auto stats = makeStatistics();
+    auto estimate = [&](const char* filter) {
+        auto obj = fromjson(filter);
+        auto expr = unittest::assertGet(MatchExpressionParser::parse(obj, expCtx));
+        return plan_cost_model::estimateSelectivity(expr.get(), stats, nullptr);
+    };
+
+    ASSERT_APPROX_EQUAL(estimate("{a: 5}"), 0.001, 0.0005);
+    ASSERT_APPROX_EQUAL(estimate("{a: {$lt: 100}}"), 0.1, 0.01);
+    ASSERT_APPROX_EQUAL(estimate("{a: {$in: [1, 2, 3]}}"), 0.003, 0.001);
+    ASSERT_APPROX_EQUAL(estimate("{b: 7}"), 0.5, 0.01);
+    ASSERT_APPROX_EQUAL(estimate("{a: 5, b: 7}"), 0.0005, 0.0003);
+    ASSERT_APPROX_EQUAL(estimate("{$or: [{b: 7}, {b: 8}]}"), 0.75, 0.01);
+    ASSERT_EQ(estimate("{a: {$gt: 5000}}"), 0.0);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -1369,6 +1369,79 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::skipScanIndex(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    if (index.keyPattern.nFields() < 2) {
+        return nullptr;
+    }
+
+    unique_ptr<IndexScanNode> isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+
+    auto& bounds = isn->bounds;
+    bounds.fields.resize(index.keyPattern.nFields());
+    std::vector<BSONElement> keyPatternElts;
+    BSONObjIterator it(index.keyPattern);
+    for (auto&& oil : bounds.fields) {
+        keyPatternElts.push_back(it.next());
+        IndexBoundsBuilder::allValuesForField(keyPatternElts.back(), &oil);
+    }
+
+    MatchExpression* root = query.root();
+    std::vector<const MatchExpression*> predicates;
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.push_back(root->getChild(i));
+        }
+    } else {
+        predicates.push_back(root);
+    }
+
+    // Only comparisons are used to bound the second field. Any other predicate, and any predicate
+    // whose bounds are inexact, is still applied by the fetch filter.
+    const BSONElement& secondField = keyPatternElts[1];
+    auto& oil = bounds.fields[1];
+    bool bounded = false;
+    for (auto&& predicate : predicates) {
+        switch (predicate->matchType()) {
+            case MatchExpression::EQ:
+            case MatchExpression::LT:
+            case MatchExpression::LTE:
+            case MatchExpression::GT:
+            case MatchExpression::GTE:
+            case MatchExpression::MATCH_IN:
+                break;
+            default:
+                continue;
+        }
+        if (predicate->path() != secondField.fieldNameStringData()) {
+            continue;
+        }
+
+        IndexBoundsBuilder::BoundsTightness tightness;
+        if (!bounded) {
+            oil.intervals.clear();
+            IndexBoundsBuilder::translate(predicate, secondField, index, &oil, &tightness);
+            bounded = true;
+        } else if (!index.multikey) {
+            // The predicates on a multikey field may be satisfied by different array elements, so
+            // their bounds cannot be intersected.
+            IndexBoundsBuilder::translateAndIntersect(
+                predicate, secondField, index, &oil, &tightness);
+        }
+    }
+    if (!bounded) {
+        return nullptr;
+    }
+    IndexBoundsBuilder::alignBounds(&bounds, index.keyPattern);
+
+    unique_ptr<FetchNode> fetch = std::make_unique<FetchNode>();
+    fetch->filter = root->shallowClone();
+    fetch->children.push_back(isn.release());
+    return std::move(fetch);
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
@@ -110,6 +110,17 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that skip scans the provided compound index: the bounds leave its first field
+     * unconstrained and restrict its second field by the query's top-level predicates on that
+     * field, so that the index scan seeks from each distinct value of the first field to the next.
+     * The whole query is applied as a fetch filter. Returns nullptr if the query has no predicate
+     * which can bound the second field.
+     */
+    static std::unique_ptr<QuerySolutionNode> skipScanIndex(const IndexEntry& index,
+                                                            const CanonicalQuery& query,
+                                                            const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
@@ -328,6 +328,16 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    auto solnRoot = QueryPlannerAccess::skipScanIndex(index, query, params);
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -497,6 +507,14 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_SCAN_SOLN == winnerCacheData.solnType) {
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::NoQueryExecutionPlans,
+                          "plan cache error: soln that skip scans an index");
+        } else {
+            return {std::move(soln)};
+        }
     } else if (SolutionCacheData::COLLSCAN_SOLN == winnerCacheData.solnType) {
         // The cached solution is a collection scan. We don't cache collscans
         // with tailable==true, hence the false below.
@@ -1101,11 +1119,48 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // An index whose leading field the query does not constrain may still be skip scanned on a
+    // later field, if that leading field has few distinct values. A skip scan is only worth
+    // running if it beats a collection scan, so it does not stand in for one as the indexed
+    // plans above do.
+    const bool haveIndexedSolutions = !out.empty();
+    if (!params.skipScanIndexes.empty() && hintedIndex.isEmpty() &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        for (auto&& index : fullIndexList) {
+            if (index.type != INDEX_BTREE || index.sparse || index.filterExpr ||
+                !params.skipScanIndexes.count(index.identifier.catalogName) ||
+                fields.count(index.keyPattern.firstElementFieldName()) ||
+                !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+                continue;
+            }
+
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (soln) {
+                LOGV2_DEBUG(5100010,
+                            5,
+                            "Planner: outputting soln that skip scans index",
+                            "solution"_attr = redact(soln->toString()));
+                PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+                indexTree->setIndexEntry(index);
+                SolutionCacheData* scd = new SolutionCacheData();
+                scd->tree.reset(indexTree);
+                scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+                soln->cacheData.reset(scd);
+                out.push_back(std::move(soln));
+            }
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
-    bool collScanRequired = 0 == out.size();
+    bool collScanRequired = !haveIndexedSolutions;
+    if (collScanRequired && !canTableScan && !out.empty()) {
+        // Run the skip scans rather than fail the query.
+        collScanRequired = false;
+    }
     if (collScanRequired && !canTableScan) {
         return Status(ErrorCodes::NoQueryExecutionPlans,
                       "No indexed plans available, and running with 'notablescan'");
@@ -1426,5 +1426,68 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+//
+// Skip scans
+//
+
+TEST_F(QueryPlannerTest, SkipScanCompetesWithCollscan) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    params.skipScanIndexes.insert("hari_king_of_the_stove");
+    runQuery(fromjson("{ts: {$gte: 5, $lt: 10}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {ts: {$gte: 5, $lt: 10}}, node: {ixscan: {pattern: {tenant: 1, ts: 1}, "
+        "bounds: {tenant: [['MinKey','MaxKey',true,true]], ts: [[5,10,true,false]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanRequiresIndexToBeEligible) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    runQuery(fromjson("{ts: 5}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerTest, SkipScanAlignsBoundsWithKeyPattern) {
+    addIndex(BSON("tenant" << 1 << "ts" << -1 << "x" << 1));
+    params.skipScanIndexes.insert("hari_king_of_the_stove");
+    runQuery(fromjson("{ts: {$in: [3, 7]}, y: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {ts: {$in: [3, 7]}, y: 1}, node: {ixscan: {pattern: {tenant: 1, ts: -1, "
+        "x: 1}, bounds: {tenant: [['MinKey','MaxKey',true,true]], ts: [[7,7,true,true], "
+        "[3,3,true,true]], x: [['MinKey','MaxKey',true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanDoesNotIntersectBoundsOfMultikeyIndex) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1), true);
+    params.skipScanIndexes.insert("hari_king_of_the_stove");
+    runQuery(fromjson("{ts: {$gt: 5, $lt: 10}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {ts: {$gt: 5, $lt: 10}}, node: {ixscan: {pattern: {tenant: 1, ts: 1}, "
+        "bounds: {tenant: [['MinKey','MaxKey',true,true]], ts: [[-Infinity,10,true,false]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenLeadingFieldIsQueried) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1));
+    params.skipScanIndexes.insert("hari_king_of_the_stove");
+    runQuery(fromjson("{tenant: 1, ts: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {tenant: 1, ts: 1}, bounds: {tenant: "
+        "[[1,1,true,true]], ts: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWithoutPredicateOnSecondField) {
+    addIndex(BSON("tenant" << 1 << "ts" << 1 << "x" << 1));
+    params.skipScanIndexes.insert("hari_king_of_the_stove");
+    runQuery(fromjson("{x: 5}"));
+    assertHasOnlyCollscan();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <set>
+#include <string>
 #include <vector>
 
 #include "mongo/db/jsobj.h"
@@ -117,6 +119,10 @@ struct QueryPlannerParams {
     // plans via the MultiPlanStage, and the set of possible plans is very large for certain
     // index+query combinations.
     size_t maxIndexedSolutions;
+
+    // The names of the indexes whose leading field has few enough distinct values that the planner
+    // may scan them with a skip scan when the query does not constrain that field.
+    std::set<std::string> skipScanIndexes;
 };
 
 }  // namespace mongo
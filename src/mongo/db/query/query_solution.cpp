@@ -1281,6 +1281,37 @@ QuerySolutionNode* CountScanNode::clone() const {
     return copy;
 }
 
+//
+// GroupCountScanNode
+//
+
+void GroupCountScanNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "GROUP_COUNT\n";
+    addIndent(ss, indent + 1);
+    *ss << "name = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "keyPattern = " << index.keyPattern << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "countFieldName = " << countFieldName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "startKey = " << startKey << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "endKey = " << endKey << '\n';
+}
+
+QuerySolutionNode* GroupCountScanNode::clone() const {
+    GroupCountScanNode* copy = new GroupCountScanNode(this->index, this->countFieldName);
+    cloneBaseData(copy);
+
+    copy->startKey = this->startKey;
+    copy->startKeyInclusive = this->startKeyInclusive;
+    copy->endKey = this->endKey;
+    copy->endKeyInclusive = this->endKeyInclusive;
+
+    return copy;
+}
+
 //
 // EnsureSortedNode
 //
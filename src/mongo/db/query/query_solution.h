@@ -1096,6 +1096,45 @@ struct CountScanNode : public QuerySolutionNodeWithSortSet {
     bool endKeyInclusive;
 };
 
+/**
+ * A $group which counts the documents of each value of a field reduces to counting the keys of an
+ * index on that field between two entries, one group at a time.
+ */
+struct GroupCountScanNode : public QuerySolutionNodeWithSortSet {
+    GroupCountScanNode(IndexEntry index, std::string countFieldName)
+        : index(std::move(index)), countFieldName(std::move(countFieldName)) {}
+
+    virtual ~GroupCountScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_GROUP_COUNT_SCAN;
+    }
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return false;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return field == "_id" || field == countFieldName ? FieldAvailability::kFullyProvided
+                                                         : FieldAvailability::kNotProvided;
+    }
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    IndexEntry index;
+
+    std::string countFieldName;
+
+    BSONObj startKey;
+    bool startKeyInclusive;
+
+    BSONObj endKey;
+    bool endKeyInclusive;
+};
+
 /**
  * This stage drops results that are out of sorted order.
  */
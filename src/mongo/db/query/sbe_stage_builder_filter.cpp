@@ -33,6 +33,8 @@
 
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 
+#include <cmath>
+
 #include "mongo/db/exec/sbe/stages/co_scan.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/limit_skip.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/traverse.h"
 #include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_expr.h"
@@ -703,8 +706,169 @@ public:
 private:
     MatchExpressionVisitorContext* _context;
 };
+
+// The largest magnitude an integral constant may have for comparisons against it to be exact
+// whichever numeric type the document value has: such integers are exactly representable both as
+// a double and as a Decimal128 converted from a double with 15 significant digits.
+constexpr long long kMaxExactIntegralConstant = 1'000'000'000'000'000LL;
+
+bool isExactlyComparableNumber(const BSONElement& elem) {
+    switch (elem.type()) {
+        case BSONType::NumberInt:
+            return true;
+        case BSONType::NumberLong: {
+            auto value = elem.numberLong();
+            return value >= -kMaxExactIntegralConstant && value <= kMaxExactIntegralConstant;
+        }
+        case BSONType::NumberDouble: {
+            auto value = elem.numberDouble();
+            return std::isfinite(value) && std::trunc(value) == value &&
+                std::abs(value) <= static_cast<double>(kMaxExactIntegralConstant);
+        }
+        default:
+            return false;
+    }
+}
+
+std::unique_ptr<sbe::EExpression> makeNothingConstant() {
+    return sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Nothing, 0);
+}
+
+std::unique_ptr<sbe::EExpression> makeBoolConstant(bool value) {
+    return sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Boolean, value);
+}
+
+/**
+ * Generates an expression which reads 'expr's path with nested getField() calls and compares the
+ * value found there to the constant, following the type bracketing rules of the classic matcher.
+ */
+std::unique_ptr<sbe::EExpression> generateComparisonExpression(
+    const ComparisonMatchExpression* expr,
+    sbe::value::SlotId inputVar,
+    sbe::value::FrameIdGenerator* frameIdGenerator) {
+    using namespace std::literals;
+
+    const auto& rhs = expr->getData();
+    const bool isNumeric = isExactlyComparableNumber(rhs);
+    if (!isNumeric && (rhs.type() != BSONType::String || expr->getCollator())) {
+        return nullptr;
+    }
+
+    auto op = [&]() -> boost::optional<sbe::EPrimBinary::Op> {
+        switch (expr->matchType()) {
+            case MatchExpression::EQ:
+                return sbe::EPrimBinary::eq;
+            case MatchExpression::LT:
+                return sbe::EPrimBinary::less;
+            case MatchExpression::LTE:
+                return sbe::EPrimBinary::lessEq;
+            case MatchExpression::GT:
+                return sbe::EPrimBinary::greater;
+            case MatchExpression::GTE:
+                return sbe::EPrimBinary::greaterEq;
+            default:
+                return boost::none;
+        }
+    }();
+    if (!op) {
+        return nullptr;
+    }
+
+    FieldRef path{expr->path()};
+    if (path.numParts() == 0) {
+        return nullptr;
+    }
+    std::unique_ptr<sbe::EExpression> fieldExpr = sbe::makeE<sbe::EVariable>(inputVar);
+    for (size_t i = 0; i < path.numParts(); ++i) {
+        auto part = path.getPart(i);
+        if (part.empty()) {
+            return nullptr;
+        }
+        fieldExpr = sbe::makeE<sbe::EFunction>(
+            "getField"sv,
+            sbe::makeEs(std::move(fieldExpr),
+                        sbe::makeE<sbe::EConstant>(std::string_view{part.rawData(), part.size()})));
+    }
+
+    auto frameId = frameIdGenerator->generate();
+    auto makeValue = [frameId]() { return sbe::makeE<sbe::EVariable>(frameId, 0); };
+
+    auto [tagView, valView] = sbe::bson::convertFrom(
+        true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+    auto [tag, val] = sbe::value::copyValue(tagView, valView);
+    auto comparison =
+        sbe::makeE<sbe::EPrimBinary>(*op, makeValue(), sbe::makeE<sbe::EConstant>(tag, val));
+
+    // Values of a different canonical type never match. A NaN orders differently in SBE than in
+    // the classic matcher, so it is left to the caller; it is the only number not equal to itself.
+    auto typedComparison = isNumeric
+        ? sbe::makeE<sbe::EIf>(
+              sbe::makeE<sbe::EFunction>("isNumber"sv, sbe::makeEs(makeValue())),
+              sbe::makeE<sbe::EIf>(
+                  sbe::makeE<sbe::EPrimBinary>(sbe::EPrimBinary::eq, makeValue(), makeValue()),
+                  std::move(comparison),
+                  makeNothingConstant()),
+              makeBoolConstant(false))
+        : sbe::makeE<sbe::EIf>(sbe::makeE<sbe::EFunction>("isString"sv, sbe::makeEs(makeValue())),
+                               std::move(comparison),
+                               makeBoolConstant(false));
+
+    // A missing value may also be a type SBE cannot represent, and arrays need the classic
+    // matcher's implicit traversal, so neither is decided here.
+    return sbe::makeE<sbe::ELocalBind>(
+        frameId,
+        sbe::makeEs(std::move(fieldExpr)),
+        sbe::makeE<sbe::EIf>(
+            sbe::makeE<sbe::EFunction>("exists"sv, sbe::makeEs(makeValue())),
+            sbe::makeE<sbe::EIf>(sbe::makeE<sbe::EFunction>("isArray"sv, sbe::makeEs(makeValue())),
+                                 makeNothingConstant(),
+                                 std::move(typedComparison)),
+            makeNothingConstant()));
+}
 }  // namespace
 
+std::unique_ptr<sbe::EExpression> generateFilterExpression(
+    const MatchExpression* root,
+    sbe::value::SlotId inputVar,
+    sbe::value::FrameIdGenerator* frameIdGenerator) {
+    switch (root->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR: {
+            const bool isAnd = root->matchType() == MatchExpression::AND;
+            if (root->numChildren() == 0) {
+                return makeBoolConstant(isAnd);
+            }
+
+            // Both operators short-circuit and propagate Nothing from their left-hand side, so a
+            // child which cannot decide a document leaves the whole tree undecided unless an
+            // earlier child already settled the result.
+            std::unique_ptr<sbe::EExpression> result;
+            for (size_t i = root->numChildren(); i-- > 0;) {
+                auto child =
+                    generateFilterExpression(root->getChild(i), inputVar, frameIdGenerator);
+                if (!child) {
+                    return nullptr;
+                }
+                result = result ? sbe::makeE<sbe::EPrimBinary>(isAnd ? sbe::EPrimBinary::logicAnd
+                                                                     : sbe::EPrimBinary::logicOr,
+                                                               std::move(child),
+                                                               std::move(result))
+                                : std::move(child);
+            }
+            return result;
+        }
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return generateComparisonExpression(
+                static_cast<const ComparisonMatchExpression*>(root), inputVar, frameIdGenerator);
+        default:
+            return nullptr;
+    }
+}
+
 std::unique_ptr<sbe::PlanStage> generateFilter(const MatchExpression* root,
                                                std::unique_ptr<sbe::PlanStage> stage,
                                                sbe::value::SlotIdGenerator* slotIdGenerator,
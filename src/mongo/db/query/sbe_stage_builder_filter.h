@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/id_generators.h"
 #include "mongo/db/matcher/expression.h"
@@ -44,4 +45,21 @@ std::unique_ptr<sbe::PlanStage> generateFilter(const MatchExpression* root,
                                                sbe::value::SlotIdGenerator* slotIdGenerator,
                                                sbe::value::SlotId inputVar);
 
+/**
+ * Lowers the filter 'root' to a single SBE expression over the document bound to 'inputVar', so
+ * that the classic engine can evaluate it with the SBE VM instead of walking the MatchExpression
+ * tree. Only $and and $or over $eq, $lt, $lte, $gt and $gte comparisons against strings (without
+ * a collator) and integral numbers which convert exactly between the numeric types are supported;
+ * returns nullptr for any other tree.
+ *
+ * The generated expression evaluates to a boolean only when the answer is known to agree with
+ * MatchExpression::matchesBSON(). It evaluates to Nothing for documents where the path traversal
+ * or comparison semantics could differ, such as when a path is missing, crosses an array, or
+ * reaches a NaN, in which case the caller must match the document against 'root' itself.
+ */
+std::unique_ptr<sbe::EExpression> generateFilterExpression(
+    const MatchExpression* root,
+    sbe::value::SlotId inputVar,
+    sbe::value::FrameIdGenerator* frameIdGenerator);
+
 }  // namespace mongo::stage_builder
@@ -0,0 +1,310 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/shared_plan_cache.h"
+
+#include <algorithm>
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_settings_decoration.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace shared_plan_cache {
+
+namespace {
+
+class SharedPlanCache {
+public:
+    PlanCache cache{static_cast<size_t>(internalQuerySharedPlanCacheSize.load()),
+                    static_cast<size_t>(internalQueryPlanCacheNumShards.load())};
+};
+
+const auto getSharedPlanCache = ServiceContext::declareDecoration<SharedPlanCache>();
+
+using IndexBinding = std::map<IndexEntry::Identifier, const IndexEntry*>;
+
+/**
+ * The indexes of a collection in the order of their definitions. Shared entries refer to an index
+ * by its position in this order.
+ */
+struct CanonicalIndexes {
+    std::string fingerprint;
+    std::vector<const IndexEntry*> indexes;
+};
+
+/**
+ * Describes everything about 'index' that the planner may look at, except for its name.
+ */
+BSONObj computeIndexSignature(const IndexEntry& index) {
+    BSONObjBuilder bob;
+    bob.append("key", index.keyPattern);
+    bob.append("type", static_cast<int>(index.type));
+    bob.append("sparse", index.sparse);
+    bob.append("unique", index.unique);
+    bob.append("multikey", index.multikey);
+
+    BSONArrayBuilder pathsBuilder(bob.subarrayStart("multikeyPaths"));
+    for (auto&& components : index.multikeyPaths) {
+        BSONArrayBuilder componentsBuilder(pathsBuilder.subarrayStart());
+        for (auto&& component : components) {
+            componentsBuilder.append(static_cast<long long>(component));
+        }
+    }
+    pathsBuilder.doneFast();
+
+    // The index spec carries the partial filter, collation and any other options.
+    BSONObjBuilder specBuilder(bob.subobjStart("spec"));
+    for (auto&& elem : index.infoObj) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName != "name"_sd && fieldName != "ns"_sd) {
+            specBuilder.append(elem);
+        }
+    }
+    specBuilder.doneFast();
+    return bob.obj();
+}
+
+boost::optional<CanonicalIndexes> canonicalizeIndexes(const std::vector<IndexEntry>& indexes) {
+    std::vector<std::pair<std::string, const IndexEntry*>> signatures;
+    signatures.reserve(indexes.size());
+    for (auto&& index : indexes) {
+        // A wildcard index is expanded into per-path entries whose metadata depends on the query,
+        // so the planner's view of it cannot be captured up front.
+        if (index.type == INDEX_WILDCARD) {
+            return boost::none;
+        }
+        signatures.emplace_back(computeIndexSignature(index).toString(), &index);
+    }
+    std::sort(signatures.begin(), signatures.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    CanonicalIndexes canonical;
+    for (size_t i = 0; i < signatures.size(); ++i) {
+        // Indexes which differ only in name cannot be told apart once their names are dropped.
+        if (i > 0 && signatures[i].first == signatures[i - 1].first) {
+            return boost::none;
+        }
+        canonical.fingerprint += signatures[i].first;
+        canonical.fingerprint += '|';
+        canonical.indexes.push_back(signatures[i].second);
+    }
+    return canonical;
+}
+
+IndexEntry::Identifier makeSharedIdentifier(size_t position) {
+    return IndexEntry::Identifier{std::to_string(position)};
+}
+
+/**
+ * Computes the key of the shared entry for 'query' over 'canonical'. The indexability part of a
+ * collection's own key has a bit for each of its indexes, in an order which depends on their names,
+ * so it is computed again over the indexes under their shared identifiers.
+ */
+PlanCacheKey makeSharedKey(const CanonicalQuery& query, const CanonicalIndexes& canonical) {
+    std::vector<CoreIndexInfo> indexCores;
+    indexCores.reserve(canonical.indexes.size());
+    for (size_t i = 0; i < canonical.indexes.size(); ++i) {
+        indexCores.push_back(*canonical.indexes[i]);
+        indexCores.back().identifier = makeSharedIdentifier(i);
+    }
+    PlanCacheIndexabilityState indexabilityState;
+    indexabilityState.updateDiscriminators(indexCores);
+
+    const auto key = PlanCache::computeKey(query, indexabilityState);
+    return PlanCacheKey(key.getStableKey(),
+                        str::stream()
+                            << key.getUnstablePart() << '@' << canonical.fingerprint);
+}
+
+/**
+ * Replaces every index that 'tree' refers to with the one 'binding' maps its identifier to.
+ * Returns false if 'tree' refers to an index which 'binding' does not know about.
+ */
+bool bindIndexTree(PlanCacheIndexTree* tree, const IndexBinding& binding) {
+    if (tree->entry) {
+        auto it = binding.find(tree->entry->identifier);
+        if (it == binding.end()) {
+            return false;
+        }
+        tree->setIndexEntry(*it->second);
+    }
+
+    for (auto&& orPushdown : tree->orPushdowns) {
+        auto it = binding.find(orPushdown.indexEntryId);
+        if (it == binding.end()) {
+            return false;
+        }
+        orPushdown.indexEntryId = it->second->identifier;
+    }
+
+    return std::all_of(tree->children.begin(), tree->children.end(), [&](auto child) {
+        return bindIndexTree(child, binding);
+    });
+}
+
+bool bindSolutionCacheData(SolutionCacheData* data, const IndexBinding& binding) {
+    return !data->tree || bindIndexTree(data->tree.get(), binding);
+}
+
+}  // namespace
+
+PlanCache* get(ServiceContext* serviceContext) {
+    return &getSharedPlanCache(serviceContext).cache;
+}
+
+boost::optional<std::string> computeIndexFingerprint(const std::vector<IndexEntry>& indexes) {
+    auto canonical = canonicalizeIndexes(indexes);
+    if (!canonical) {
+        return boost::none;
+    }
+    return std::move(canonical->fingerprint);
+}
+
+std::unique_ptr<CachedSolution> getCacheEntryIfActive(const PlanCache& cache,
+                                                      const CanonicalQuery& query,
+                                                      const PlanCacheKey& collectionKey,
+                                                      const std::vector<IndexEntry>& indexes) {
+    auto canonical = canonicalizeIndexes(indexes);
+    if (!canonical) {
+        return nullptr;
+    }
+
+    auto cs = cache.getCacheEntryIfActive(makeSharedKey(query, *canonical));
+    if (!cs) {
+        return nullptr;
+    }
+
+    IndexBinding binding;
+    for (size_t i = 0; i < canonical->indexes.size(); ++i) {
+        binding.emplace(makeSharedIdentifier(i), canonical->indexes[i]);
+    }
+    for (auto&& data : cs->plannerData) {
+        if (!bindSolutionCacheData(data, binding)) {
+            return nullptr;
+        }
+    }
+
+    // Feedback about the bound solution concerns the collection's own cache entry.
+    cs->key = collectionKey;
+    return cs;
+}
+
+Status set(PlanCache* cache,
+           const std::vector<IndexEntry>& indexes,
+           const CanonicalQuery& query,
+           const std::vector<QuerySolution*>& solutions,
+           std::unique_ptr<plan_ranker::PlanRankingDecision> why,
+           Date_t now) {
+    auto canonical = canonicalizeIndexes(indexes);
+    if (!canonical) {
+        return Status::OK();
+    }
+
+    // The shared entries must not keep the collection's index names, nor pointers into its index
+    // catalog. Those are restored from the querying collection's indexes on lookup.
+    std::vector<IndexEntry> sharedIndexes;
+    sharedIndexes.reserve(canonical->indexes.size());
+    for (size_t i = 0; i < canonical->indexes.size(); ++i) {
+        sharedIndexes.push_back(*canonical->indexes[i]);
+        sharedIndexes.back().identifier = makeSharedIdentifier(i);
+        sharedIndexes.back().filterExpr = nullptr;
+        sharedIndexes.back().collator = nullptr;
+    }
+
+    IndexBinding binding;
+    for (size_t i = 0; i < canonical->indexes.size(); ++i) {
+        binding.emplace(canonical->indexes[i]->identifier, &sharedIndexes[i]);
+    }
+
+    // PlanCache::set() only copies the cache data out of the solutions, so it is handed
+    // placeholder solutions which hold the rewritten cache data.
+    std::vector<std::unique_ptr<QuerySolution>> sharedSolutions;
+    std::vector<QuerySolution*> sharedSolutionPtrs;
+    for (auto&& solution : solutions) {
+        invariant(solution->cacheData);
+        auto sharedSolution = std::make_unique<QuerySolution>();
+        sharedSolution->cacheData.reset(solution->cacheData->clone());
+        if (!bindSolutionCacheData(sharedSolution->cacheData.get(), binding)) {
+            return Status::OK();
+        }
+        sharedSolutionPtrs.push_back(sharedSolution.get());
+        sharedSolutions.push_back(std::move(sharedSolution));
+    }
+
+    return cache->set(makeSharedKey(query, *canonical),
+                      query,
+                      sharedSolutionPtrs,
+                      std::move(why),
+                      now);
+}
+
+void updateFromCollection(OperationContext* opCtx,
+                          const Collection* collection,
+                          const CanonicalQuery& query,
+                          const std::vector<QuerySolution*>& solutions,
+                          std::unique_ptr<plan_ranker::PlanRankingDecision> why) {
+    const QuerySettings* querySettings =
+        QuerySettingsDecoration::get(collection->getSharedDecorations());
+    if (querySettings->getAllowedIndicesFilter(query.encodeKey())) {
+        return;
+    }
+
+    // Gather the indexes the same way the planner does, so that the fingerprint matches the one
+    // computed from the planner parameters on lookup.
+    std::vector<IndexEntry> indexes;
+    auto ii = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (ii->more()) {
+        const IndexCatalogEntry* ice = ii->next();
+        if (ice->descriptor()->hidden()) {
+            continue;
+        }
+        indexes.push_back(indexEntryFromIndexCatalogEntry(opCtx, *ice, &query));
+    }
+
+    auto serviceContext = opCtx->getServiceContext();
+    uassertStatusOK(set(get(serviceContext),
+                        indexes,
+                        query,
+                        solutions,
+                        std::move(why),
+                        serviceContext->getPreciseClockSource()->now()));
+}
+
+}  // namespace shared_plan_cache
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_planner_params.h"
+
+namespace mongo {
+
+class Collection;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A process-wide plan cache shared by all collections whose indexes differ only in their names.
+ * Entries are keyed on the query shape and a fingerprint of the index definitions, and refer to
+ * indexes by their position within the fingerprint rather than by name. Looking up an entry binds
+ * it back to the indexes of the collection being queried.
+ */
+namespace shared_plan_cache {
+
+/**
+ * Returns the shared plan cache of 'serviceContext'.
+ */
+PlanCache* get(ServiceContext* serviceContext);
+
+/**
+ * Returns a fingerprint of 'indexes' which is the same for two index lists exactly when their
+ * indexes have the same definitions and multikey state. Returns boost::none if plans over
+ * 'indexes' cannot be shared, for instance because one of them is a wildcard index.
+ */
+boost::optional<std::string> computeIndexFingerprint(const std::vector<IndexEntry>& indexes);
+
+/**
+ * Looks up the active entry of 'cache' for 'query' over 'indexes', and binds it to 'indexes'. The
+ * bound solution carries 'collectionKey', the key of 'query' in the collection's own plan cache.
+ * Returns nullptr if there is no such entry or plans over 'indexes' cannot be shared.
+ */
+std::unique_ptr<CachedSolution> getCacheEntryIfActive(const PlanCache& cache,
+                                                      const CanonicalQuery& query,
+                                                      const PlanCacheKey& collectionKey,
+                                                      const std::vector<IndexEntry>& indexes);
+
+/**
+ * Records 'solutions', the best first, in 'cache' as the entry for the query 'query' planned over
+ * 'indexes'. Does nothing if plans over 'indexes' cannot be shared.
+ */
+Status set(PlanCache* cache,
+           const std::vector<IndexEntry>& indexes,
+           const CanonicalQuery& query,
+           const std::vector<QuerySolution*>& solutions,
+           std::unique_ptr<plan_ranker::PlanRankingDecision> why,
+           Date_t now);
+
+/**
+ * Records 'solutions' in the shared plan cache as planned over the indexes of 'collection'. Does
+ * nothing if an index filter applies to 'query', since the plans then depend on more than the
+ * indexes.
+ */
+void updateFromCollection(OperationContext* opCtx,
+                          const Collection* collection,
+                          const CanonicalQuery& query,
+                          const std::vector<QuerySolution*>& solutions,
+                          std::unique_ptr<plan_ranker::PlanRankingDecision> why);
+
+}  // namespace shared_plan_cache
+}  // namespace mongo
@@ -0,0 +1,249 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/shared_plan_cache.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString nss("test.collection");
+
+IndexEntry makeIndexEntry(BSONObj keyPattern,
+                          const std::string& indexName,
+                          bool multikey = false,
+                          BSONObj infoObj = BSONObj()) {
+    return IndexEntry(keyPattern,
+                      IndexNames::nameToType(IndexNames::findPluginName(keyPattern)),
+                      multikey,
+                      {},
+                      {},
+                      false,  // sparse
+                      false,  // unique
+                      IndexEntry::Identifier{indexName},
+                      nullptr,
+                      infoObj,
+                      nullptr,
+                      nullptr);
+}
+
+std::unique_ptr<CanonicalQuery> canonicalize(const char* queryStr) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    auto qr = std::make_unique<QueryRequest>(nss);
+    qr->setFilter(fromjson(queryStr));
+    return unittest::assertGet(
+        CanonicalQuery::canonicalize(opCtx.get(),
+                                     std::move(qr),
+                                     nullptr,
+                                     ExtensionsCallbackNoop(),
+                                     MatchExpressionParser::kAllowAllSpecialFeatures));
+}
+
+std::unique_ptr<MatchExpression> parseFilter(const char* filterStr) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    return unittest::assertGet(
+        MatchExpressionParser::parse(fromjson(filterStr), std::move(expCtx)));
+}
+
+std::unique_ptr<QuerySolution> makeIndexedSolution(const IndexEntry& index) {
+    auto qs = std::make_unique<QuerySolution>();
+    qs->cacheData = std::make_unique<SolutionCacheData>();
+    qs->cacheData->tree = std::make_unique<PlanCacheIndexTree>();
+    qs->cacheData->tree->setIndexEntry(index);
+    return qs;
+}
+
+std::unique_ptr<plan_ranker::PlanRankingDecision> createDecision(size_t numPlans) {
+    auto why = std::make_unique<plan_ranker::PlanRankingDecision>();
+    std::vector<std::unique_ptr<PlanStageStats>> stats;
+    for (size_t i = 0; i < numPlans; ++i) {
+        CommonStats common("IXSCAN");
+        auto stat = std::make_unique<PlanStageStats>(common, STAGE_IXSCAN);
+        stat->specific.reset(new IndexScanStats());
+        stats.push_back(std::move(stat));
+        why->scores.push_back(0U);
+        why->candidateOrder.push_back(i);
+    }
+    why->getStats<PlanStageStats>() = std::move(stats);
+    return why;
+}
+
+TEST(SharedPlanCacheTest, FingerprintIgnoresIndexNamesAndOrder) {
+    std::vector<IndexEntry> tenantA{makeIndexEntry(BSON("a" << 1), "a_1"),
+                                    makeIndexEntry(BSON("b" << 1 << "c" << -1), "b_1_c_-1")};
+    std::vector<IndexEntry> tenantB{makeIndexEntry(BSON("b" << 1 << "c" << -1), "bc"),
+                                    makeIndexEntry(BSON("a" << 1), "a")};
+
+    auto fingerprintA = shared_plan_cache::computeIndexFingerprint(tenantA);
+    auto fingerprintB = shared_plan_cache::computeIndexFingerprint(tenantB);
+    ASSERT(fingerprintA);
+    ASSERT(fingerprintB);
+    ASSERT_EQ(*fingerprintA, *fingerprintB);
+}
+
+TEST(SharedPlanCacheTest, FingerprintDistinguishesIndexDefinitions) {
+    const auto fingerprint = [](std::vector<IndexEntry> indexes) {
+        auto result = shared_plan_cache::computeIndexFingerprint(indexes);
+        ASSERT(result);
+        return *result;
+    };
+
+    const auto base = fingerprint({makeIndexEntry(BSON("a" << 1), "a_1")});
+    ASSERT_NE(base, fingerprint({makeIndexEntry(BSON("a" << -1), "a_1")}));
+    ASSERT_NE(base, fingerprint({makeIndexEntry(BSON("a" << 1), "a_1", true)}));
+    ASSERT_NE(base,
+              fingerprint({makeIndexEntry(BSON("a" << 1),
+                                          "a_1",
+                                          false,
+                                          fromjson("{partialFilterExpression: {b: 1}}"))}));
+    ASSERT_NE(base,
+              fingerprint({makeIndexEntry(BSON("a" << 1), "a_1"),
+                           makeIndexEntry(BSON("b" << 1), "b_1")}));
+
+    // The name is also part of the index spec, but left out of the fingerprint.
+    const auto named = [](const char* indexName, const char* spec) {
+        return makeIndexEntry(BSON("a" << 1), indexName, false, fromjson(spec));
+    };
+    ASSERT_EQ(fingerprint({named("a_1", "{v: 2, name: 'a_1'}")}),
+              fingerprint({named("other", "{v: 2, name: 'other'}")}));
+}
+
+TEST(SharedPlanCacheTest, IndexesDifferingOnlyInNameCannotBeShared) {
+    std::vector<IndexEntry> indexes{makeIndexEntry(BSON("a" << 1), "first"),
+                                    makeIndexEntry(BSON("a" << 1), "second")};
+    ASSERT_FALSE(shared_plan_cache::computeIndexFingerprint(indexes));
+}
+
+TEST(SharedPlanCacheTest, EntriesAreBoundToTheIndexesOfTheQueryingCollection) {
+    PlanCache sharedCache(100);
+    PlanCache collectionCache(100);
+    auto cq = canonicalize("{a: 1, b: 1}");
+    const auto collectionKey = collectionCache.computeKey(*cq);
+
+    std::vector<IndexEntry> tenantA{makeIndexEntry(BSON("a" << 1), "a_1"),
+                                    makeIndexEntry(BSON("b" << 1), "b_1")};
+    auto winner = makeIndexedSolution(tenantA[1]);
+    auto runnerUp = makeIndexedSolution(tenantA[0]);
+    std::vector<QuerySolution*> solutions{winner.get(), runnerUp.get()};
+
+    // The first entry is inactive, as with any plan cache. Recording it again activates it.
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_OK(shared_plan_cache::set(
+            &sharedCache, tenantA, *cq, solutions, createDecision(2), Date_t{}));
+    }
+    ASSERT_EQ(1U, sharedCache.size());
+
+    // The entry does not refer to the names of the indexes it was planned over.
+    for (auto&& entry : sharedCache.getAllEntries()) {
+        for (auto&& data : entry->plannerData) {
+            ASSERT_NE("a_1", data->tree->entry->identifier.catalogName);
+            ASSERT_NE("b_1", data->tree->entry->identifier.catalogName);
+        }
+    }
+
+    // A collection with the same indexes under other names finds the entry, bound to its indexes.
+    std::vector<IndexEntry> tenantB{makeIndexEntry(BSON("b" << 1), "byB"),
+                                    makeIndexEntry(BSON("a" << 1), "byA")};
+    auto cs =
+        shared_plan_cache::getCacheEntryIfActive(sharedCache, *cq, collectionKey, tenantB);
+    ASSERT(cs);
+    ASSERT_EQ(2U, cs->plannerData.size());
+    ASSERT_EQ("byB", cs->plannerData[0]->tree->entry->identifier.catalogName);
+    ASSERT_BSONOBJ_EQ(BSON("b" << 1), cs->plannerData[0]->tree->entry->keyPattern);
+    ASSERT_EQ("byA", cs->plannerData[1]->tree->entry->identifier.catalogName);
+    ASSERT(cs->key == collectionKey);
+
+    // A collection with other indexes does not.
+    std::vector<IndexEntry> tenantC{makeIndexEntry(BSON("a" << 1), "a_1"),
+                                    makeIndexEntry(BSON("b" << 1), "b_1", true)};
+    ASSERT_FALSE(
+        shared_plan_cache::getCacheEntryIfActive(sharedCache, *cq, collectionKey, tenantC));
+}
+
+TEST(SharedPlanCacheTest, EntriesDistinguishQueriesByPartialIndexesWhateverTheirNames) {
+    PlanCache sharedCache(100);
+    auto lowFilter = parseFilter("{a: {$lt: 0}}");
+    auto highFilter = parseFilter("{a: {$gt: 100}}");
+    const auto makePartialIndex = [](const char* indexName, const MatchExpression* filter) {
+        auto index = makeIndexEntry(BSON("a" << 1),
+                                    indexName,
+                                    false,
+                                    BSON("partialFilterExpression" << filter->serialize()));
+        index.filterExpr = filter;
+        return index;
+    };
+
+    // Both collections have the same two partial indexes, but under each other's names.
+    std::vector<IndexEntry> tenantA{makePartialIndex("x", lowFilter.get()),
+                                    makePartialIndex("y", highFilter.get())};
+    std::vector<IndexEntry> tenantB{makePartialIndex("y", lowFilter.get()),
+                                    makePartialIndex("x", highFilter.get())};
+
+    auto lowQuery = canonicalize("{a: -5}");
+    auto highQuery = canonicalize("{a: 150}");
+    ASSERT_EQ(lowQuery->encodeKey(), highQuery->encodeKey());
+
+    auto solution = makeIndexedSolution(tenantA[0]);
+    std::vector<QuerySolution*> solutions{solution.get()};
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_OK(shared_plan_cache::set(
+            &sharedCache, tenantA, *lowQuery, solutions, createDecision(1), Date_t{}));
+    }
+
+    // Only the index on negative values can answer the query for them, whatever its name.
+    const auto collectionKeyFor = [](const std::vector<IndexEntry>& indexes,
+                                     const CanonicalQuery& query) {
+        PlanCache collectionCache(100);
+        collectionCache.notifyOfIndexUpdates({indexes.begin(), indexes.end()});
+        return collectionCache.computeKey(query);
+    };
+    auto cs = shared_plan_cache::getCacheEntryIfActive(
+        sharedCache, *lowQuery, collectionKeyFor(tenantB, *lowQuery), tenantB);
+    ASSERT(cs);
+    ASSERT_EQ("y", cs->plannerData[0]->tree->entry->identifier.catalogName);
+
+    // The query for large values shares the shape of the cached one, but must not use its plan.
+    ASSERT_FALSE(shared_plan_cache::getCacheEntryIfActive(
+        sharedCache, *highQuery, collectionKeyFor(tenantB, *highQuery), tenantB));
+    ASSERT_FALSE(shared_plan_cache::getCacheEntryIfActive(
+        sharedCache, *highQuery, collectionKeyFor(tenantA, *highQuery), tenantA));
+}
+
+}  // namespace
+}  // namespace mongo
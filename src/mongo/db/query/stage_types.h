@@ -65,6 +65,10 @@ enum StageType {
     STAGE_GEO_NEAR_2D,
     STAGE_GEO_NEAR_2DSPHERE,
 
+    // Counts the keys of an index for each distinct value of its first field, for a $group which
+    // counts the documents of each value of that field.
+    STAGE_GROUP_COUNT_SCAN,
+
     STAGE_IDHACK,
 
     STAGE_IXSCAN,
@@ -347,7 +347,8 @@ StatusWith<BSONObj> MigrationChunkClonerSourceLegacy::commitClone(OperationConte
             }
         } else {
             invariant(PlanExecutor::IS_EOF == _jumboChunkCloneState->clonerState);
-            invariant(_cloneLocs.empty());
+            stdx::lock_guard<Latch> sl(_mutex);
+            invariant(_numCloneLocsRemaining(sl) == 0);
         }
     }
 
@@ -662,26 +663,25 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
     stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
 
-    for (; iter != _cloneLocs.end(); ++iter) {
-        // We must always make progress in this method by at least one document because empty
-        // return indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
+    // We must always make progress in this method by at least one document because empty return
+    // indicates there is no more initial clone data.
+    while (!arrBuilder->arrSize() || !tracker.intervalHasElapsed()) {
+        auto nextRecordId = _takeNextCloneLoc(lk);
+        if (!nextRecordId) {
             break;
         }
 
-        auto nextRecordId = *iter;
-
         lk.unlock();
 
         Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
+        if (collection->findDoc(opCtx, *nextRecordId, &doc)) {
             // Use the builder size instead of accumulating the document sizes directly so
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
                 (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
-
+                lk.lock();
+                _returnCloneLoc(lk, *nextRecordId);
                 break;
             }
 
@@ -691,8 +691,28 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
 
         lk.lock();
     }
+}
+
+size_t MigrationChunkClonerSourceLegacy::_numCloneLocsRemaining(WithLock) const {
+    return _cloneLocs.size() - _nextCloneLocIdx + _returnedCloneLocs.size();
+}
+
+boost::optional<RecordId> MigrationChunkClonerSourceLegacy::_takeNextCloneLoc(WithLock) {
+    if (!_returnedCloneLocs.empty()) {
+        auto recordId = std::move(_returnedCloneLocs.back());
+        _returnedCloneLocs.pop_back();
+        return recordId;
+    }
 
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
+    if (_nextCloneLocIdx < _cloneLocs.size()) {
+        return _cloneLocs[_nextCloneLocIdx++];
+    }
+
+    return boost::none;
+}
+
+void MigrationChunkClonerSourceLegacy::_returnCloneLoc(WithLock, RecordId recordId) {
+    _returnedCloneLocs.push_back(std::move(recordId));
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -701,7 +721,12 @@ uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
         return static_cast<uint64_t>(BSONObjMaxUserSize);
 
     return std::min(static_cast<uint64_t>(BSONObjMaxUserSize),
-                    _averageObjectSizeForCloneLocs * _cloneLocs.size());
+                    _averageObjectSizeForCloneLocs * _numCloneLocsRemaining(sl));
+}
+
+bool MigrationChunkClonerSourceLegacy::supportsConcurrentCloneBatches() {
+    stdx::lock_guard<Latch> sl(_mutex);
+    return !(_jumboChunkCloneState && _forceJumbo);
 }
 
 Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
@@ -735,7 +760,7 @@ Status MigrationChunkClonerSourceLegacy::nextModsBatch(OperationContext* opCtx,
     {
         // All clone data must have been drained before starting to fetch the incremental changes.
         stdx::unique_lock<Latch> lk(_mutex);
-        invariant(_cloneLocs.empty());
+        invariant(_numCloneLocsRemaining(lk) == 0);
 
         // The "snapshot" for delete and update list must be taken under a single lock. This is to
         // ensure that we will preserve the causal order of writes. Always consume the delete
@@ -885,13 +910,14 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
 
             if (!isLargeChunk) {
                 stdx::lock_guard<Latch> lk(_mutex);
-                _cloneLocs.insert(recordId);
+                _cloneLocs.push_back(recordId);
             }
 
             if (++recCount > maxRecsWhenFull) {
                 isLargeChunk = true;
 
                 if (_forceJumbo) {
+                    stdx::lock_guard<Latch> lk(_mutex);
                     _cloneLocs.clear();
                     break;
                 }
@@ -918,6 +944,10 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
     stdx::lock_guard<Latch> lk(_mutex);
     _averageObjectSizeForCloneLocs = collectionAverageObjectSize + 12;
 
+    // The index scan returns the record ids in shard key order, so sort them in order to fetch the
+    // documents in storage order
+    std::sort(_cloneLocs.begin(), _cloneLocs.end());
+
     return Status::OK();
 }
 
@@ -998,7 +1028,7 @@ Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationC
 
         stdx::lock_guard<Latch> sl(_mutex);
 
-        const std::size_t cloneLocsRemaining = _cloneLocs.size();
+        const std::size_t cloneLocsRemaining = _numCloneLocsRemaining(sl);
 
         if (_forceJumbo && _jumboChunkCloneState) {
             LOGV2(21992,
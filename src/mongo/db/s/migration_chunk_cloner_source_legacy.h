@@ -143,10 +143,19 @@ public:
      */
     uint64_t getCloneBatchBufferAllocationSize();
 
+    /**
+     * Returns whether the initial clone is served from the pre-computed set of record ids, in which
+     * case nextCloneBatch may be called concurrently by multiple requests from the recipient, each
+     * of them receiving a disjoint subset of the documents. Jumbo chunks, which are cloned by
+     * scanning the shard key index, only allow one caller at a time.
+     */
+    bool supportsConcurrentCloneBatches();
+
     /**
      * Called by the recipient shard. Populates the passed BSONArrayBuilder with a set of documents,
-     * which are part of the initial clone sequence. Assumes that there is only one active caller
-     * to this method at a time (otherwise, it can cause corruption/crash).
+     * which are part of the initial clone sequence. Unless supportsConcurrentCloneBatches() returns
+     * true, assumes that there is only one active caller to this method at a time (otherwise, it
+     * can cause corruption/crash).
      *
      * Returns OK status on success. If there were documents returned in the result argument, this
      * method should be called more times until the result is empty. If it returns failure, it is
@@ -239,6 +248,20 @@ private:
      */
     Status _storeCurrentLocs(OperationContext* opCtx);
 
+    /**
+     * Returns the number of record ids from _cloneLocs, which have not been sent to the recipient
+     * yet.
+     */
+    size_t _numCloneLocsRemaining(WithLock) const;
+
+    /**
+     * Hands out the next record id to be sent to the recipient, if any. Record ids which were
+     * handed out, but did not fit in the caller's batch must be returned through
+     * _returnCloneLoc so that they are sent as part of a later batch.
+     */
+    boost::optional<RecordId> _takeNextCloneLoc(WithLock);
+    void _returnCloneLoc(WithLock, RecordId recordId);
+
     /**
      * Adds the OpTime to the list of OpTimes for oplog entries that we should consider migrating as
      * part of session migration.
@@ -347,8 +370,14 @@ private:
     // The current state of the cloner
     State _state{kNew};
 
-    // List of record ids that needs to be transferred (initial clone)
-    std::set<RecordId> _cloneLocs;
+    // Sorted list of record ids that needs to be transferred (initial clone). The entries before
+    // _nextCloneLocIdx have already been handed out to a clone batch.
+    std::vector<RecordId> _cloneLocs;
+    size_t _nextCloneLocIdx{0};
+
+    // Record ids which were handed out to a clone batch, which could not fit them. They take
+    // precedence over the remaining entries of _cloneLocs.
+    std::vector<RecordId> _returnedCloneLocs;
 
     // The estimated average object size during the clone phase. Used for buffer size
     // pre-allocation (initial clone).
@@ -162,6 +162,7 @@ public:
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
         boost::optional<BSONArrayBuilder> arrBuilder;
+        bool supportsConcurrentCloneBatches = false;
 
         // Try to maximize on the size of the buffer, which we are returning in order to have less
         // round-trips
@@ -172,6 +173,8 @@ public:
 
             if (!arrBuilder) {
                 arrBuilder.emplace(autoCloner.getCloner()->getCloneBatchBufferAllocationSize());
+                supportsConcurrentCloneBatches =
+                    autoCloner.getCloner()->supportsConcurrentCloneBatches();
             }
 
             arrSizeAtPrevIteration = arrBuilder->arrSize();
@@ -183,6 +186,10 @@ public:
         invariant(arrBuilder);
         result.appendArray("objects", arrBuilder->arr());
 
+        // Lets the recipient know that it is safe to issue multiple _migrateClone requests for
+        // this migration at the same time
+        result.append("supportsConcurrentCloneBatches", supportsConcurrentCloneBatches);
+
         return true;
     }
 
@@ -396,12 +396,15 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int maxConcurrentFetches) {
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    invariant(maxConcurrentFetches >= 1);
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    MultiProducerSingleConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = maxConcurrentFetches;
+
+    MultiProducerSingleConsumerQueue<BSONObj> batches(options);
     repl::OpTime lastOpApplied;
 
     stdx::thread inserterThread{[&] {
@@ -416,12 +419,10 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         try {
             while (true) {
                 auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
-                }
-                insertBatchFn(inserterOpCtx.get(), arr);
+                insertBatchFn(inserterOpCtx.get(), nextBatch["objects"].Obj());
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // All the fetchers have reached the end of the documents to clone
         } catch (...) {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
@@ -432,29 +433,100 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
     }};
 
+    // Pushes the fetched batches to the inserter until the donor returns an empty batch, which
+    // indicates that there are no more documents to clone
+    auto fetchUntilDone = [&](OperationContext* fetcherOpCtx, BSONObj res) {
+        while (!res["objects"].Obj().isEmpty()) {
+            batches.push(res.getOwned(), fetcherOpCtx);
+            res = fetchBatchFn(fetcherOpCtx);
+        }
+    };
+
+    // Guards the operation contexts of the additional fetcher threads, so that they can be
+    // interrupted if the cloning fails on the main thread
+    auto fetchersMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::fetchersMutex");
+    bool fetchersStopped = false;
+    std::vector<OperationContext*> fetcherOpCtxs;
+    std::vector<stdx::thread> fetcherThreads;
+
+    auto stopFetchers = [&] {
+        stdx::lock_guard<Latch> lk(fetchersMutex);
+        fetchersStopped = true;
+        for (auto fetcherOpCtx : fetcherOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*fetcherOpCtx->getClient());
+            fetcherOpCtx->getServiceContext()->killOperation(
+                clientLock, fetcherOpCtx, ErrorCodes::Interrupted);
+        }
+    };
+
+    auto runFetcher = [&] {
+        Client::initKillableThread("chunkFetcher", opCtx->getServiceContext());
+
+        auto fetcherOpCtx = Client::getCurrent()->makeOperationContext();
+        {
+            stdx::lock_guard<Latch> lk(fetchersMutex);
+            if (fetchersStopped) {
+                return;
+            }
+            fetcherOpCtxs.push_back(fetcherOpCtx.get());
+        }
+
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(fetchersMutex);
+            fetcherOpCtxs.erase(
+                std::find(fetcherOpCtxs.begin(), fetcherOpCtxs.end(), fetcherOpCtx.get()));
+        });
+
+        try {
+            fetchUntilDone(fetcherOpCtx.get(), fetchBatchFn(fetcherOpCtx.get()));
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // The inserter has failed and already interrupted the main thread
+        } catch (...) {
+            if (stdx::lock_guard<Latch> lk(fetchersMutex); fetchersStopped) {
+                // Interrupted because the cloning has already failed on the main thread
+                return;
+            }
+
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(5100001));
+            LOGV2(5100002,
+                  "Batch fetching failed: {error}",
+                  "Batch fetching failed",
+                  "error"_attr = redact(exceptionToStatus()));
+        }
+    };
 
     {
-        auto inserterThreadJoinGuard = makeGuard([&] {
+        auto threadsJoinGuard = makeGuard([&] {
+            for (auto& fetcherThread : fetcherThreads) {
+                fetcherThread.join();
+            }
             batches.closeProducerEnd();
             inserterThread.join();
         });
 
-        while (true) {
+        try {
             auto res = fetchBatchFn(opCtx);
-            try {
-                batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
+
+            // Only donors which can serve disjoint batches to concurrent _migrateClone requests
+            // advertise it, so older donors are always cloned from over a single stream
+            if (res["supportsConcurrentCloneBatches"].trueValue()) {
+                for (int i = 1; i < maxConcurrentFetches; i++) {
+                    fetcherThreads.emplace_back(runFetcher);
                 }
-            } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
-                break;
             }
+
+            fetchUntilDone(opCtx, std::move(res));
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            stopFetchers();
+        } catch (...) {
+            stopFetchers();
+            throw;
         }
     }  // This scope ensures that the guard is destroyed
 
-    // This check is necessary because the consumer thread uses killOp to propagate errors to the
-    // producer thread (this thread)
+    // This check is necessary because the consumer and the additional fetcher threads use killOp
+    // to propagate errors to the producer thread (this thread)
     opCtx->checkForInterrupt();
     return lastOpApplied;
 }
@@ -997,7 +1069,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied = cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, chunkMigrationConcurrency.load());
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
@@ -113,12 +113,15 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. If the donor advertises support for it in its first
+     * batch, up to 'maxConcurrentFetches' calls to fetchBatchFn are issued concurrently, each from
+     * its own thread and operation context. The fetched batches are always inserted sequentially.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int maxConcurrentFetches = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -104,6 +104,80 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that documents fetched by concurrent fetchers are all ferried to the insert logic when the
+// donor supports serving concurrent clone batches.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithConcurrentFetches) {
+    const size_t kNumBatches = 20;
+    const int kMaxConcurrentFetches = 4;
+
+    auto mutex = MONGO_MAKE_LATCH();
+    size_t numBatchesFetched = 0;
+    std::set<stdx::thread::id> fetcherThreadIds;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+
+        stdx::lock_guard<Latch> lk(mutex);
+        fetcherThreadIds.insert(stdx::this_thread::get_id());
+        if (numBatchesFetched == kNumBatches) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            int value = static_cast<int>(numBatchesFetched++);
+            fetchBatchResultBuilder.append("objects", BSON_ARRAY(createDocument(value)));
+        }
+        fetchBatchResultBuilder.append("supportsConcurrentCloneBatches", true);
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    std::set<int> insertedValues;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        for (auto&& docToClone : docs) {
+            ASSERT(insertedValues.insert(docToClone.Obj()["_id"].numberInt()).second);
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, kMaxConcurrentFetches);
+
+    ASSERT_EQ(kNumBatches, insertedValues.size());
+    ASSERT_EQ(static_cast<size_t>(kMaxConcurrentFetches), fetcherThreadIds.size());
+}
+
+// Tests that only a single fetcher is used for donors, which do not support serving concurrent
+// clone batches.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithoutConcurrentFetchSupport) {
+    bool ranOnce = false;
+    std::set<stdx::thread::id> fetcherThreadIds;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+
+        fetcherThreadIds.insert(stdx::this_thread::get_id());
+        if (ranOnce) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            ranOnce = true;
+            fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        }
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    size_t numInserted = 0;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        numInserted += docs.nFields();
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4);
+
+    ASSERT_EQ(createDocumentsToClone().size(), numInserted);
+    ASSERT_EQ(1U, fetcherThreadIds.size());
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
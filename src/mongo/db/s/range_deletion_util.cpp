@@ -43,7 +43,6 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
-#include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
@@ -53,6 +52,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/persistent_task_store.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
@@ -64,6 +64,7 @@
 #include "mongo/executor/task_executor.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/future_util.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -171,34 +172,35 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                             "namespace"_attr = nss.ns());
     }
 
-    auto deleteStageParams = std::make_unique<DeleteStageParams>();
-    deleteStageParams->fromMigrate = true;
-    deleteStageParams->isMulti = true;
-    deleteStageParams->returnDeleted = true;
-
+    std::unique_ptr<RemoveSaver> removeSaver;
     if (serverGlobalParams.moveParanoia) {
-        deleteStageParams->removeSaver =
-            std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
+        removeSaver = std::make_unique<RemoveSaver>("moveChunk", nss.ns(), "cleaning");
     }
 
-    auto exec = InternalPlanner::deleteWithIndexScan(opCtx,
-                                                     collection,
-                                                     std::move(deleteStageParams),
-                                                     descriptor,
-                                                     min,
-                                                     max,
-                                                     BoundInclusion::kIncludeStartKeyOnly,
-                                                     PlanYieldPolicy::YieldPolicy::YIELD_MANUAL,
-                                                     InternalPlanner::FORWARD);
+    // The documents themselves are only needed if they have to be saved before being removed
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           collection,
+                                           descriptor,
+                                           min,
+                                           max,
+                                           BoundInclusion::kIncludeStartKeyOnly,
+                                           PlanYieldPolicy::YieldPolicy::YIELD_MANUAL,
+                                           InternalPlanner::FORWARD,
+                                           removeSaver ? InternalPlanner::IXSCAN_FETCH
+                                                       : InternalPlanner::IXSCAN_DEFAULT);
 
     if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
         LOGV2(23768, "Hit hangBeforeDoingDeletion failpoint");
         hangBeforeDoingDeletion.pauseWhileSet(opCtx);
     }
 
-    int numDeleted = 0;
-    do {
-        BSONObj deletedObj;
+    // Collect the batch of orphaned documents first, so that they can all be removed with a single
+    // batched delete rather than one storage transaction per document.
+    std::vector<RecordId> recordIds;
+    recordIds.reserve(numDocsToRemovePerBatch);
+    while (recordIds.size() < static_cast<size_t>(numDocsToRemovePerBatch)) {
+        BSONObj obj;
+        RecordId recordId;
 
         if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
             throw WriteConflictException();
@@ -210,7 +212,7 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 
         PlanExecutor::ExecState state;
         try {
-            state = exec->getNext(&deletedObj, nullptr);
+            state = exec->getNext(&obj, &recordId);
         } catch (const DBException& ex) {
             LOGV2_WARNING(23776,
                           "Cursor error while trying to delete {min} to {max} in {namespace}, "
@@ -229,11 +231,37 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         }
 
         invariant(PlanExecutor::ADVANCED == state);
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
 
-    } while (++numDeleted < numDocsToRemovePerBatch);
+        if (removeSaver) {
+            uassertStatusOK(removeSaver->goingToDelete(obj));
+        }
+
+        recordIds.push_back(std::move(recordId));
+    }
+
+    if (recordIds.empty()) {
+        return 0;
+    }
+
+    uassert(ErrorCodes::PrimarySteppedDown,
+            str::stream() << "Demoted from primary while removing from " << nss.ns(),
+            !opCtx->writesAreReplicated() ||
+                repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss));
+
+    Timer timer;
+    {
+        WriteUnitOfWork wuow(opCtx);
+        collection->deleteDocuments(
+            opCtx, kUninitializedStmtId, recordIds, nullptr /* opDebug */, true /* fromMigrate */);
+        wuow.commit();
+    }
+
+    auto& shardingStatistics = ShardingStatistics::get(opCtx);
+    shardingStatistics.countDocsDeletedOnDonor.addAndFetch(recordIds.size());
+    shardingStatistics.countRangeDeletionBatchesOnDonor.addAndFetch(1);
+    shardingStatistics.totalDonorRangeDeletionTimeMicros.addAndFetch(timer.micros());
 
-    return numDeleted;
+    return recordIds.size();
 }
 
 
@@ -38,6 +38,7 @@
 #include "mongo/db/s/range_deletion_task_gen.h"
 #include "mongo/db/s/range_deletion_util.h"
 #include "mongo/db/s/shard_server_test_fixture.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/unittest/death_test.h"
@@ -522,6 +523,50 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeWaitsForReplicationOnlyOnceAfterS
     ASSERT_EQ(numTimesWaitedForReplication, expectedNumTimesWaitedForReplication);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeReportsBatchesInShardingStatistics) {
+    const auto numDocsToInsert = 5;
+    const auto numDocsToRemovePerBatch = 2;
+    const auto numBatches = 3;
+
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    // Insert range deletion task for this collection and range.
+    PersistentTaskStore<RangeDeletionTask> store(NamespaceString::kRangeDeletionNamespace);
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    RangeDeletionTask t(
+        UUID::gen(), kNss, uuid(), ShardId("donor"), range, CleanWhenEnum::kDelayed);
+    store.add(operationContext(), t);
+
+    auto& shardingStatistics = ShardingStatistics::get(operationContext());
+    const auto docsDeletedBefore = shardingStatistics.countDocsDeletedOnDonor.load();
+    const auto batchesBefore = shardingStatistics.countRangeDeletionBatchesOnDonor.load();
+
+    auto queriesComplete = SemiFuture<void>::makeReady();
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               t.getId(),
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+    ASSERT_EQ(shardingStatistics.countDocsDeletedOnDonor.load() - docsDeletedBefore,
+              numDocsToInsert);
+    ASSERT_EQ(shardingStatistics.countRangeDeletionBatchesOnDonor.load() - batchesBefore,
+              numBatches);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeDoesNotWaitForReplicationIfErrorDuringDeletion) {
     auto replCoord = checked_cast<repl::ReplicationCoordinatorMock*>(
         repl::ReplicationCoordinator::get(getServiceContext()));
@@ -69,6 +69,15 @@ struct ShardingStatistics {
     // node by the rangeDeleter.
     AtomicWord<long long> countDocsDeletedOnDonor{0};
 
+    // Cumulative, always-increasing counter of how many batches of documents have been deleted on
+    // the donor node by the rangeDeleter.
+    AtomicWord<long long> countRangeDeletionBatchesOnDonor{0};
+
+    // Cumulative, always-increasing counter of how much time the rangeDeleter spent removing the
+    // batches of documents counted by countRangeDeletionBatchesOnDonor. Together with
+    // countDocsDeletedOnDonor, this gives the rangeDeleter's deletion throughput.
+    AtomicWord<long long> totalDonorRangeDeletionTimeMicros{0};
+
     // Cumulative, always-increasing counter of how many chunks this node started to receive
     // (whether the receiving succeeded or not)
     AtomicWord<long long> countRecipientMoveChunkStarted{0};
@@ -76,6 +76,7 @@
 #include "mongo/db/service_entry_point_common.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/transaction_participant.h"
@@ -1754,6 +1755,24 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    // Queries which were planned record their shape, as identified by the hash of their plan cache
+    // key. The statistics of any getMores are not attributed to the shape.
+    if (const auto& queryHash = currentOp.debug().queryHash) {
+        const auto& additiveMetrics = currentOp.debug().additiveMetrics;
+        QueryShapeStats::Execution execution;
+        execution.latencyMicros =
+            durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses());
+        execution.docsExamined = additiveMetrics.docsExamined.value_or(0);
+        execution.keysExamined = additiveMetrics.keysExamined.value_or(0);
+        execution.nreturned = std::max(currentOp.debug().nreturned, 0LL);
+        QueryShapeStats::get(opCtx->getServiceContext())
+            .record(opCtx,
+                    NamespaceString(currentOp.getNS()),
+                    *queryHash,
+                    currentOp.getPlanSummary(),
+                    execution);
+    }
+
     if (currentOp.shouldDBProfile(shouldSample)) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
@@ -29,9 +29,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/top.h"
 
 namespace mongo {
@@ -60,5 +64,32 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the number of query shapes tracked and evicted to the server status while their
+ * collection is enabled. The shapes with the greatest total execution time are only included on
+ * request, as in {serverStatus: 1, queryShapeStats: {topShapes: 10}}: they are strings whose order
+ * keeps changing, which FTDC could not compress.
+ */
+class QueryShapeStatsServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapeStatsServerStatusSection() : ServerStatusSection("queryShapeStats") {}
+
+    bool includeByDefault() const override {
+        return internalQueryShapeStatsMaxShapes.load() > 0;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        long long numTopShapes = 0;
+        if (configElem.type() == BSONType::Object && configElem.Obj()["topShapes"].isNumber()) {
+            numTopShapes = std::max(0LL, configElem.Obj()["topShapes"].safeNumberLong());
+        }
+
+        BSONObjBuilder builder;
+        QueryShapeStats::get(opCtx->getServiceContext())
+            .appendSummary(static_cast<size_t>(numTopShapes), &builder);
+        return builder.obj();
+    }
+} queryShapeStatsServerStatusSection;
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,206 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryShapeStats = ServiceContext::declareDecoration<QueryShapeStats>();
+
+}  // namespace
+
+// static
+QueryShapeStats& QueryShapeStats::get(ServiceContext* service) {
+    return getQueryShapeStats(service);
+}
+
+void QueryShapeStats::record(OperationContext* opCtx,
+                             const NamespaceString& nss,
+                             uint32_t queryHash,
+                             StringData planSummary,
+                             const Execution& execution) {
+    if (!opCtx->shouldIncrementLatencyStats()) {
+        return;
+    }
+
+    // Like the latency histograms of Top, only count operations which came from a user.
+    Client* client = opCtx->getClient();
+    if (client->isFromUserConnection() && !client->isInDirectClient()) {
+        recordExecution(nss, queryHash, planSummary, execution);
+    }
+}
+
+void QueryShapeStats::recordExecution(const NamespaceString& nss,
+                                      uint32_t queryHash,
+                                      StringData planSummary,
+                                      const Execution& execution) {
+    const long long maxShapes = internalQueryShapeStatsMaxShapes.load();
+    if (maxShapes == 0) {
+        return;
+    }
+
+    ShapeKey key{nss.ns(), queryHash};
+    auto& partition = _partitions[queryHash % kNumPartitions];
+    stdx::lock_guard<Latch> lk(partition.mutex);
+
+    auto it = partition.shapes.find(key);
+    if (it == partition.shapes.end()) {
+        uint64_t inheritedRank = 0;
+        if (_numShapes.load() >= maxShapes) {
+            // The table is full, so make room by evicting the shape of this partition with the
+            // lowest rank, which the new shape inherits. The count of shapes across partitions is
+            // read without their mutexes, so the table may briefly hold a few more than
+            // 'maxShapes' shapes.
+            if (partition.shapes.empty()) {
+                return;
+            }
+            auto victim = partition.byRank.begin();
+            inheritedRank = victim->first;
+            partition.shapes.erase(partition.shapes.find(*victim->second));
+            partition.byRank.erase(victim);
+            _numShapesEvicted.addAndFetch(1);
+        } else {
+            _numShapes.addAndFetch(1);
+        }
+        it = partition.shapes.emplace(std::move(key), ShapeData{}).first;
+        it->second.rankPos = partition.byRank.emplace(inheritedRank, &it->first);
+    }
+
+    auto& data = it->second;
+    auto rankNode = partition.byRank.extract(data.rankPos);
+    rankNode.key() += execution.latencyMicros;
+    data.rankPos = partition.byRank.insert(std::move(rankNode));
+
+    if (data.planSummary != planSummary) {
+        data.planSummary = planSummary.toString();
+    }
+    ++data.execCount;
+    data.totalExecMicros += execution.latencyMicros;
+    data.maxExecMicros = std::max(data.maxExecMicros, execution.latencyMicros);
+    data.docsExamined += execution.docsExamined;
+    data.keysExamined += execution.keysExamined;
+    data.nreturned += execution.nreturned;
+
+    const auto& lowerBounds = OperationLatencyHistogram::kLowerBounds;
+    const auto bucket =
+        std::upper_bound(lowerBounds.begin(), lowerBounds.end(), execution.latencyMicros) -
+        lowerBounds.begin() - 1;
+    ++data.latencyBuckets[bucket];
+}
+
+std::vector<BSONObj> QueryShapeStats::getShapes(bool includeHistograms) const {
+    std::vector<std::pair<uint64_t, BSONObj>> shapes;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& [key, data] : partition.shapes) {
+            shapes.emplace_back(data.totalExecMicros, _shapeToBSON(key, data, includeHistograms));
+        }
+    }
+
+    std::stable_sort(shapes.begin(), shapes.end(), [](auto&& lhs, auto&& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    std::vector<BSONObj> result;
+    result.reserve(shapes.size());
+    for (auto&& shape : shapes) {
+        result.push_back(std::move(shape.second));
+    }
+    return result;
+}
+
+void QueryShapeStats::appendSummary(size_t numTopShapes, BSONObjBuilder* builder) const {
+    builder->append("numShapes", _numShapes.load());
+    builder->append("numShapesEvicted", _numShapesEvicted.load());
+    if (numTopShapes == 0) {
+        return;
+    }
+
+    auto shapes = getShapes(false /* includeHistograms */);
+    BSONArrayBuilder topShapesBuilder(builder->subarrayStart("topShapes"));
+    for (size_t i = 0; i < std::min(numTopShapes, shapes.size()); ++i) {
+        topShapesBuilder.append(shapes[i]);
+    }
+}
+
+void QueryShapeStats::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        _numShapes.subtractAndFetch(static_cast<long long>(partition.shapes.size()));
+        partition.shapes.clear();
+        partition.byRank.clear();
+    }
+}
+
+BSONObj QueryShapeStats::_shapeToBSON(const ShapeKey& key,
+                                      const ShapeData& data,
+                                      bool includeHistograms) {
+    BSONObjBuilder builder;
+    builder.append("ns", key.ns);
+    builder.append("queryHash", unsignedIntToFixedLengthHex(key.queryHash));
+    builder.append("planSummary", data.planSummary);
+    builder.append("execCount", data.execCount);
+    builder.append("totalExecMicros", static_cast<long long>(data.totalExecMicros));
+    builder.append("maxExecMicros", static_cast<long long>(data.maxExecMicros));
+    builder.append("docsExamined", data.docsExamined);
+    builder.append("keysExamined", data.keysExamined);
+    builder.append("nreturned", data.nreturned);
+
+    if (includeHistograms) {
+        BSONArrayBuilder histogramBuilder(builder.subarrayStart("histogram"));
+        for (size_t i = 0; i < data.latencyBuckets.size(); ++i) {
+            if (data.latencyBuckets[i] == 0) {
+                continue;
+            }
+            BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+            entryBuilder.append("micros",
+                                static_cast<long long>(OperationLatencyHistogram::kLowerBounds[i]));
+            entryBuilder.append("count", static_cast<long long>(data.latencyBuckets[i]));
+            entryBuilder.doneFast();
+        }
+        histogramBuilder.doneFast();
+    }
+    return builder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,167 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Aggregates the executions of queries by namespace and query shape, as identified by the
+ * 'queryHash' of the plan cache key. Each shape keeps a latency histogram using the buckets of
+ * OperationLatencyHistogram, the totals of documents and keys examined and of documents returned,
+ * and the plan summary of its most recent execution.
+ *
+ * The table holds at most 'internalQueryShapeStatsMaxShapes' shapes, and nothing is recorded
+ * while that is 0. It is split into partitions with their own mutexes so that concurrent
+ * operations rarely contend. Once the table is full, a new shape replaces the shape of its
+ * partition with the lowest rank, and inherits that rank. The rank of a shape is its total
+ * execution time plus the rank it inherited, which bounds the time it may have had before it was
+ * admitted. This is the "space-saving" scheme for finding heavy hitters: a shape which starts to
+ * dominate execution time after the table is full outranks the one-off shapes around it.
+ */
+class QueryShapeStats {
+public:
+    static QueryShapeStats& get(ServiceContext* service);
+
+    /**
+     * The measurements of one execution of a query.
+     */
+    struct Execution {
+        uint64_t latencyMicros = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+    };
+
+    /**
+     * Records an execution of the query with shape 'queryHash' against 'nss', if the operation
+     * came from a user.
+     */
+    void record(OperationContext* opCtx,
+                const NamespaceString& nss,
+                uint32_t queryHash,
+                StringData planSummary,
+                const Execution& execution);
+
+    /**
+     * Records an execution of the query with shape 'queryHash' against 'nss', regardless of where
+     * the operation came from.
+     */
+    void recordExecution(const NamespaceString& nss,
+                         uint32_t queryHash,
+                         StringData planSummary,
+                         const Execution& execution);
+
+    /**
+     * Returns one document per recorded shape, with its latency histogram if 'includeHistograms'
+     * is true, in decreasing order of total execution time.
+     */
+    std::vector<BSONObj> getShapes(bool includeHistograms) const;
+
+    /**
+     * Appends the number of shapes tracked and evicted and, if 'numTopShapes' is not 0, the
+     * 'numTopShapes' shapes with the greatest total execution time, without their histograms.
+     */
+    void appendSummary(size_t numTopShapes, BSONObjBuilder* builder) const;
+
+    /**
+     * Forgets every recorded shape.
+     */
+    void clear();
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+
+    struct ShapeKey {
+        std::string ns;
+        uint32_t queryHash;
+
+        bool operator==(const ShapeKey& other) const {
+            return queryHash == other.queryHash && ns == other.ns;
+        }
+
+        template <typename H>
+        friend H AbslHashValue(H h, const ShapeKey& key) {
+            return H::combine(std::move(h), key.ns, key.queryHash);
+        }
+    };
+
+    // Orders the shapes of a partition by their rank, to find the one to evict in logarithmic time.
+    using RankIndex = std::multimap<uint64_t, const ShapeKey*>;
+
+    struct ShapeData {
+        // The entry of this shape in the 'byRank' index of its partition.
+        RankIndex::iterator rankPos;
+
+        std::string planSummary;
+        long long execCount = 0;
+        uint64_t totalExecMicros = 0;
+        uint64_t maxExecMicros = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets> latencyBuckets{};
+    };
+
+    struct Partition {
+        stdx::unordered_map<ShapeKey, ShapeData> shapes;
+        RankIndex byRank;
+
+        // Protects 'shapes' and 'byRank'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryShapeStats::Partition::mutex");
+    };
+
+    static BSONObj _shapeToBSON(const ShapeKey& key,
+                                const ShapeData& data,
+                                bool includeHistograms);
+
+    std::array<Partition, kNumPartitions> _partitions;
+
+    AtomicWord<long long> _numShapes{0};
+    AtomicWord<long long> _numShapesEvicted{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+class QueryShapeStatsTest : public unittest::Test {
+public:
+    void setUp() final {
+        _originalMaxShapes = internalQueryShapeStatsMaxShapes.load();
+        internalQueryShapeStatsMaxShapes.store(100);
+    }
+
+    void tearDown() final {
+        internalQueryShapeStatsMaxShapes.store(_originalMaxShapes);
+    }
+
+private:
+    long long _originalMaxShapes = 0;
+};
+
+QueryShapeStats::Execution makeExecution(uint64_t latencyMicros,
+                                         long long docsExamined = 0,
+                                         long long keysExamined = 0,
+                                         long long nreturned = 0) {
+    return {latencyMicros, docsExamined, keysExamined, nreturned};
+}
+
+TEST_F(QueryShapeStatsTest, NothingIsRecordedWhenDisabled) {
+    internalQueryShapeStatsMaxShapes.store(0);
+    QueryShapeStats stats;
+    stats.recordExecution(kNss, 1, "COLLSCAN", makeExecution(10));
+    ASSERT(stats.getShapes(true).empty());
+}
+
+TEST_F(QueryShapeStatsTest, AggregatesExecutionsOfTheSameShape) {
+    QueryShapeStats stats;
+    stats.recordExecution(kNss, 0xabcd, "COLLSCAN", makeExecution(3, 10, 0, 1));
+    stats.recordExecution(kNss, 0xabcd, "IXSCAN { a: 1 }", makeExecution(5, 2, 4, 2));
+
+    auto shapes = stats.getShapes(true);
+    ASSERT_EQ(1U, shapes.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{ns: 'test.coll', queryHash: '0000ABCD', "
+                               "planSummary: 'IXSCAN { a: 1 }', execCount: 2, "
+                               "totalExecMicros: 8, maxExecMicros: 5, docsExamined: 12, "
+                               "keysExamined: 4, nreturned: 3, "
+                               "histogram: [{micros: 2, count: 1}, {micros: 4, count: 1}]}"),
+                      shapes[0]);
+}
+
+TEST_F(QueryShapeStatsTest, SeparatesTheSameShapeOnDifferentNamespaces) {
+    QueryShapeStats stats;
+    stats.recordExecution(kNss, 1, "COLLSCAN", makeExecution(10));
+    stats.recordExecution(NamespaceString("test.other"), 1, "COLLSCAN", makeExecution(20));
+
+    auto shapes = stats.getShapes(false);
+    ASSERT_EQ(2U, shapes.size());
+    ASSERT_EQ("test.other", shapes[0]["ns"].String());
+    ASSERT_EQ("test.coll", shapes[1]["ns"].String());
+    ASSERT_FALSE(shapes[0].hasField("histogram"));
+}
+
+TEST_F(QueryShapeStatsTest, EvictsTheShapeWithTheLeastTotalExecutionTimeWhenFull) {
+    internalQueryShapeStatsMaxShapes.store(2);
+    QueryShapeStats stats;
+
+    // The three hashes fall into the same partition of the table.
+    stats.recordExecution(kNss, 1, "COLLSCAN", makeExecution(1000));
+    stats.recordExecution(kNss, 17, "COLLSCAN", makeExecution(10));
+    stats.recordExecution(kNss, 33, "COLLSCAN", makeExecution(100));
+
+    auto shapes = stats.getShapes(false);
+    ASSERT_EQ(2U, shapes.size());
+    ASSERT_EQ("00000001", shapes[0]["queryHash"].String());
+    ASSERT_EQ("00000021", shapes[1]["queryHash"].String());
+
+    BSONObjBuilder summary;
+    stats.appendSummary(1, &summary);
+    auto summaryObj = summary.obj();
+    ASSERT_EQ(2, summaryObj["numShapes"].numberLong());
+    ASSERT_EQ(1, summaryObj["numShapesEvicted"].numberLong());
+    ASSERT_EQ(1U, summaryObj["topShapes"].Array().size());
+    ASSERT_EQ("00000001", summaryObj["topShapes"].Array()[0]["queryHash"].String());
+}
+
+TEST_F(QueryShapeStatsTest, KeepsAShapeWhichBecomesHotAfterTheTableIsFull) {
+    internalQueryShapeStatsMaxShapes.store(3);
+    QueryShapeStats stats;
+
+    // Fill the table with shapes from the same partition, then interleave a stream of one-off
+    // shapes with a hot shape whose executions are each cheaper than a one-off. The hot shape
+    // inherits the rank of the shape it evicts, so the one-off shapes evict each other instead.
+    stats.recordExecution(kNss, 1, "COLLSCAN", makeExecution(1000));
+    stats.recordExecution(kNss, 17, "COLLSCAN", makeExecution(10));
+    stats.recordExecution(kNss, 33, "COLLSCAN", makeExecution(10));
+    stats.recordExecution(kNss, 49, "IXSCAN { a: 1 }", makeExecution(5));
+    for (uint32_t oneOffHash : {65, 81, 97}) {
+        stats.recordExecution(kNss, oneOffHash, "COLLSCAN", makeExecution(10));
+        stats.recordExecution(kNss, 49, "IXSCAN { a: 1 }", makeExecution(5));
+        stats.recordExecution(kNss, 49, "IXSCAN { a: 1 }", makeExecution(5));
+    }
+
+    auto shapes = stats.getShapes(false);
+    ASSERT_EQ(3U, shapes.size());
+    ASSERT_EQ("00000001", shapes[0]["queryHash"].String());
+    ASSERT_EQ("00000031", shapes[1]["queryHash"].String());
+    ASSERT_EQ(7, shapes[1]["execCount"].numberLong());
+    ASSERT_EQ(35, shapes[1]["totalExecMicros"].numberLong());
+    ASSERT_EQ("00000061", shapes[2]["queryHash"].String());
+
+    BSONObjBuilder summary;
+    stats.appendSummary(0, &summary);
+    auto summaryObj = summary.obj();
+    ASSERT_EQ(4, summaryObj["numShapesEvicted"].numberLong());
+    ASSERT_FALSE(summaryObj.hasField("topShapes"));
+}
+
+TEST_F(QueryShapeStatsTest, ClearForgetsEveryShape) {
+    QueryShapeStats stats;
+    stats.recordExecution(kNss, 1, "COLLSCAN", makeExecution(10));
+    stats.recordExecution(kNss, 2, "COLLSCAN", makeExecution(10));
+    stats.clear();
+
+    ASSERT(stats.getShapes(false).empty());
+    BSONObjBuilder summary;
+    stats.appendSummary(10, &summary);
+    ASSERT_EQ(0, summary.obj()["numShapes"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
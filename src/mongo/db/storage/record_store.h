@@ -306,6 +306,17 @@ public:
 
     virtual void deleteRecord(OperationContext* opCtx, const RecordId& dl) = 0;
 
+    /**
+     * Deletes all the records with the given ids, which must exist. Implementations may take
+     * advantage of the whole batch being known upfront, for example by reusing a single cursor
+     * and visiting the records in key order. The default implementation deletes them one by one.
+     */
+    virtual void deleteRecords(OperationContext* opCtx, const std::vector<RecordId>& ids) {
+        for (const auto& id : ids) {
+            deleteRecord(opCtx, id);
+        }
+    }
+
     /**
      * Inserts the specified records into this RecordStore by copying the passed-in record data and
      * updates 'inOutRecords' to contain the ids of the inserted records.
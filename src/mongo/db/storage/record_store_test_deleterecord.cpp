@@ -137,5 +137,56 @@ TEST(RecordStoreTestHarness, DeleteMultipleRecords) {
     }
 }
 
+// Insert multiple records and delete some of them, out of order, with a single batched call.
+TEST(RecordStoreTestHarness, DeleteRecordsInBatch) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10;
+    RecordId locs[nToInsert];
+    for (int i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            stringstream ss;
+            ss << "record " << i;
+            string data = ss.str();
+
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            locs[i] = res.getValue();
+            uow.commit();
+        }
+    }
+
+    // Delete the odd records, starting from the last one
+    std::vector<RecordId> toDelete;
+    for (int i = nToInsert - 1; i >= 0; i--) {
+        if (i % 2 == 1) {
+            toDelete.push_back(locs[i]);
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            rs->deleteRecords(opCtx.get(), toDelete);
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(nToInsert / 2, rs->numRecords(opCtx.get()));
+
+        for (int i = 0; i < nToInsert; i++) {
+            RecordData data;
+            ASSERT_EQUALS(i % 2 == 0, rs->findRecord(opCtx.get(), locs[i], &data));
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
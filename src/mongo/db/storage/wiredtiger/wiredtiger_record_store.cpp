@@ -1064,6 +1064,51 @@ void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId
     _increaseDataSize(opCtx, -old_length);
 }
 
+void WiredTigerRecordStore::deleteRecords(OperationContext* opCtx,
+                                          const std::vector<RecordId>& ids) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
+    if (ids.empty()) {
+        return;
+    }
+
+    // SERVER-48453: Initialize the next record id counter before deleting. This ensures we won't
+    // reuse record ids, which can be problematic for the _mdb_catalog.
+    _initNextIdIfNeeded(opCtx);
+
+    // Deletes should never occur on a capped collection because truncation uses
+    // WT_SESSION::truncate().
+    invariant(!isCapped());
+
+    // Visit the records in key order, so that consecutive searches on the same cursor are likely
+    // to be satisfied from the leaf page it already has pinned.
+    std::vector<RecordId> sortedIds(ids);
+    std::sort(sortedIds.begin(), sortedIds.end());
+
+    WiredTigerCursor cursor(_uri, _tableId, true, opCtx);
+    cursor.assertInActiveTxn();
+    WT_CURSOR* c = cursor.get();
+
+    int64_t totalLength = 0;
+    for (const auto& id : sortedIds) {
+        setKey(c, id);
+        int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search(c); });
+        invariantWTOK(ret);
+
+        WT_ITEM old_value;
+        ret = c->get_value(c, &old_value);
+        invariantWTOK(ret);
+
+        totalLength += old_value.size;
+
+        ret = WT_OP_CHECK(c->remove(c));
+        invariantWTOK(ret);
+    }
+
+    _changeNumRecords(opCtx, -static_cast<int64_t>(sortedIds.size()));
+    _increaseDataSize(opCtx, -totalLength);
+}
+
 bool WiredTigerRecordStore::cappedAndNeedDelete() const {
     if (!_isCapped)
         return false;
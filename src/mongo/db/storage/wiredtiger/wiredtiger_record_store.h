@@ -145,6 +145,8 @@ public:
 
     virtual void deleteRecord(OperationContext* opCtx, const RecordId& id);
 
+    virtual void deleteRecords(OperationContext* opCtx, const std::vector<RecordId>& ids);
+
     virtual Status insertRecords(OperationContext* opCtx,
                                  std::vector<Record>* records,
                                  const std::vector<Timestamp>& timestamps);
@@ -44,11 +44,13 @@
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/dbtests/dbtests.h"
@@ -198,6 +200,48 @@ TEST_F(DocumentSourceCursorTest, IterateDispose) {
     ASSERT(source()->getNext().isEOF());
 }
 
+/** A $group over a DocumentSourceCursor reads its input column-wise when enabled. */
+TEST_F(DocumentSourceCursorTest, GroupReadsColumnarBatchesFromCursor) {
+    const bool columnarBatchesEnabled = internalDocumentSourceCursorEnableColumnarBatches.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceCursorEnableColumnarBatches.store(columnarBatchesEnabled);
+    });
+
+    client.insert(nss.ns(), BSON("a" << 1 << "b" << 1 << "c" << 10));
+    client.insert(nss.ns(), BSON("a" << 2 << "b" << 2));
+    client.insert(nss.ns(), BSON("b" << 4 << "a" << 1));
+    client.insert(nss.ns(), BSON("c" << 5));
+
+    auto groupSpec = fromjson("{$group: {_id: '$a', total: {$sum: '$b'}, items: {$push: 1}}}");
+    auto runGroup = [&] {
+        createSource();
+        auto group = DocumentSourceGroup::createFromBson(groupSpec.firstElement(), ctx());
+        group->setSource(source());
+
+        std::map<int, Document> results;
+        for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+            const auto& doc = next.getDocument();
+            results.emplace(doc["_id"].nullish() ? 0 : doc["_id"].coerceToInt(), doc);
+        }
+        return results;
+    };
+
+    internalDocumentSourceCursorEnableColumnarBatches.store(false);
+    auto rowResults = runGroup();
+    ASSERT_FALSE(source()->supportsColumnarBatches());
+
+    internalDocumentSourceCursorEnableColumnarBatches.store(true);
+    auto columnarResults = runGroup();
+
+    ASSERT_EQ(rowResults.size(), 3UL);
+    ASSERT_EQ(columnarResults.size(), rowResults.size());
+    for (auto&& [id, doc] : rowResults) {
+        ASSERT_DOCUMENT_EQ(columnarResults[id], doc);
+    }
+    ASSERT_VALUE_EQ(columnarResults[1]["total"], Value(5));
+    ASSERT_VALUE_EQ(columnarResults[0]["_id"], Value(BSONNULL));
+}
+
 /** Set a value or await an expected value. */
 class PendingValue {
 public:
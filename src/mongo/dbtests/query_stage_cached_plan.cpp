@@ -49,7 +49,9 @@
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/stage_builder_util.h"
 #include "mongo/dbtests/dbtests.h"
 
 namespace QueryStageCachedPlan {
@@ -283,6 +285,60 @@ TEST_F(QueryStageCachedPlan, QueryStageCachedPlanHitMaxWorks) {
     ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+/**
+ * Test that when replanning considers the cached plan again, the cached plan enters the new trial
+ * period with the work and results of its own trial period instead of starting over.
+ */
+TEST_F(QueryStageCachedPlan, ReplanContinuesCachedPlanWork) {
+    internalQueryReplanReusesCachedPlanWork.store(true);
+    ON_BLOCK_EXIT([] { internalQueryReplanReusesCachedPlanWork.store(false); });
+
+    AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+    Collection* collection = ctx.getCollection();
+    ASSERT(collection);
+
+    // Every document matches, and the query can be answered by either index.
+    const auto cq = canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 0}, b: 1}"));
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(&_opCtx, collection, cq.get(), &plannerParams);
+    auto solutions = uassertStatusOK(QueryPlanner::plan(*cq, plannerParams));
+    ASSERT_EQ(2U, solutions.size());
+
+    // Pretend the plan was cached after a single work, so that it is replanned before it gets to
+    // EOF but after it has produced some of its results.
+    const size_t decisionWorks = 1;
+    auto root = stage_builder::buildClassicExecutableTree(
+        &_opCtx, collection, *cq, *solutions[0], &_ws);
+    CachedPlanStage cachedPlanStage(_expCtx.get(),
+                                    collection,
+                                    &_ws,
+                                    cq.get(),
+                                    plannerParams,
+                                    decisionWorks,
+                                    std::move(root),
+                                    solutions[0].get());
+
+    NoopYieldPolicy yieldPolicy(_opCtx.getServiceContext()->getFastClockSource());
+    ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
+
+    // The cached plan competed with the works of its first trial period, the other plan from
+    // scratch.
+    auto stats = cachedPlanStage.getStats();
+    ASSERT_EQ(1U, stats->children.size());
+    const auto& multiPlanStats = stats->children[0];
+    ASSERT_EQ(STAGE_MULTI_PLAN, multiPlanStats->stageType);
+    ASSERT_EQ(2U, multiPlanStats->children.size());
+    const auto works = std::minmax(multiPlanStats->children[0]->common.works,
+                                   multiPlanStats->children[1]->common.works);
+    const auto maxWorksBeforeReplan =
+        static_cast<size_t>(internalQueryCacheEvictionRatio * decisionWorks);
+    ASSERT_GTE(works.second, maxWorksBeforeReplan);
+    ASSERT_LT(works.first, maxWorksBeforeReplan);
+
+    // Whichever plan won, every document is returned exactly once.
+    ASSERT_EQ(getNumResultsForStage(_ws, &cachedPlanStage, cq.get()), 10U);
+}
+
 /**
  * Test the way cache entries are added (either "active" or "inactive") to the plan cache.
  */
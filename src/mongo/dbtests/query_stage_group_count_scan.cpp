@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file tests db/exec/group_count_scan.cpp.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/client/dbclient_cursor.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/group_count_scan.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/json.h"
+#include "mongo/dbtests/dbtests.h"
+
+namespace QueryStageGroupCountScan {
+
+class GroupCountBase {
+public:
+    GroupCountBase() : _client(&_opCtx) {}
+
+    virtual ~GroupCountBase() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns().ns());
+        _client.dropCollection(ns().ns());
+    }
+
+    void addIndex(const BSONObj& obj) {
+        ASSERT_OK(dbtests::createIndex(&_opCtx, ns().ns(), obj));
+    }
+
+    void insert(const BSONObj& obj) {
+        _client.insert(ns().ns(), obj);
+    }
+
+    const Collection* getCollection() {
+        return CollectionCatalog::get(&_opCtx).lookupCollectionByNamespace(&_opCtx, ns());
+    }
+
+    const IndexDescriptor* getIndex(const BSONObj& obj) {
+        std::vector<const IndexDescriptor*> indexes;
+        getCollection()->getIndexCatalog()->findIndexesByKeyPattern(&_opCtx, obj, false, &indexes);
+        return indexes.empty() ? nullptr : indexes[0];
+    }
+
+    GroupCountScanParams makeParams(const BSONObj& keyPattern) {
+        auto descriptor = getIndex(keyPattern);
+        GroupCountScanParams params{
+            descriptor, descriptor->indexName(), descriptor->keyPattern(), "n"};
+        params.startKey = BSON("" << MINKEY);
+        params.endKey = BSON("" << MAXKEY);
+        return params;
+    }
+
+    /**
+     * Works 'stage' to EOF, yielding and restoring it before every call to work() if 'yield' is
+     * true, and returns the documents it produces.
+     */
+    std::vector<BSONObj> runGroupCount(GroupCountScan* stage, bool yield = false) {
+        std::vector<BSONObj> results;
+        WorkingSetID wsid;
+
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (PlanStage::IS_EOF != state) {
+            if (yield) {
+                static_cast<PlanStage*>(stage)->saveState();
+                static_cast<PlanStage*>(stage)->restoreState();
+            }
+            state = stage->work(&wsid);
+            if (PlanStage::ADVANCED == state) {
+                auto member = _ws.get(wsid);
+                results.push_back(member->doc.value().toBson().getOwned());
+                _ws.free(wsid);
+            }
+        }
+        return results;
+    }
+
+    static NamespaceString ns() {
+        return {"unittests", "QueryStageGroupCountScan"};
+    }
+
+protected:
+    const ServiceContext::UniqueOperationContext _txnPtr = cc().makeOperationContext();
+    OperationContext& _opCtx = *_txnPtr;
+
+    boost::intrusive_ptr<ExpressionContext> _expCtx =
+        make_intrusive<ExpressionContext>(&_opCtx, nullptr, ns());
+
+    WorkingSet _ws;
+
+private:
+    DBDirectClient _client;
+};
+
+//
+// Check that each value of the indexed field is returned once with the number of its keys
+//
+class QueryStageGroupCountScanWholeIndex : public GroupCountBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns().ns());
+
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("a" << i % 3));
+        }
+        insert(BSON("b" << 1));
+        addIndex(BSON("a" << 1));
+
+        GroupCountScan stage(_expCtx.get(), getCollection(), makeParams(BSON("a" << 1)), &_ws);
+        auto results = runGroupCount(&stage);
+
+        ASSERT_EQUALS(4U, results.size());
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: null, n: 1}"), results[0]);
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 0, n: 4}"), results[1]);
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, n: 3}"), results[2]);
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, n: 3}"), results[3]);
+    }
+};
+
+//
+// Check that only the keys within the bounds are counted
+//
+class QueryStageGroupCountScanBounds : public GroupCountBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns().ns());
+
+        for (int i = 0; i < 20; ++i) {
+            insert(BSON("a" << i / 4));
+        }
+        addIndex(BSON("a" << 1));
+
+        auto params = makeParams(BSON("a" << 1));
+        params.startKey = BSON("" << 1);
+        params.startKeyInclusive = false;
+        params.endKey = BSON("" << 3);
+        params.endKeyInclusive = true;
+
+        GroupCountScan stage(_expCtx.get(), getCollection(), params, &_ws);
+        auto results = runGroupCount(&stage);
+
+        ASSERT_EQUALS(2U, results.size());
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, n: 4}"), results[0]);
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 3, n: 4}"), results[1]);
+
+        auto stats = static_cast<const GroupCountScanStats*>(stage.getSpecificStats());
+        ASSERT_EQUALS(8U, stats->keysExamined);
+        ASSERT_EQUALS(2U, stats->groupsReturned);
+    }
+};
+
+//
+// Check that keys of a compound index are grouped by the first field only
+//
+class QueryStageGroupCountScanCompoundIndex : public GroupCountBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns().ns());
+
+        for (int i = 0; i < 12; ++i) {
+            insert(BSON("a" << (i % 2 == 0 ? "even" : "odd") << "b" << i));
+        }
+        addIndex(BSON("a" << 1 << "b" << -1));
+
+        auto params = makeParams(BSON("a" << 1 << "b" << -1));
+        params.startKey = BSON("" << MINKEY << "" << MAXKEY);
+        params.endKey = BSON("" << MAXKEY << "" << MINKEY);
+
+        GroupCountScan stage(_expCtx.get(), getCollection(), params, &_ws);
+        auto results = runGroupCount(&stage);
+
+        ASSERT_EQUALS(2U, results.size());
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 'even', n: 6}"), results[0]);
+        ASSERT_BSONOBJ_EQ(fromjson("{_id: 'odd', n: 6}"), results[1]);
+    }
+};
+
+//
+// Check that yielding between keys does not split or merge groups
+//
+class QueryStageGroupCountScanYield : public GroupCountBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns().ns());
+
+        for (int i = 0; i < 30; ++i) {
+            insert(BSON("a" << i % 5));
+        }
+        addIndex(BSON("a" << 1));
+
+        GroupCountScan stage(_expCtx.get(), getCollection(), makeParams(BSON("a" << 1)), &_ws);
+        auto results = runGroupCount(&stage, true /* yield */);
+
+        ASSERT_EQUALS(5U, results.size());
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_BSONOBJ_EQ(BSON("_id" << i << "n" << 6), results[i]);
+        }
+    }
+};
+
+class All : public OldStyleSuiteSpecification {
+public:
+    All() : OldStyleSuiteSpecification("query_stage_group_count_scan") {}
+
+    void setupTests() {
+        add<QueryStageGroupCountScanWholeIndex>();
+        add<QueryStageGroupCountScanBounds>();
+        add<QueryStageGroupCountScanCompoundIndex>();
+        add<QueryStageGroupCountScanYield>();
+    }
+};
+
+OldStyleSuiteInitializer<All> queryStageGroupCountScanAll;
+
+}  // namespace QueryStageGroupCountScan
@@ -730,6 +730,12 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
             _stats.numActiveFullRefreshes.subtractAndFetch(1);
         }
 
+        if (status.isOK()) {
+            auto& latencyHistogram =
+                isIncremental ? _stats.incrementalRefreshLatency : _stats.fullRefreshLatency;
+            latencyHistogram.record(Microseconds(t.micros()));
+        }
+
         if (!status.isOK()) {
             _stats.countFailedRefreshes.addAndFetch(1);
 
@@ -924,6 +930,15 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
 
+    {
+        BSONObjBuilder latencyBuilder(builder->subobjStart("incrementalRefreshLatency"));
+        incrementalRefreshLatency.report(&latencyBuilder);
+    }
+    {
+        BSONObjBuilder latencyBuilder(builder->subobjStart("fullRefreshLatency"));
+        fullRefreshLatency.report(&latencyBuilder);
+    }
+
     if (isMongos()) {
         BSONObjBuilder operationsBlockedByRefreshBuilder(
             builder->subobjStart("operationsBlockedByRefresh"));
@@ -945,6 +960,41 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     }
 }
 
+void CatalogCache::Stats::RefreshLatencyHistogram::record(Microseconds latency) {
+    const auto millis = durationCount<Milliseconds>(latency);
+
+    int bucket = 0;
+    while (bucket < kNumBuckets - 1 && (1LL << bucket) <= millis) {
+        ++bucket;
+    }
+
+    buckets[bucket].addAndFetch(1);
+    count.addAndFetch(1);
+    totalMicros.addAndFetch(durationCount<Microseconds>(latency));
+}
+
+void CatalogCache::Stats::RefreshLatencyHistogram::report(BSONObjBuilder* builder) const {
+    BSONArrayBuilder histogramBuilder(builder->subarrayStart("histogram"));
+    for (int i = 0; i < kNumBuckets; ++i) {
+        const auto bucketCount = buckets[i].load();
+        if (bucketCount == 0) {
+            continue;
+        }
+
+        // Inclusive lower bound of the bucket
+        const long long lowerBoundMicros = (i == 0) ? 0 : (1LL << (i - 1)) * 1000;
+
+        BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+        entryBuilder.append("micros", lowerBoundMicros);
+        entryBuilder.append("count", bucketCount);
+        entryBuilder.doneFast();
+    }
+    histogramBuilder.doneFast();
+
+    builder->append("latency", totalMicros.load());
+    builder->append("ops", count.load());
+}
+
 CachedDatabaseInfo::CachedDatabaseInfo(DatabaseType dbt, std::shared_ptr<Shard> primaryShard)
     : _dbt(std::move(dbt)), _primaryShard(std::move(primaryShard)) {}
 
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include "mongo/base/string_data.h"
@@ -41,6 +42,7 @@
 #include "mongo/s/database_version_gen.h"
 #include "mongo/util/concurrency/notification.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -468,6 +470,23 @@ private:
         // for whatever reason
         AtomicWord<long long> countFailedRefreshes{0};
 
+        // Distribution of the time it took to complete a refresh, including loading the changed
+        // chunks and rebuilding the routing table. Bucket 0 counts refreshes which took less than
+        // one millisecond and each subsequent bucket covers twice the latency of the previous one.
+        struct RefreshLatencyHistogram {
+            static constexpr int kNumBuckets = 16;
+
+            void record(Microseconds latency);
+            void report(BSONObjBuilder* builder) const;
+
+            std::array<AtomicWord<long long>, kNumBuckets> buckets{};
+            AtomicWord<long long> count{0};
+            AtomicWord<long long> totalMicros{0};
+        };
+
+        RefreshLatencyHistogram incrementalRefreshLatency;
+        RefreshLatencyHistogram fullRefreshLatency;
+
         // Cumulative, always-increasing counter of how many operations have been blocked by a
         // catalog cache refresh. Broken down by operation type to match the operations tracked
         // by the OpCounters class.
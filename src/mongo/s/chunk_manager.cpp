@@ -69,81 +69,83 @@ void checkAllElementsAreOfType(BSONType type, const BSONObj& o) {
 
 }  // namespace
 
-ShardVersionMap ChunkMap::constructShardVersionMap(const OID& epoch) const {
+ShardVersionMap ChunkMap::constructShardVersionMap(const OID& epoch) {
     ShardVersionMap shardVersions;
-    ChunkInfoMap::const_iterator current = _chunkMap.cbegin();
 
-    boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
+    std::shared_ptr<ChunkInfo> prevChunk;
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
+    // Check the continuity of the chunks map at the point where 'chunk' follows 'lastChunk'. This
+    // is only checked at the boundaries of the ranges owned by a single shard.
+    const auto checkContinuity = [](const ChunkInfo& lastChunk, const ChunkInfo& chunk) {
+        if (lastChunk.getShardIdAt(boost::none) == chunk.getShardIdAt(boost::none))
+            return;
 
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt = shardVersions.emplace(currentRangeShardId, epoch).first;
-        }
+        const auto& lastMax = lastChunk.getMax();
+        const auto& rangeMin = chunk.getMin();
+        if (SimpleBSONObjComparator::kInstance.evaluate(lastMax == rangeMin))
+            return;
 
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
+        if (SimpleBSONObjComparator::kInstance.evaluate(lastMax < rangeMin))
+            uasserted(ErrorCodes::ConflictingOperationInProgress,
+                      str::stream() << "Gap exists in the routing table between chunks "
+                                    << lastChunk.getRange().toString() << " and "
+                                    << chunk.getRange().toString());
+        else
+            uasserted(ErrorCodes::ConflictingOperationInProgress,
+                      str::stream() << "Overlap exists in the routing table between chunks "
+                                    << lastChunk.getRange().toString() << " and "
+                                    << chunk.getRange().toString());
+    };
+
+    for (auto& block : _blocks) {
+        invariant(!block->chunks.empty());
+
+        if (!block->isSealed) {
+            // Only blocks which are not shared with any other ChunkMap can be unsealed
+            invariant(block.use_count() == 1);
+
+            block->shardMaxVersions.clear();
+            for (size_t i = 0; i < block->chunks.size(); ++i) {
+                const auto& chunk = block->chunks[i].second;
+                if (i > 0)
+                    checkContinuity(*block->chunks[i - 1].second, *chunk);
+
+                auto& maxShardVersion = block->shardMaxVersions
+                                            .emplace(chunk->getShardIdAt(boost::none),
+                                                     ChunkVersion(0, 0, epoch))
+                                            .first->second;
+                if (chunk->getLastmod() > maxShardVersion)
+                    maxShardVersion = chunk->getLastmod();
+            }
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId,
-                          &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
-                             const auto& currentChunk = chunkMapEntry.second;
+            block->isSealed = true;
+        }
 
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+        if (prevChunk)
+            checkContinuity(*prevChunk, *block->chunks.front().second);
+        prevChunk = block->chunks.back().second;
 
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
+        for (const auto& [shardId, blockShardVersion] : block->shardMaxVersions) {
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt = shardVersions.emplace(shardId, epoch).first;
+            }
 
-                             return false;
-                         });
+            auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            if (blockShardVersion > maxShardVersion)
+                maxShardVersion = blockShardVersion;
 
-        const auto rangeLast = std::prev(current);
-
-        const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->second->getMax();
-
-        // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << _chunkMap.at(ShardKeyPattern::toKeyString(*lastMax))
-                                               ->getRange()
-                                               .toString()
-                                        << " and " << rangeLast->second->getRange().toString());
-            else
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << _chunkMap.at(ShardKeyPattern::toKeyString(*lastMax))
-                                               ->getRange()
-                                               .toString()
-                                        << " and " << rangeLast->second->getRange().toString());
+            // If a shard has chunks it must have a shard version, otherwise we have an invalid
+            // chunk somewhere, which should have been caught at chunk load time
+            invariant(maxShardVersion.isSet());
         }
-
-        if (!firstMin)
-            firstMin = rangeMin;
-
-        lastMax = rangeMax;
-
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
     }
 
-    if (!_chunkMap.empty()) {
+    if (!_blocks.empty()) {
         invariant(!shardVersions.empty());
-        invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
 
-        checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
+        checkAllElementsAreOfType(MinKey, _blocks.front()->chunks.front().second->getMin());
+        checkAllElementsAreOfType(MaxKey, _blocks.back()->chunks.back().second->getMax());
     }
 
     return shardVersions;
@@ -155,67 +157,182 @@ void ChunkMap::addChunk(const ChunkType& chunk) {
 
     // Returns the first chunk with a max key that is > min - implies that the chunk overlaps
     // min
-    const auto low = _chunkMap.upper_bound(chunkMinKeyString);
+    const auto low = _upperBound(chunkMinKeyString);
 
     // Returns the first chunk with a max key that is > max - implies that the next chunk cannot
     // not overlap max
-    const auto high = _chunkMap.upper_bound(chunkMaxKeyString);
+    const auto high = _upperBound(chunkMaxKeyString);
 
     // If we are in the middle of splitting a chunk, for the first few
     // chunks inserted, low == high, because both lookups will point to the
     // same chunk (the one being split). If we're inserting the last chunk
     // for the current chunk being split, low will point to the chunk that
     // we're splitting, and high will point to the next chunk past the one
-    // we're splitting (which could be chunkMap.end()). In this case,
-    // std::distance(low, high) == 1. Lastly, this does not apply during
+    // we're splitting (which could be the end of the map). In this case,
+    // std::next(low) == high. Lastly, this does not apply during
     // the creation of the original routing table, in which case the map is
     // empty and the first chunk that is inserted will find that low ==
-    // high, but low == chunkMap.end(), and we aren't doing a split in that
-    // case.
-    auto foundSingleChunk =
-        ((low == high || std::distance(low, high) == 1) && low != _chunkMap.end());
+    // high, but low is the end of the map, and we aren't doing a split in
+    // that case.
+    auto foundSingleChunk = (low != _end() && (low == high || ++ConstIterator(low) == high));
 
     auto newChunk = std::make_shared<ChunkInfo>(chunk);
     if (foundSingleChunk) {
-        auto chunkBeingReplacedBySplit = low->second;
+        auto chunkBeingReplacedBySplit = *low;
         auto bytesInReplacedChunk =
             chunkBeingReplacedBySplit->getWritesTracker()->getBytesWritten();
         newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
     }
 
-    // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-    _chunkMap.erase(low, high);
-
-    // Insert only the chunk itself
-    _chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+    // Erase all chunks from the map, which overlap the chunk we got from the persistent store and
+    // insert only the chunk itself
+    _replaceRange(low, high, std::make_pair(chunkMaxKeyString, std::move(newChunk)));
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
-        return it->second;
+    if (it != _end())
+        return *it;
 
     return std::shared_ptr<ChunkInfo>();
 }
 
-ChunkMap::ChunkInfoMap::const_iterator ChunkMap::_findIntersectingChunk(
-    const BSONObj& shardKey) const {
-    return _chunkMap.upper_bound(ShardKeyPattern::toKeyString(shardKey));
+ChunkMap::ConstIterator ChunkMap::_upperBound(const std::string& keyString) const {
+    // Find the first block which contains a chunk with a max key that is > keyString
+    const auto blockIt =
+        std::upper_bound(_blocks.begin(),
+                         _blocks.end(),
+                         keyString,
+                         [](const std::string& key, const std::shared_ptr<ChunkBlock>& block) {
+                             return key < block->chunks.back().first;
+                         });
+    if (blockIt == _blocks.end())
+        return _end();
+
+    const auto& chunks = (*blockIt)->chunks;
+    const auto chunkIt = std::upper_bound(
+        chunks.begin(), chunks.end(), keyString, [](const std::string& key, const auto& entry) {
+            return key < entry.first;
+        });
+
+    return ConstIterator(&_blocks, blockIt - _blocks.begin(), chunkIt - chunks.begin());
+}
+
+ChunkMap::ConstIterator ChunkMap::_lowerBound(const std::string& keyString) const {
+    // Find the first block which contains a chunk with a max key that is >= keyString
+    const auto blockIt =
+        std::lower_bound(_blocks.begin(),
+                         _blocks.end(),
+                         keyString,
+                         [](const std::shared_ptr<ChunkBlock>& block, const std::string& key) {
+                             return block->chunks.back().first < key;
+                         });
+    if (blockIt == _blocks.end())
+        return _end();
+
+    const auto& chunks = (*blockIt)->chunks;
+    const auto chunkIt = std::lower_bound(
+        chunks.begin(), chunks.end(), keyString, [](const auto& entry, const std::string& key) {
+            return entry.first < key;
+        });
+
+    return ConstIterator(&_blocks, blockIt - _blocks.begin(), chunkIt - chunks.begin());
+}
+
+ChunkMap::ConstIterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey) const {
+    return _upperBound(ShardKeyPattern::toKeyString(shardKey));
 }
 
-std::pair<ChunkMap::ChunkInfoMap::const_iterator, ChunkMap::ChunkInfoMap::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
-    const auto itMin = _chunkMap.upper_bound(ShardKeyPattern::toKeyString(min));
+std::pair<ChunkMap::ConstIterator, ChunkMap::ConstIterator> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+    const auto itMin = _upperBound(ShardKeyPattern::toKeyString(min));
     const auto itMax = [&]() {
-        auto it = isMaxInclusive ? _chunkMap.upper_bound(ShardKeyPattern::toKeyString(max))
-                                 : _chunkMap.lower_bound(ShardKeyPattern::toKeyString(max));
-        return it == _chunkMap.end() ? it : ++it;
+        auto it = isMaxInclusive ? _upperBound(ShardKeyPattern::toKeyString(max))
+                                 : _lowerBound(ShardKeyPattern::toKeyString(max));
+        return it == _end() ? it : ++it;
     }();
 
     return {itMin, itMax};
 }
 
+ChunkMap::ChunkBlock& ChunkMap::_getMutableBlock(size_t blockIdx) {
+    auto& block = _blocks[blockIdx];
+
+    // The only way to obtain another reference to a block is by copying the ChunkMap which owns
+    // it, so if this is the only reference, it cannot be observed by anybody else
+    if (block.use_count() != 1) {
+        block = std::make_shared<ChunkBlock>(*block);
+    }
+
+    block->isSealed = false;
+    return *block;
+}
+
+void ChunkMap::_replaceRange(ConstIterator low, ConstIterator high, ChunkInfoEntry entry) {
+    if (_blocks.empty()) {
+        invariant(low == _end() && high == _end());
+
+        _blocks.push_back(std::make_shared<ChunkBlock>());
+        _blocks.back()->chunks.push_back(std::move(entry));
+        _size = 1;
+        return;
+    }
+
+    // Appending after the last chunk of the map goes into the last block
+    if (low == _end()) {
+        invariant(high == _end());
+        low = high = ConstIterator(&_blocks, _blocks.size() - 1, _blocks.back()->chunks.size());
+    }
+
+    const size_t blockIdx = low._blockIdx;
+    auto& block = _getMutableBlock(blockIdx);
+    auto& chunks = block.chunks;
+
+    if (high._blockIdx == blockIdx) {
+        _size -= high._chunkIdx - low._chunkIdx;
+        chunks.erase(chunks.begin() + low._chunkIdx, chunks.begin() + high._chunkIdx);
+        chunks.insert(chunks.begin() + low._chunkIdx, std::move(entry));
+    } else {
+        // The range being replaced spans multiple blocks. Truncate the first one, drop the ones
+        // in the middle and trim the start of the last one (if the range doesn't extend to the
+        // end of the map).
+        _size -= chunks.size() - low._chunkIdx;
+        chunks.erase(chunks.begin() + low._chunkIdx, chunks.end());
+        chunks.push_back(std::move(entry));
+
+        for (size_t i = blockIdx + 1; i < high._blockIdx; ++i) {
+            _size -= _blocks[i]->chunks.size();
+        }
+
+        auto eraseBlocksEnd = high._blockIdx;
+        if (high._blockIdx < _blocks.size() && high._chunkIdx > 0) {
+            auto& lastChunks = _getMutableBlock(high._blockIdx).chunks;
+            _size -= high._chunkIdx;
+            lastChunks.erase(lastChunks.begin(), lastChunks.begin() + high._chunkIdx);
+            invariant(!lastChunks.empty());
+        }
+
+        _blocks.erase(_blocks.begin() + blockIdx + 1, _blocks.begin() + eraseBlocksEnd);
+    }
+
+    _size += 1;
+
+    // Split blocks which have grown too large, so that modifying a single chunk never requires
+    // copying more than a bounded number of entries
+    auto& blockToSplit = *_blocks[blockIdx];
+    if (blockToSplit.chunks.size() > kMaxChunksPerBlock) {
+        const auto midIt = blockToSplit.chunks.begin() + blockToSplit.chunks.size() / 2;
+
+        auto upperHalf = std::make_shared<ChunkBlock>();
+        upperHalf->chunks.assign(std::make_move_iterator(midIt),
+                                 std::make_move_iterator(blockToSplit.chunks.end()));
+        blockToSplit.chunks.erase(midIt, blockToSplit.chunks.end());
+
+        _blocks.insert(_blocks.begin() + blockIdx + 1, std::move(upperHalf));
+    }
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
     : shardVersion(0, 0, epoch) {}
 
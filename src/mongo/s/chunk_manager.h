@@ -67,23 +67,85 @@ using ShardVersionMap = std::map<ShardId, ShardVersionTargetingInfo>;
 // This class serves as a Facade around how the mapping of ranges to chunks is represented. It also
 // provides a simpler, high-level interface for domain specific operations without exposing the
 // underlying implementation.
+//
+// The chunks are kept ordered by their max key and are partitioned into fixed-capacity blocks,
+// which are shared between copies of the ChunkMap and are only cloned when a copy modifies them
+// (copy-on-write). This way, applying a refresh with a small number of changed chunks on top of a
+// large routing table costs time proportional to the number of changed chunks rather than to the
+// size of the entire routing table.
 class ChunkMap {
-    // Ordered map from the max for each chunk to an entry describing the chunk
-    using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+    // Entry describing a chunk, keyed by the KeyString of its max
+    using ChunkInfoEntry = std::pair<std::string, std::shared_ptr<ChunkInfo>>;
+
+    // A contiguous, ordered run of chunks. Blocks which are referenced by more than one ChunkMap
+    // must never be modified.
+    struct ChunkBlock {
+        std::vector<ChunkInfoEntry> chunks;
+
+        // Max version of the chunks in this block for each shard which owns any of them. Only
+        // valid if 'isSealed' is true.
+        std::map<ShardId, ChunkVersion> shardMaxVersions;
+
+        // Set to false whenever 'chunks' is modified and to true once 'shardMaxVersions' has been
+        // recomputed and the continuity of the chunks in this block has been checked.
+        bool isSealed{false};
+    };
+
+    using ChunkBlockVector = std::vector<std::shared_ptr<ChunkBlock>>;
 
 public:
+    // Maximum number of chunks in a single block. Blocks which grow beyond this size are split in
+    // two halves.
+    static constexpr size_t kMaxChunksPerBlock = 256;
+
+    /**
+     * Forward iterator over the chunks of a ChunkMap in ascending order of their max key.
+     */
+    class ConstIterator {
+    public:
+        ConstIterator(const ChunkBlockVector* blocks, size_t blockIdx, size_t chunkIdx)
+            : _blocks(blocks), _blockIdx(blockIdx), _chunkIdx(chunkIdx) {}
+
+        const std::shared_ptr<ChunkInfo>& operator*() const {
+            return (*_blocks)[_blockIdx]->chunks[_chunkIdx].second;
+        }
+
+        ConstIterator& operator++() {
+            if (++_chunkIdx == (*_blocks)[_blockIdx]->chunks.size()) {
+                ++_blockIdx;
+                _chunkIdx = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return _blockIdx == other._blockIdx && _chunkIdx == other._chunkIdx;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkMap;
+
+        const ChunkBlockVector* _blocks;
+        size_t _blockIdx;
+        size_t _chunkIdx;
+    };
+
     ChunkMap() {}
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto it = shardKey.isEmpty() ? _begin() : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(it->second))
+        for (const auto end = _end(); it != end; ++it) {
+            if (!handler(*it))
                 break;
         }
     }
@@ -96,21 +158,53 @@ public:
         const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
 
         for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(it->second))
+            if (!handler(*it))
                 break;
         }
     }
 
-    ShardVersionMap constructShardVersionMap(const OID& epoch) const;
+    /**
+     * Computes the max version of each shard, which owns chunks and validates that the chunks
+     * cover the complete key space without gaps or overlaps. Only the blocks which were modified
+     * since they were last validated are scanned chunk by chunk.
+     */
+    ShardVersionMap constructShardVersionMap(const OID& epoch);
+
     void addChunk(const ChunkType& chunk);
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
 private:
-    ChunkInfoMap::const_iterator _findIntersectingChunk(const BSONObj& shardKey) const;
-    std::pair<ChunkInfoMap::const_iterator, ChunkInfoMap::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    ConstIterator _begin() const {
+        return ConstIterator(&_blocks, 0, 0);
+    }
+
+    ConstIterator _end() const {
+        return ConstIterator(&_blocks, _blocks.size(), 0);
+    }
+
+    ConstIterator _upperBound(const std::string& keyString) const;
+    ConstIterator _lowerBound(const std::string& keyString) const;
+
+    ConstIterator _findIntersectingChunk(const BSONObj& shardKey) const;
+    std::pair<ConstIterator, ConstIterator> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    /**
+     * Returns the block at 'blockIdx' for modification, cloning it first if it is shared with
+     * another ChunkMap.
+     */
+    ChunkBlock& _getMutableBlock(size_t blockIdx);
+
+    /**
+     * Replaces the chunks in the range [low, high) with 'entry'.
+     */
+    void _replaceRange(ConstIterator low, ConstIterator high, ChunkInfoEntry entry);
+
+    ChunkBlockVector _blocks;
 
-    ChunkInfoMap _chunkMap;
+    // Total number of chunks across all blocks
+    size_t _size{0};
 };
 
 /**
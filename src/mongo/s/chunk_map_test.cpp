@@ -38,6 +38,7 @@ namespace {
 
 const NamespaceString kNss("TestDB", "TestColl");
 const ShardId kThisShard("testShard");
+const int kMaxChunksPerBlock = ChunkMap::kMaxChunksPerBlock;
 
 class ChunkMapTest : public unittest::Test {
 public:
@@ -147,4 +148,96 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestSplitsAndMergesAcrossBlocks) {
+    ChunkMap chunkMap{};
+
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    chunkMap.addChunk(ChunkType{
+        kNss,
+        ChunkRange{getShardKeyPattern().globalMin(), getShardKeyPattern().globalMax()},
+        version,
+        kThisShard});
+
+    // Split the single chunk into enough chunks to span several blocks
+    const int numSplitPoints = 4 * kMaxChunksPerBlock;
+    for (int i = 0; i < numSplitPoints; ++i) {
+        version.incMinor();
+        chunkMap.addChunk(ChunkType{kNss,
+                                    ChunkRange{BSON("a" << i), getShardKeyPattern().globalMax()},
+                                    version,
+                                    kThisShard});
+        chunkMap.addChunk(ChunkType{
+            kNss,
+            ChunkRange{(i == 0) ? getShardKeyPattern().globalMin() : BSON("a" << i - 1),
+                       BSON("a" << i)},
+            version,
+            kThisShard});
+    }
+
+    ASSERT_EQ(chunkMap.size(), numSplitPoints + 1);
+
+    // Copies of the map share its blocks, so modifying the copy must not affect the original
+    auto mergedChunkMap = chunkMap;
+
+    // Merge a range of chunks which spans more than one block
+    version.incMajor();
+    mergedChunkMap.addChunk(
+        ChunkType{kNss,
+                  ChunkRange{BSON("a" << 10), BSON("a" << 10 + 2 * kMaxChunksPerBlock)},
+                  version,
+                  kThisShard});
+
+    ASSERT_EQ(chunkMap.size(), numSplitPoints + 1);
+    ASSERT_EQ(mergedChunkMap.size(), numSplitPoints + 1 - 2 * kMaxChunksPerBlock + 1);
+
+    auto intersectingChunk = chunkMap.findIntersectingChunk(BSON("a" << 100));
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMin() ==
+                                                       BSON("a" << 100)));
+
+    intersectingChunk = mergedChunkMap.findIntersectingChunk(BSON("a" << 100));
+    ASSERT(SimpleBSONObjComparator::kInstance.evaluate(intersectingChunk->getMin() ==
+                                                       BSON("a" << 10)));
+
+    for (auto* map : {&chunkMap, &mergedChunkMap}) {
+        size_t count = 0;
+        auto lastMax = getShardKeyPattern().globalMin();
+        map->forEach([&](const auto& chunkInfo) {
+            ASSERT(SimpleBSONObjComparator::kInstance.evaluate(chunkInfo->getMin() == lastMax));
+            lastMax = chunkInfo->getMax();
+            count++;
+
+            return true;
+        });
+
+        ASSERT_EQ(count, map->size());
+        ASSERT(SimpleBSONObjComparator::kInstance.evaluate(lastMax ==
+                                                           getShardKeyPattern().globalMax()));
+    }
+
+    auto shardVersions = mergedChunkMap.constructShardVersionMap(epoch);
+    ASSERT_EQ(shardVersions.size(), 1);
+    ASSERT_EQ(shardVersions.at(kThisShard).shardVersion, version);
+}
+
+TEST_F(ChunkMapTest, TestGapAcrossShardsIsDetected) {
+    ChunkMap chunkMap{};
+
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    chunkMap.addChunk(ChunkType{
+        kNss, ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)}, version, kThisShard});
+
+    chunkMap.addChunk(ChunkType{kNss,
+                                ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+                                version,
+                                ShardId("otherShard")});
+
+    ASSERT_THROWS_CODE(chunkMap.constructShardVersionMap(epoch),
+                       DBException,
+                       ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace mongo
\ No newline at end of file
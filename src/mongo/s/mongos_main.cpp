@@ -64,6 +64,7 @@
 #include "mongo/db/logical_time_metadata_hook.h"
 #include "mongo/db/logical_time_validator.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/document_source_facet.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mongos.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
@@ -341,6 +342,8 @@ void cleanupTask(const ShutdownTaskArgs& shutdownArgs) {
             pool->shutdownAndJoin();
         }
 
+        DocumentSourceFacet::shutdownExecutor();
+
         if (auto catalog = Grid::get(opCtx)->catalogClient()) {
             catalog->shutDown(opCtx);
         }
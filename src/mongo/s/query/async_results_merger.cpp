@@ -39,6 +39,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/catalog/type_shard.h"
@@ -93,6 +94,27 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, rules);
 }
 
+/**
+ * Returns the KeyString encoding of 'sortKey' under 'ordering', whose byte-wise comparison orders
+ * sort keys in the same way as compareSortKeys. Returns an empty KeyString if the sort key has more
+ * components than 'ordering' can describe, or if it has a component of type Object or Array. The
+ * KeyString encoding of those includes the embedded field names, which compareSortKeys ignores.
+ */
+KeyString::Value encodeSortKey(const BSONObj& sortKey, Ordering ordering) {
+    if (static_cast<size_t>(sortKey.nFields()) > Ordering::kMaxCompoundIndexKeys) {
+        return {};
+    }
+
+    KeyString::Builder builder(KeyString::Version::kLatestVersion, ordering);
+    for (auto&& elem : sortKey) {
+        if (elem.type() == BSONType::Object || elem.type() == BSONType::Array) {
+            return {};
+        }
+        builder.appendBSONElement(elem);
+    }
+    return builder.getValueCopy();
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -105,13 +127,18 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeTree(
+          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey()),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
     }
 
+    if (_params.getSort() &&
+        static_cast<size_t>(_params.getSort()->nFields()) <= Ordering::kMaxCompoundIndexKeys) {
+        _sortKeyOrdering = Ordering::make(*_params.getSort());
+    }
+
     size_t remoteIndex = 0;
     for (const auto& remote : _params.getRemotes()) {
         _remotes.emplace_back(remote.getHostAndPort(),
@@ -307,11 +334,11 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
 }
 
 bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.empty()) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
+    auto smallestRemote = _mergeTree.top();
     auto smallestResult = _remotes[smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
@@ -359,24 +386,21 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    if (_mergeTree.empty()) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    size_t smallestRemote = _mergeTree.top();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].sortKeyBuffer.pop();
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
-    }
+    // Replay the matches of 'smallestRemote' with its next result, if it has a next result.
+    _mergeTree.update(smallestRemote);
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
@@ -708,6 +732,11 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<KeyString::Value> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
+        if (_params.getSort()) {
+            _mergeTree.update(remoteIndex);
+        }
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -780,6 +809,14 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                          << "' was not of type Object in document: " << obj);
                 return false;
             }
+
+            // Encode the sort key once on arrival, rather than on every comparison while merging.
+            if (_sortKeyOrdering) {
+                auto sortKey = extractSortKey(obj, _params.getCompareWholeSortKey());
+                remote.sortKeyBuffer.push(encodeSortKey(sortKey, *_sortKeyOrdering));
+            } else {
+                remote.sortKeyBuffer.push(KeyString::Value());
+            }
         }
 
         ClusterQueryResult result(obj);
@@ -788,9 +825,9 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
     }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
+    // tree.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeTree.update(remoteIndex);
     }
     return true;
 }
@@ -903,16 +940,61 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 }
 
 //
-// AsyncResultsMerger::MergingComparator
+// AsyncResultsMerger::MergeTree
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+void AsyncResultsMerger::MergeTree::update(size_t remoteIndex) {
+    if (remoteIndex >= _numLeaves) {
+        _rebuild();
+        return;
+    }
+
+    size_t node = _numLeaves + remoteIndex;
+    _nodes[node] = _remotes[remoteIndex].hasNext() ? remoteIndex : kNoRemote;
+    for (node /= 2; node >= 1; node /= 2) {
+        _nodes[node] = _playMatch(_nodes[2 * node], _nodes[2 * node + 1]);
+    }
+}
 
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+size_t AsyncResultsMerger::MergeTree::_playMatch(size_t lhs, size_t rhs) const {
+    if (lhs == kNoRemote) {
+        return rhs;
+    }
+    if (rhs == kNoRemote) {
+        return lhs;
+    }
+
+    const auto& leftKey = _remotes[lhs].sortKeyBuffer.front();
+    const auto& rightKey = _remotes[rhs].sortKeyBuffer.front();
+
+    int sortKeyComp;
+    if (leftKey.getSize() && rightKey.getSize()) {
+        sortKeyComp = leftKey.compare(rightKey);
+    } else {
+        sortKeyComp = compareSortKeys(
+            extractSortKey(*_remotes[lhs].docBuffer.front().getResult(), _compareWholeSortKey),
+            extractSortKey(*_remotes[rhs].docBuffer.front().getResult(), _compareWholeSortKey),
+            _sort);
+    }
+
+    return sortKeyComp <= 0 ? lhs : rhs;
+}
+
+void AsyncResultsMerger::MergeTree::_rebuild() {
+    _numLeaves = 1;
+    while (_numLeaves < _remotes.size()) {
+        _numLeaves *= 2;
+    }
+
+    _nodes.assign(2 * _numLeaves, kNoRemote);
+    for (size_t remoteIndex = 0; remoteIndex < _remotes.size(); ++remoteIndex) {
+        if (_remotes[remoteIndex].hasNext()) {
+            _nodes[_numLeaves + remoteIndex] = remoteIndex;
+        }
+    }
+    for (size_t node = _numLeaves - 1; node >= 1; --node) {
+        _nodes[node] = _playMatch(_nodes[2 * node], _nodes[2 * node + 1]);
+    }
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
@@ -30,12 +30,14 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <limits>
 #include <queue>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -89,7 +91,7 @@ public:
      *
      * Additionally copies each remote's first batch of results, if one exists, into that remote's
      * docBuffer. If a sort is specified in the ClusterClientCursorParams, places the remotes with
-     * buffered results onto _mergeQueue.
+     * buffered results onto _mergeTree.
      *
      * The TaskExecutor* must remain valid for the lifetime of the ARM.
      *
@@ -308,6 +310,12 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // Used only if there is a sort. Holds the KeyString encoding of the sort key of each result
+        // in 'docBuffer', in the same order, so that merging only needs to compare the encoded
+        // keys. An empty KeyString indicates that the sort key could not be encoded, in which case
+        // the sort keys are compared as BSON.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -320,16 +328,59 @@ private:
         long long fetchedCount = 0;
     };
 
-    class MergingComparator {
+    /**
+     * A tournament tree over the remotes, which is used to find the remote whose next buffered
+     * result sorts first. Each leaf corresponds to a remote and each internal node holds the winner
+     * of the match between its two children, so the overall winner is at the root. Remotes with no
+     * buffered results do not take part in the matches.
+     *
+     * Batches may arrive for any remote, not only for the winner, so unlike a loser tree any leaf
+     * can be updated. Either way only the matches along the path from the leaf to the root are
+     * replayed, each of which compares the pre-computed KeyString sort keys of the two remotes.
+     */
+    class MergeTree {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
+        MergeTree(const std::vector<RemoteCursorData>& remotes,
+                  const BSONObj& sort,
+                  bool compareWholeSortKey)
             : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        /**
+         * Returns true if none of the remotes has a buffered result.
+         */
+        bool empty() const {
+            return _nodes.empty() || _nodes[1] == kNoRemote;
+        }
+
+        /**
+         * Returns the index of the remote whose next buffered result sorts first. Must not be
+         * called if empty() is true.
+         */
+        size_t top() const {
+            invariant(!empty());
+            return _nodes[1];
+        }
+
+        /**
+         * Must be called whenever the front of the buffer of the remote at 'remoteIndex' changes,
+         * including when the remote is new.
+         */
+        void update(size_t remoteIndex);
 
     private:
+        static constexpr size_t kNoRemote = std::numeric_limits<size_t>::max();
+
+        /**
+         * Returns the winner of the match between the remotes 'lhs' and 'rhs', either of which may
+         * be kNoRemote. Ties are won by 'lhs'.
+         */
+        size_t _playMatch(size_t lhs, size_t rhs) const;
+
+        /**
+         * Resizes the tree so that it has a leaf for each remote and replays all the matches.
+         */
+        void _rebuild();
+
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
@@ -338,6 +389,13 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // The number of leaves of the tree, which is always a power of two.
+        size_t _numLeaves = 0;
+
+        // Implicit binary tree rooted at index 1, where the children of node 'i' are at '2 * i' and
+        // '2 * i + 1' and the leaf of remote 'r' is at '_numLeaves + r'.
+        std::vector<size_t> _nodes;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -486,9 +544,14 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // The top of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. Used only if there is a sort.
+    MergeTree _mergeTree;
+
+    // The ordering used to encode the buffered sort keys as KeyStrings. Is boost::none if the sort
+    // pattern has more fields than an Ordering supports, in which case sort keys are compared as
+    // BSON.
+    boost::optional<Ordering> _sortKeyOrdering;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/s/query/async_results_merger.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kTestNss("test.foo");
+
+/**
+ * Builds the parameters of a sorted merge over 'nRemotes' exhausted remote cursors, each of which
+ * has buffered 'nDocsPerRemote' documents. The documents of the different remotes interleave in the
+ * sort order, so that every result returned by the merger comes from a different remote than the
+ * previous one.
+ */
+AsyncResultsMergerParams makeParams(int nRemotes, int nDocsPerRemote, bool compoundSortKey) {
+    std::vector<RemoteCursor> remotes;
+    for (int r = 0; r < nRemotes; ++r) {
+        std::vector<BSONObj> batch;
+        batch.reserve(nDocsPerRemote);
+        for (int i = 0; i < nDocsPerRemote; ++i) {
+            const int value = i * nRemotes + r;
+            auto sortKey = compoundSortKey
+                ? BSON_ARRAY(std::string(str::stream() << "customer" << value % 100) << value)
+                : BSON_ARRAY(value);
+            batch.push_back(BSON("_id" << value << AsyncResultsMerger::kSortKeyField << sortKey));
+        }
+
+        RemoteCursor remoteCursor;
+        remoteCursor.setShardId(ShardId(str::stream() << "shard" << r));
+        remoteCursor.setHostAndPort(HostAndPort("localhost", 20000 + r));
+        remoteCursor.setCursorResponse(CursorResponse(kTestNss, 0, std::move(batch)));
+        remotes.push_back(std::move(remoteCursor));
+    }
+
+    AsyncResultsMergerParams params;
+    params.setNss(kTestNss);
+    params.setRemotes(std::move(remotes));
+    params.setSort(compoundSortKey ? BSON("name" << 1 << "value" << -1) : BSON("value" << 1));
+    return params;
+}
+
+void BM_SortedMerge(benchmark::State& state, bool compoundSortKey) {
+    const int nRemotes = state.range(0);
+    const int nDocsPerRemote = state.range(1);
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto params = makeParams(nRemotes, nDocsPerRemote, compoundSortKey);
+        state.ResumeTiming();
+
+        // The remotes are exhausted, so the merger never needs to schedule any getMores.
+        AsyncResultsMerger arm(nullptr, nullptr, std::move(params));
+        while (true) {
+            invariant(arm.ready());
+            auto next = uassertStatusOK(arm.nextReady());
+            if (next.isEOF()) {
+                break;
+            }
+            benchmark::DoNotOptimize(next);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * nRemotes * nDocsPerRemote);
+}
+
+void BM_SortedMergeSingleField(benchmark::State& state) {
+    BM_SortedMerge(state, false);
+}
+
+void BM_SortedMergeCompound(benchmark::State& state) {
+    BM_SortedMerge(state, true);
+}
+
+BENCHMARK(BM_SortedMergeSingleField)->Args({2, 10000})->Args({10, 1000})->Args({100, 100});
+BENCHMARK(BM_SortedMergeCompound)->Args({2, 10000})->Args({10, 1000})->Args({100, 100});
+
+}  // namespace
+}  // namespace mongo
@@ -441,6 +441,53 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortKeysOfMixedTypes) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1}}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 7, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // Numbers of different types compare by value, and sort keys with an embedded object are
+    // compared without considering the embedded field names.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [1]}"),
+                                   fromjson("{$sortKey: [{$numberLong: '3'}]}"),
+                                   fromjson("{$sortKey: [{x: 1}]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [2.5]}"), fromjson("{$sortKey: ['a']}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: [{$numberDecimal: '1.5'}]}"),
+                                   fromjson("{$sortKey: [{y: 2}]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch3);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    // ARM returns all results in sorted order.
+    std::vector<BSONObj> expected = {fromjson("{$sortKey: [1]}"),
+                                     fromjson("{$sortKey: [{$numberDecimal: '1.5'}]}"),
+                                     fromjson("{$sortKey: [2.5]}"),
+                                     fromjson("{$sortKey: [{$numberLong: '3'}]}"),
+                                     fromjson("{$sortKey: ['a']}"),
+                                     fromjson("{$sortKey: [{x: 1}]}"),
+                                     fromjson("{$sortKey: [{y: 2}]}")};
+    for (const auto& expectedResult : expected) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(expectedResult, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
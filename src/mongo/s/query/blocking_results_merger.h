@@ -64,6 +64,14 @@ public:
         _arm.detachFromOperationContext();
     }
 
+    /**
+     * Asks every remote which has nothing buffered for its next batch, without waiting for the
+     * responses, so that the round trips overlap with whatever the caller does next.
+     */
+    Status scheduleGetMores() {
+        return _arm.scheduleGetMores();
+    }
+
     bool remotesExhausted() const {
         return _arm.remotesExhausted();
     }
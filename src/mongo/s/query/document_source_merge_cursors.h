@@ -111,6 +111,18 @@ public:
 
     bool remotesExhausted() const;
 
+    /**
+     * Requests the next batch from every remote which has nothing buffered, without waiting for the
+     * responses. Calling this method causes the underlying BlockingResultsMerger to be populated
+     * and assumes ownership of the remote cursors.
+     */
+    void prefetchRemoteResults() final {
+        if (!_blockingResultsMerger) {
+            populateMerger();
+        }
+        uassertStatusOK(_blockingResultsMerger->scheduleGetMores());
+    }
+
     void setExecContext(RouterExecStage::ExecContext execContext) {
         _execContext = execContext;
     }
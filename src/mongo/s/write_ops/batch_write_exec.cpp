@@ -114,6 +114,10 @@ bool hasTransientTransactionError(const BatchedCommandResponse& response) {
 // applies when no writes are occurring and metadata is not changing on reload.
 const int kMaxRoundsWithoutProgress(5);
 
+// The maximum number of full child batches of an unordered write, which are sent to a shard while
+// the rest of the writes are still being targeted.
+const int kMaxFullBatchesInFlightPerShard(4);
+
 }  // namespace
 
 void BatchWriteExec::executeBatch(OperationContext* opCtx,
@@ -140,92 +144,17 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
     bool abortBatch = false;
 
     while (!batchOp.isFinished() && !abortBatch) {
-        //
-        // Get child batches to send using the targeter
-        //
-        // Targeting errors can be caused by remote metadata changing (the collection could have
-        // been dropped and recreated, for example with a new shard key).  If a remote metadata
-        // change occurs *before* a client sends us a batch, we need to make sure that we don't
-        // error out just because we're staler than the client - otherwise mongos will be have
-        // unpredictable behavior.
-        //
-        // (If a metadata change happens *during* or *after* a client sends us a batch, however,
-        // we make no guarantees about delivery.)
-        //
-        // For this reason, we don't record targeting errors until we've refreshed our targeting
-        // metadata at least once *after* receiving the client batch - at that point, we know:
-        //
-        // 1) our new metadata is the same as the metadata when the client sent a batch, and so
-        //    targeting errors are real.
-        // OR
-        // 2) our new metadata is a newer version than when the client sent a batch, and so
-        //    the metadata must have changed after the client batch was sent.  We don't need to
-        //    deliver in this case, since for all the client knows we may have gotten the batch
-        //    exactly when the metadata changed.
-        //
-
-        OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
-        std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
-
-        // If we've already had a targeting error, we've refreshed the metadata once and can
-        // record target errors definitively.
-        bool recordTargetErrors = refreshedTargeter;
-        Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
-        if (!targetStatus.isOK()) {
-            // Don't do anything until a targeter refresh
-            targeter.noteCouldNotTarget();
-            refreshedTargeter = true;
-            ++stats->numTargetErrors;
-            dassert(childBatches.size() == 0u);
-
-            if (TransactionRouter::get(opCtx)) {
-                batchOp.forgetTargetedBatchesOnTransactionAbortingError();
-
-                // Throw when there is a transient transaction error since this should be a top
-                // level error and not just a write error.
-                if (isTransientTransactionError(targetStatus.code(), false, false)) {
-                    uassertStatusOK(targetStatus);
-                }
-
-                break;
-            }
-        }
-
-        //
-        // Send all child batches
-        //
-
-        const size_t numToSend = childBatches.size();
-        size_t numSent = 0;
-
-        while (numSent != numToSend) {
-            // Collect batches out on the network, mapped by endpoint
-            OwnedShardBatchMap ownedPendingBatches;
-            OwnedShardBatchMap::MapType& pendingBatches = ownedPendingBatches.mutableMap();
-
-            //
-            // Construct the requests.
-            //
+        const bool isRetryableWrite = opCtx->getTxnNumber() && !TransactionRouter::get(opCtx);
 
+        // Serializes the request for a child batch and sends it to the batch's shard
+        auto sendBatches = [&](const std::vector<TargetedWriteBatch*>& batches) {
             std::vector<AsyncRequestsSender::Request> requests;
-
-            // Get as many batches as we can at once
-            for (auto& childBatch : childBatches) {
-                TargetedWriteBatch* const nextBatch = childBatch.second;
-
-                // If the batch is nullptr, we sent it previously, so skip
-                if (!nextBatch)
-                    continue;
-
-                // If we already have a batch for this shard, wait until the next time
-                const auto& targetShardId = nextBatch->getEndpoint().shardName;
-                if (pendingBatches.count(targetShardId))
-                    continue;
-
+            for (const auto batch : batches) {
+                const auto& targetShardId = batch->getEndpoint().shardName;
                 stats->noteTargetedShard(targetShardId);
 
                 const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
+                    const auto shardBatchRequest(batchOp.buildBatchRequest(*batch));
 
                     BSONObjBuilder requestBuilder;
                     shardBatchRequest.serialize(&requestBuilder);
@@ -242,31 +171,21 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                             "request"_attr = redact(request));
 
                 requests.emplace_back(targetShardId, request);
-
-                // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
-                // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
-                // so this should be pretty efficient without moving stuff around.
-                childBatch.second = nullptr;
-
-                // Recv-side is responsible for cleaning up the nextBatch when used
-                pendingBatches.emplace(targetShardId, nextBatch);
             }
 
-            bool isRetryableWrite = opCtx->getTxnNumber() && !TransactionRouter::get(opCtx);
-
-            MultiStatementTransactionRequestsSender ars(
+            return std::make_unique<MultiStatementTransactionRequestsSender>(
                 opCtx,
                 Grid::get(opCtx)->getExecutorPool()->getArbitraryExecutor(),
                 clientRequest.getNS().db().toString(),
                 requests,
                 kPrimaryOnlyReadPreference,
                 isRetryableWrite ? Shard::RetryPolicy::kIdempotent : Shard::RetryPolicy::kNoRetry);
-            numSent += pendingBatches.size();
-
-            //
-            // Receive the responses.
-            //
+        };
 
+        // Receives and notes the responses to the child batches in 'pendingBatches', which were
+        // sent through 'ars'.
+        auto receiveResponses = [&](MultiStatementTransactionRequestsSender& ars,
+                                    OwnedShardBatchMap::MapType& pendingBatches) {
             while (!ars.done()) {
                 // Block until a response is available.
                 auto response = ars.next();
@@ -292,11 +211,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                                 "shardId"_attr = batch->getEndpoint().shardName,
                                 "error"_attr = redact(response.swResponse.getStatus()));
 
-                    // We're done with this batch. Clean up when we can't resolve a host.
-                    auto it = childBatches.find(batch->getEndpoint().shardName);
-                    invariant(it != childBatches.end());
-                    delete it->second;
-                    it->second = nullptr;
+                    // We're done with this batch, which is cleaned up along with 'pendingBatches'
                     continue;
                 }
 
@@ -348,7 +263,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                             }
 
                             abortBatch = true;
-                            break;
+                            return;
                         }
                     }
 
@@ -404,10 +319,145 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                             uassertStatusOK(status);
                         }
 
-                        break;
+                        return;
                     }
                 }
             }
+        };
+
+        //
+        // Get child batches to send using the targeter
+        //
+        // Targeting errors can be caused by remote metadata changing (the collection could have
+        // been dropped and recreated, for example with a new shard key).  If a remote metadata
+        // change occurs *before* a client sends us a batch, we need to make sure that we don't
+        // error out just because we're staler than the client - otherwise mongos will be have
+        // unpredictable behavior.
+        //
+        // (If a metadata change happens *during* or *after* a client sends us a batch, however,
+        // we make no guarantees about delivery.)
+        //
+        // For this reason, we don't record targeting errors until we've refreshed our targeting
+        // metadata at least once *after* receiving the client batch - at that point, we know:
+        //
+        // 1) our new metadata is the same as the metadata when the client sent a batch, and so
+        //    targeting errors are real.
+        // OR
+        // 2) our new metadata is a newer version than when the client sent a batch, and so
+        //    the metadata must have changed after the client batch was sent.  We don't need to
+        //    deliver in this case, since for all the client knows we may have gotten the batch
+        //    exactly when the metadata changed.
+        //
+
+        OwnedPointerMap<ShardId, TargetedWriteBatch> childBatchesOwned;
+        std::map<ShardId, TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableMap();
+
+        // Outside of transactions, unordered child batches are sent as soon as they fill up, so
+        // that the shards start applying them while the rest of the writes are being targeted. The
+        // number of such batches in flight for a shard is bounded, past which the remaining writes
+        // are left for the next round.
+        std::vector<std::pair<std::unique_ptr<MultiStatementTransactionRequestsSender>,
+                              std::unique_ptr<OwnedShardBatchMap>>>
+            dispatchedFullBatches;
+        std::map<ShardId, int> numDispatchedFullBatches;
+
+        BatchWriteOp::FullBatchFn onFullBatch;
+        if (!TransactionRouter::get(opCtx)) {
+            onFullBatch = [&](TargetedWriteBatch* batch) {
+                const auto& targetShardId = batch->getEndpoint().shardName;
+                if (numDispatchedFullBatches[targetShardId] >= kMaxFullBatchesInFlightPerShard) {
+                    return false;
+                }
+                ++numDispatchedFullBatches[targetShardId];
+
+                auto pendingBatches = std::make_unique<OwnedShardBatchMap>();
+                pendingBatches->mutableMap().emplace(targetShardId, batch);
+                dispatchedFullBatches.emplace_back(sendBatches({batch}), std::move(pendingBatches));
+                return true;
+            };
+        }
+
+        // If we've already had a targeting error, we've refreshed the metadata once and can
+        // record target errors definitively.
+        bool recordTargetErrors = refreshedTargeter;
+        Status targetStatus =
+            batchOp.targetBatch(targeter, recordTargetErrors, &childBatches, onFullBatch);
+        if (!targetStatus.isOK()) {
+            // Don't do anything until a targeter refresh
+            targeter.noteCouldNotTarget();
+            refreshedTargeter = true;
+            ++stats->numTargetErrors;
+            dassert(childBatches.size() == 0u);
+
+            if (TransactionRouter::get(opCtx)) {
+                batchOp.forgetTargetedBatchesOnTransactionAbortingError();
+
+                // Throw when there is a transient transaction error since this should be a top
+                // level error and not just a write error.
+                if (isTransientTransactionError(targetStatus.code(), false, false)) {
+                    uassertStatusOK(targetStatus);
+                }
+
+                break;
+            }
+        }
+
+        //
+        // Send all child batches
+        //
+
+        const size_t numToSend = childBatches.size();
+        size_t numSent = 0;
+
+        while (numSent != numToSend) {
+            // Collect batches out on the network, mapped by endpoint
+            OwnedShardBatchMap ownedPendingBatches;
+            OwnedShardBatchMap::MapType& pendingBatches = ownedPendingBatches.mutableMap();
+
+            //
+            // Construct and send the requests.
+            //
+
+            std::vector<TargetedWriteBatch*> batchesToSend;
+
+            // Get as many batches as we can at once
+            for (auto& childBatch : childBatches) {
+                TargetedWriteBatch* const nextBatch = childBatch.second;
+
+                // If the batch is nullptr, we sent it previously, so skip
+                if (!nextBatch)
+                    continue;
+
+                // If we already have a batch for this shard, wait until the next time
+                const auto& targetShardId = nextBatch->getEndpoint().shardName;
+                if (pendingBatches.count(targetShardId))
+                    continue;
+
+                batchesToSend.push_back(nextBatch);
+
+                // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
+                // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
+                // so this should be pretty efficient without moving stuff around.
+                childBatch.second = nullptr;
+
+                // Recv-side is responsible for cleaning up the nextBatch when used
+                pendingBatches.emplace(targetShardId, nextBatch);
+            }
+
+            auto ars = sendBatches(batchesToSend);
+            numSent += pendingBatches.size();
+
+            //
+            // Receive the responses.
+            //
+
+            receiveResponses(*ars, pendingBatches);
+        }
+
+        // The full batches dispatched while targeting were sent first, so their responses are
+        // likely to be available already
+        for (auto& fullBatch : dispatchedFullBatches) {
+            receiveResponses(*fullBatch.first, fullBatch.second->mutableMap());
         }
 
         ++rounds;
@@ -261,7 +261,8 @@ BatchWriteOp::BatchWriteOp(OperationContext* opCtx, const BatchedCommandRequest&
 
 Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
                                  bool recordTargetErrors,
-                                 std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
+                                 std::map<ShardId, TargetedWriteBatch*>* targetedBatches,
+                                 const FullBatchFn& onFullBatch) {
     //
     // Targeting of unordered batches is fairly simple - each remaining write op is targeted,
     // and each of those targeted writes are grouped into a batch for a particular shard
@@ -294,6 +295,14 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     //  [{ skey : [c,x] }],
     //  [{ skey : y }, { skey : z }]
     //
+    // Unordered batches are not broken when a targeted batch fills up if the caller can dispatch
+    // full batches as they are produced. The full batch is handed to the caller and replaced with a
+    // new batch for the same endpoint.
+    //
+    // The writes are targeted one by one on the calling thread. The sharding task executors run
+    // their work on the thread of their network interface, so targeting on them would delay the
+    // responses of every other operation using that executor.
+    //
 
     const bool ordered = _clientRequest.getWriteCommandBase().getOrdered();
 
@@ -394,8 +403,15 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         if (wouldMakeBatchesTooBig(
                 writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
             invariant(!batchMap.empty());
-            writeOp.cancelWrites(nullptr);
-            break;
+            if (ordered || !onFullBatch ||
+                !_dispatchFullBatches(writes,
+                                      std::max(writeSizeBytes, errorResponsePotentialSizeBytes),
+                                      onFullBatch,
+                                      &batchMap,
+                                      &targetedShards)) {
+                writeOp.cancelWrites(nullptr);
+                break;
+            }
         }
 
         if (!ordered && !batchMap.empty() &&
@@ -454,6 +470,44 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     return Status::OK();
 }
 
+bool BatchWriteOp::_dispatchFullBatches(const std::vector<TargetedWrite*>& writes,
+                                        int writeSizeBytes,
+                                        const FullBatchFn& onFullBatch,
+                                        TargetedBatchMap* batchMap,
+                                        std::set<ShardId>* targetedShards) {
+    for (const auto write : writes) {
+        auto it = batchMap->find(&write->endpoint);
+        if (it == batchMap->end()) {
+            continue;
+        }
+
+        TargetedWriteBatch* batch = it->second;
+        if (!wouldMakeBatchesTooBig({write}, writeSizeBytes, *batchMap)) {
+            continue;
+        }
+
+        // Remember targeted batch for reporting, before handing it over to the caller
+        _targeted.insert(batch);
+        if (!onFullBatch(batch)) {
+            _targeted.erase(batch);
+            return false;
+        }
+
+        batchMap->erase(it);
+
+        // The shard is no longer targeted by this round unless another batch for it remains, which
+        // can only happen if it is targeted both with and without a shard version.
+        const auto& shardName = write->endpoint.shardName;
+        if (std::none_of(batchMap->begin(), batchMap->end(), [&](const auto& entry) {
+                return entry.first->shardName == shardName;
+            })) {
+            targetedShards->erase(shardName);
+        }
+    }
+
+    return true;
+}
+
 BatchedCommandRequest BatchWriteOp::buildBatchRequest(
     const TargetedWriteBatch& targetedBatch) const {
     const auto batchType = _clientRequest.getBatchType();
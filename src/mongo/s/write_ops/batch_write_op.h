@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <set>
 #include <vector>
@@ -142,10 +143,18 @@ public:
      * targeting errors, but if not we should refresh once first.)
      *
      * Returned TargetedWriteBatches are owned by the caller.
+     *
+     * For unordered batches, if 'onFullBatch' is set, a TargetedWriteBatch which cannot take the
+     * next write because of its size is passed to 'onFullBatch' as soon as it fills up, instead of
+     * stopping the targeting at that write. If 'onFullBatch' accepts the batch by returning true,
+     * it takes ownership of it and targeting continues with a new batch for the same endpoint, so
+     * that the full batch can be dispatched while the rest of the writes are still being targeted.
      */
+    using FullBatchFn = std::function<bool(TargetedWriteBatch*)>;
     Status targetBatch(const NSTargeter& targeter,
                        bool recordTargetErrors,
-                       std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
+                       std::map<ShardId, TargetedWriteBatch*>* targetedBatches,
+                       const FullBatchFn& onFullBatch = nullptr);
 
     /**
      * Fills a BatchCommandRequest from a TargetedWriteBatch for this BatchWriteOp.
@@ -214,6 +223,17 @@ private:
      */
     void _cancelBatches(const WriteErrorDetail& why, TargetedBatchMap&& batchMapToCancel);
 
+    /**
+     * Hands each of the batches in 'batchMap', which 'writes' would make too big, over to
+     * 'onFullBatch' and removes them from 'batchMap'. Returns false if 'onFullBatch' declines a
+     * batch, in which case that batch and any remaining ones stay in 'batchMap'.
+     */
+    bool _dispatchFullBatches(const std::vector<TargetedWrite*>& writes,
+                              int writeSizeBytes,
+                              const FullBatchFn& onFullBatch,
+                              TargetedBatchMap* batchMap,
+                              std::set<ShardId>* targetedShards);
+
     OperationContext* const _opCtx;
 
     // The incoming client request
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/owned_pointer_map.h"
+#include "mongo/base/owned_pointer_vector.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/sharding_router_test_fixture.h"
 #include "mongo/s/transaction_router.h"
@@ -1537,6 +1538,107 @@ TEST_F(BatchWriteOpLimitTests, OneBigOneSmall) {
     ASSERT(batchOp.isFinished());
 }
 
+// Unordered inserts beyond the max batch size, whose full batches are handed over as they fill up -
+// should go through in a single round
+TEST_F(BatchWriteOpLimitTests, UnorderedFullBatchesHandedOverWhileTargeting) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpoint(ShardId("shard"), ChunkVersion::IGNORED());
+
+    auto targeter = initTargeterFullRange(nss, endpoint);
+
+    // Only three such documents fit in a batch
+    const std::string bigString(5 * 1024 * 1024, 'x');
+    const int numDocs = 7;
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < numDocs; ++i) {
+            docs.push_back(BSON("x" << i << "data" << bigString));
+        }
+        insertOp.setDocuments(std::move(docs));
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    OwnedPointerVector<TargetedWriteBatch> fullBatchesOwned;
+    auto onFullBatch = [&](TargetedWriteBatch* batch) {
+        fullBatchesOwned.push_back(batch);
+        return true;
+    };
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted, onFullBatch));
+
+    const auto& fullBatches = fullBatchesOwned.vector();
+    ASSERT_EQUALS(fullBatches.size(), 2u);
+    ASSERT_EQUALS(fullBatches[0]->getWrites().size(), 3u);
+    ASSERT_EQUALS(fullBatches[1]->getWrites().size(), 3u);
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 1u);
+
+    BatchedCommandResponse fullBatchResponse;
+    buildResponse(3, &fullBatchResponse);
+    batchOp.noteBatchResponse(*fullBatches[0], fullBatchResponse, nullptr);
+    batchOp.noteBatchResponse(*fullBatches[1], fullBatchResponse, nullptr);
+    ASSERT(!batchOp.isFinished());
+
+    BatchedCommandResponse response;
+    buildResponse(1, &response);
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), numDocs);
+}
+
+// Unordered inserts beyond the max batch size in bytes, whose full batch is declined - should stop
+// the round at the first write which does not fit
+TEST_F(BatchWriteOpLimitTests, UnorderedFullBatchDeclined) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpoint(ShardId("shard"), ChunkVersion::IGNORED());
+
+    auto targeter = initTargeterFullRange(nss, endpoint);
+
+    // Only three such documents fit in a batch
+    const std::string bigString(5 * 1024 * 1024, 'x');
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        insertOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < 4; ++i) {
+            docs.push_back(BSON("x" << i << "data" << bigString));
+        }
+        insertOp.setDocuments(std::move(docs));
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    auto onFullBatch = [&](TargetedWriteBatch* batch) { return false; };
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted, onFullBatch));
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 3u);
+    ASSERT_EQUALS(batchOp.numWriteOpsIn(WriteOpState_Ready), 1);
+}
+
 class BatchWriteOpTransactionTest : public ShardingTestFixture {
 public:
     const TxnNumber kTxnNumber = 5;